@@ -0,0 +1,83 @@
+/**********************************************************************************************
+ *
+ * Module: Bench
+ *
+ * File Name: bench.c
+ *
+ * Description: source file for the cycle accurate micro-benchmarks of the hot functions
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "bench.h"
+#include "latency.h"
+
+static uint32 ulBenchOverhead = 0;
+static boolean bBenchCalibrated = FALSE;
+
+static void Bench_Empty(void)
+{
+}
+
+/* Shortest time stamp pair around an empty call: the counter reads and the indirect call */
+static void Bench_Calibrate(void)
+{
+    uint32 ulStart;
+    uint32 ulCycles;
+    uint8 ucRun;
+    Bench_FunctionType pfBody = Bench_Empty;
+
+    ulBenchOverhead = 0xFFFFFFFFUL;
+    for (ucRun = 0; ucRun < BENCH_CALIBRATION_RUNS; ucRun++)
+    {
+        ulStart = Latency_Timestamp();
+        pfBody();
+        ulCycles = Latency_Timestamp() - ulStart;
+        if (ulCycles < ulBenchOverhead)
+        {
+            ulBenchOverhead = ulCycles;
+        }
+    }
+    bBenchCalibrated = TRUE;
+}
+
+void Bench_Run(Bench_Result_t *pxResult, const uint8 *pcName, Bench_FunctionType pfBody, uint32 ulRuns)
+{
+    uint32 ulStart;
+    uint32 ulCycles;
+    uint32 ulRun;
+    uint64 ullTotal = 0;
+
+    if (bBenchCalibrated == FALSE)
+    {
+        Bench_Calibrate();
+    }
+
+    pxResult->pcName = pcName;
+    pxResult->ulRuns = ulRuns;
+    pxResult->ulMin = 0xFFFFFFFFUL;
+    pxResult->ulMax = 0;
+    pxResult->ulAverage = 0;
+
+    for (ulRun = 0; ulRun < ulRuns; ulRun++)
+    {
+        ulStart = Latency_Timestamp();
+        pfBody();
+        ulCycles = Latency_Timestamp() - ulStart;
+        ulCycles = (ulCycles > ulBenchOverhead) ? (ulCycles - ulBenchOverhead) : 0;
+
+        ullTotal += ulCycles;
+        if (ulCycles < pxResult->ulMin)
+        {
+            pxResult->ulMin = ulCycles;
+        }
+        if (ulCycles > pxResult->ulMax)
+        {
+            pxResult->ulMax = ulCycles;
+        }
+    }
+    if (ulRuns != 0)
+    {
+        pxResult->ulAverage = (uint32)(ullTotal / ulRuns);
+    }
+}
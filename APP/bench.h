@@ -0,0 +1,34 @@
+/**********************************************************************************************
+ *
+ * Module: Bench
+ *
+ * File Name: bench.h
+ *
+ * Description: Header file for the cycle accurate micro-benchmarks of the hot functions
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include "std_types.h"
+
+#define BENCH_CALIBRATION_RUNS 16
+
+typedef void (*Bench_FunctionType)(void);
+
+typedef struct
+{
+    const uint8 *pcName;
+    uint32 ulRuns;
+    uint32 ulMin;               /* CPU cycles per call, call overhead removed */
+    uint32 ulMax;
+    uint32 ulAverage;
+} Bench_Result_t;
+
+/* Time ulRuns calls of pfBody with the DWT cycle counter, must be called after Latency_Init.
+ * The cost of calling an empty body is measured once and subtracted from every run. */
+void Bench_Run(Bench_Result_t *pxResult, const uint8 *pcName, Bench_FunctionType pfBody, uint32 ulRuns);
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,143 @@
+/**********************************************************************************************
+ *
+ * Module: Console
+ *
+ * File Name: console.c
+ *
+ * Description: source file for the incremental UART command line parser
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "console.h"
+#include "uart0.h"
+
+static const Console_CommandType *pxCommandTable = NULL_PTR;
+static uint8 ucCommandCount = 0;
+static uint8 aucLine[CONSOLE_LINE_LENGTH + 1];
+static uint8 ucLineLength = 0;
+static boolean bLineOverflow = FALSE;
+
+static void Console_SendUsage(void)
+{
+    uint8 ucIndex;
+
+    UART0_SendString("Commands:\r\n");
+    for (ucIndex = 0; ucIndex < ucCommandCount; ucIndex++)
+    {
+        UART0_SendString("  ");
+        UART0_SendString(pxCommandTable[ucIndex].pcUsage);
+        UART0_SendString("\r\n");
+    }
+}
+
+void Console_Init(const Console_CommandType *pxCommands, uint8 ucCount)
+{
+    pxCommandTable = pxCommands;
+    ucCommandCount = ucCount;
+    ucLineLength = 0;
+    bLineOverflow = FALSE;
+}
+
+boolean Console_ProcessByte(uint8 ucByte)
+{
+    if ((ucByte == '\r') || (ucByte == '\n'))
+    {
+        /* An empty line, or the second half of a CR LF pair, runs nothing */
+        return ((ucLineLength != 0) || (bLineOverflow == TRUE)) ? TRUE : FALSE;
+    }
+    if ((ucByte == '\b') || (ucByte == 0x7F))
+    {
+        if (ucLineLength != 0)
+        {
+            ucLineLength--;
+        }
+        return FALSE;
+    }
+    if (ucLineLength < CONSOLE_LINE_LENGTH)
+    {
+        aucLine[ucLineLength++] = ucByte;
+    }
+    else
+    {
+        bLineOverflow = TRUE;
+    }
+    return FALSE;
+}
+
+void Console_Execute(void)
+{
+    uint8 *apcArgv[CONSOLE_MAX_ARGS];
+    uint8 ucArgc = 0;
+    uint8 ucIndex;
+    boolean bInWord = FALSE;
+
+    if (bLineOverflow == TRUE)
+    {
+        UART0_SendString("Line too long\r\n");
+        ucLineLength = 0;
+        bLineOverflow = FALSE;
+        return;
+    }
+
+    /* Split in place, the separators become terminators */
+    aucLine[ucLineLength] = '\0';
+    for (ucIndex = 0; ucIndex < ucLineLength; ucIndex++)
+    {
+        if (aucLine[ucIndex] == ' ')
+        {
+            aucLine[ucIndex] = '\0';
+            bInWord = FALSE;
+        }
+        else if ((bInWord == FALSE) && (ucArgc < CONSOLE_MAX_ARGS))
+        {
+            apcArgv[ucArgc++] = &aucLine[ucIndex];
+            bInWord = TRUE;
+        }
+    }
+    ucLineLength = 0;
+
+    if (ucArgc == 0)
+    {
+        return;
+    }
+    for (ucIndex = 0; ucIndex < ucCommandCount; ucIndex++)
+    {
+        if (Console_Match(apcArgv[0], pxCommandTable[ucIndex].pcName) == TRUE)
+        {
+            pxCommandTable[ucIndex].pfHandler(ucArgc, apcArgv);
+            return;
+        }
+    }
+    Console_SendUsage();
+}
+
+boolean Console_ParseNumber(const uint8 *pcText, uint32 *pulValue)
+{
+    uint32 ulValue = 0;
+
+    if (*pcText == '\0')
+    {
+        return FALSE;
+    }
+    for (; *pcText != '\0'; pcText++)
+    {
+        if ((*pcText < '0') || (*pcText > '9'))
+        {
+            return FALSE;
+        }
+        ulValue = (ulValue * 10) + (*pcText - '0');
+    }
+    *pulValue = ulValue;
+    return TRUE;
+}
+
+boolean Console_Match(const uint8 *pcText, const uint8 *pcWord)
+{
+    while ((*pcText != '\0') && (*pcText == *pcWord))
+    {
+        pcText++;
+        pcWord++;
+    }
+    return (*pcText == *pcWord) ? TRUE : FALSE;
+}
@@ -0,0 +1,46 @@
+/**********************************************************************************************
+ *
+ * Module: Console
+ *
+ * File Name: console.h
+ *
+ * Description: Header file for the incremental UART command line parser
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef CONSOLE_H_
+#define CONSOLE_H_
+
+#include "std_types.h"
+
+#define CONSOLE_LINE_LENGTH 40
+#define CONSOLE_MAX_ARGS 4      /* Including the command name */
+
+/* apcArgv[0] is the command name, the handler runs with the UART mutex held */
+typedef void (*Console_HandlerType)(uint8 ucArgc, uint8 *apcArgv[]);
+
+typedef struct
+{
+    const uint8 *pcName;
+    const uint8 *pcUsage;
+    Console_HandlerType pfHandler;
+} Console_CommandType;
+
+/* The command table must outlive the console */
+void Console_Init(const Console_CommandType *pxCommands, uint8 ucCount);
+
+/* Feed one received byte, constant work per byte.
+ * TRUE when a complete line waits for Console_Execute. */
+boolean Console_ProcessByte(uint8 ucByte);
+
+/* Split the waiting line into words and run its command, the UART mutex must be held */
+void Console_Execute(void);
+
+/* Parse a decimal argument, FALSE if it isn't a number */
+boolean Console_ParseNumber(const uint8 *pcText, uint32 *pulValue);
+
+/* TRUE if both strings are equal */
+boolean Console_Match(const uint8 *pcText, const uint8 *pcWord);
+
+#endif /* CONSOLE_H_ */
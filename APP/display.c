@@ -0,0 +1,404 @@
+/**********************************************************************************************
+ *
+ * Module: Display
+ *
+ * File Name: display.c
+ *
+ * Description: source file for the change-only seat display engine. Only the fields that
+ *              changed since the last transmission are sent, plus a periodic full table.
+ *              In dashboard mode the changed cells are rewritten in place with VT100
+ *              cursor addressing.
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "display.h"
+#include "uart0.h"
+
+#define DISPLAY_HEADER "\r\nSeat:\tCurrent Temp:\tHeating level:\tHeating Intensity:\r\n"
+#define DISPLAY_SEPARATOR "--------------------------------------------------\r\n"
+
+/* VT100 sequences */
+#define DISPLAY_ESC "\x1b"
+#define DISPLAY_CLEAR_SCREEN DISPLAY_ESC "[2J"
+#define DISPLAY_SAVE_CURSOR DISPLAY_ESC "7"
+#define DISPLAY_RESTORE_CURSOR DISPLAY_ESC "8"
+#define DISPLAY_RESET_SCROLL DISPLAY_ESC "[r"
+
+/* Dashboard columns and cell widths */
+#define DISPLAY_TEMP_COLUMN 13
+#define DISPLAY_TEMP_WIDTH 6
+#define DISPLAY_LEVEL_COLUMN 20
+#define DISPLAY_LEVEL_WIDTH 6
+#define DISPLAY_INTENSITY_COLUMN 27
+#define DISPLAY_INTENSITY_WIDTH 9
+#define DISPLAY_CPU_COLUMN 12
+#define DISPLAY_FAULTS_COLUMN 25
+#define DISPLAY_MISSES_COLUMN 50
+#define DISPLAY_COUNTER_WIDTH 6
+
+typedef struct
+{
+    const uint8 *pcName;
+    uint16 usTemp;
+    uint8 ucLevel;
+    const uint8 *pcIntensity;
+} Display_SeatState_t;
+
+typedef struct
+{
+    uint8 ucCpuLoad;
+    uint32 ulFaults;
+    uint32 ulDeadlineMisses;
+} Display_SystemState_t;
+
+static Display_SeatState_t axLatest[DISPLAY_MAX_SEATS];
+static Display_SeatState_t axShown[DISPLAY_MAX_SEATS];
+static Display_SystemState_t xSystemLatest;
+static Display_SystemState_t xSystemShown;
+static uint32 ulKnownSeats = 0;     /* One bit per seat with a state */
+static uint32 ulShownSeats = 0;     /* One bit per seat already transmitted */
+static uint8 ucRefreshCount = 0;
+static boolean bKeyframeDue = FALSE;
+static Display_ModeType eMode = DISPLAY_MODE_LINES;
+static Display_ModeType eDrawnMode = DISPLAY_MODE_LINES;
+static Display_Stats_t xStats;
+
+static uint32 Display_StringLength(const uint8 *pcString)
+{
+    uint32 ulLength = 0;
+    while (pcString[ulLength] != '\0')
+    {
+        ulLength++;
+    }
+    return ulLength;
+}
+
+static uint32 Display_IntegerLength(uint32 ulNumber)
+{
+    uint32 ulLength = 1;
+    while (ulNumber >= 10)
+    {
+        ulNumber /= 10;
+        ulLength++;
+    }
+    return ulLength;
+}
+
+static void Display_SendString(const uint8 *pcString)
+{
+    xStats.ulBytesSent += Display_StringLength(pcString);
+    UART0_SendString(pcString);
+}
+
+static void Display_SendInteger(uint32 ulNumber)
+{
+    xStats.ulBytesSent += Display_IntegerLength(ulNumber);
+    UART0_SendInteger(ulNumber);
+}
+
+/* Temperatures are in tenths of a degree */
+static uint32 Display_TenthsLength(uint32 ulTenths)
+{
+    return Display_IntegerLength(ulTenths / 10) + 2;
+}
+
+static void Display_SendTenths(uint32 ulTenths)
+{
+    Display_SendInteger(ulTenths / 10);
+    Display_SendString(".");
+    Display_SendInteger(ulTenths % 10);
+}
+
+static void Display_SendPadding(uint32 ulUsed, uint8 ucWidth)
+{
+    for (; ulUsed < ucWidth; ulUsed++)
+    {
+        xStats.ulBytesSent++;
+        UART0_SendByte(' ');
+    }
+}
+
+static void Display_MoveTo(uint8 ucRow, uint8 ucColumn)
+{
+    Display_SendString(DISPLAY_ESC "[");
+    Display_SendInteger(ucRow);
+    Display_SendString(";");
+    Display_SendInteger(ucColumn);
+    Display_SendString("H");
+}
+
+/* A cell is overwritten with padding, so a shorter value leaves no trace of the old one */
+static void Display_IntegerCell(uint8 ucRow, uint8 ucColumn, uint32 ulNumber, uint8 ucWidth)
+{
+    Display_MoveTo(ucRow, ucColumn);
+    Display_SendInteger(ulNumber);
+    Display_SendPadding(Display_IntegerLength(ulNumber), ucWidth);
+}
+
+static void Display_TenthsCell(uint8 ucRow, uint8 ucColumn, uint32 ulTenths, uint8 ucWidth)
+{
+    Display_MoveTo(ucRow, ucColumn);
+    Display_SendTenths(ulTenths);
+    Display_SendPadding(Display_TenthsLength(ulTenths), ucWidth);
+}
+
+static void Display_StringCell(uint8 ucRow, uint8 ucColumn, const uint8 *pcString, uint8 ucWidth)
+{
+    Display_MoveTo(ucRow, ucColumn);
+    Display_SendString(pcString);
+    Display_SendPadding(Display_StringLength(pcString), ucWidth);
+}
+
+static void Display_SendRow(uint8 ucSeat)
+{
+    Display_SendString(axLatest[ucSeat].pcName);
+    Display_SendString("\t\t");
+    Display_SendTenths(axLatest[ucSeat].usTemp);
+    Display_SendString("\t\t");
+    Display_SendInteger(axLatest[ucSeat].ucLevel);
+    Display_SendString("\t\t");
+    Display_SendString(axLatest[ucSeat].pcIntensity);
+    Display_SendString("\r\n");
+}
+
+/* Only the changed fields of one seat, in a single line */
+static void Display_SendChanges(uint8 ucSeat)
+{
+    Display_SendString(axLatest[ucSeat].pcName);
+    Display_SendString(":");
+    if (axLatest[ucSeat].usTemp != axShown[ucSeat].usTemp)
+    {
+        Display_SendString(" Temp ");
+        Display_SendTenths(axLatest[ucSeat].usTemp);
+    }
+    if (axLatest[ucSeat].ucLevel != axShown[ucSeat].ucLevel)
+    {
+        Display_SendString(" Level ");
+        Display_SendInteger(axLatest[ucSeat].ucLevel);
+    }
+    if (axLatest[ucSeat].pcIntensity != axShown[ucSeat].pcIntensity)
+    {
+        Display_SendString(" Intensity ");
+        Display_SendString(axLatest[ucSeat].pcIntensity);
+    }
+    Display_SendString("\r\n");
+}
+
+/* Only the changed cells of one seat, bFull rewrites all of them */
+static void Display_SendSeatCells(uint8 ucSeat, boolean bFull)
+{
+    uint8 ucRow = DISPLAY_FIRST_SEAT_ROW + ucSeat;
+
+    if (bFull == TRUE)
+    {
+        Display_StringCell(ucRow, 1, axLatest[ucSeat].pcName, DISPLAY_TEMP_COLUMN - 1);
+    }
+    if ((bFull == TRUE) || (axLatest[ucSeat].usTemp != axShown[ucSeat].usTemp))
+    {
+        Display_TenthsCell(ucRow, DISPLAY_TEMP_COLUMN, axLatest[ucSeat].usTemp, DISPLAY_TEMP_WIDTH);
+    }
+    if ((bFull == TRUE) || (axLatest[ucSeat].ucLevel != axShown[ucSeat].ucLevel))
+    {
+        Display_IntegerCell(ucRow, DISPLAY_LEVEL_COLUMN, axLatest[ucSeat].ucLevel, DISPLAY_LEVEL_WIDTH);
+    }
+    if ((bFull == TRUE) || (axLatest[ucSeat].pcIntensity != axShown[ucSeat].pcIntensity))
+    {
+        Display_StringCell(ucRow, DISPLAY_INTENSITY_COLUMN, axLatest[ucSeat].pcIntensity, DISPLAY_INTENSITY_WIDTH);
+    }
+}
+
+static void Display_SendSystemCells(boolean bFull)
+{
+    if ((bFull == TRUE) || (xSystemLatest.ucCpuLoad != xSystemShown.ucCpuLoad))
+    {
+        Display_IntegerCell(DISPLAY_SYSTEM_ROW, DISPLAY_CPU_COLUMN, xSystemLatest.ucCpuLoad, DISPLAY_COUNTER_WIDTH);
+    }
+    if ((bFull == TRUE) || (xSystemLatest.ulFaults != xSystemShown.ulFaults))
+    {
+        Display_IntegerCell(DISPLAY_SYSTEM_ROW, DISPLAY_FAULTS_COLUMN, xSystemLatest.ulFaults, DISPLAY_COUNTER_WIDTH);
+    }
+    if ((bFull == TRUE) || (xSystemLatest.ulDeadlineMisses != xSystemShown.ulDeadlineMisses))
+    {
+        Display_IntegerCell(DISPLAY_SYSTEM_ROW, DISPLAY_MISSES_COLUMN, xSystemLatest.ulDeadlineMisses, DISPLAY_COUNTER_WIDTH);
+    }
+    xSystemShown = xSystemLatest;
+}
+
+/* Labels of the fixed layout, then the rows below it become the scrolling region */
+static void Display_DrawLayout(void)
+{
+    Display_SendString(DISPLAY_RESET_SCROLL DISPLAY_CLEAR_SCREEN);
+    Display_MoveTo(1, 1);
+    Display_SendString("Seat heaters");
+    Display_MoveTo(DISPLAY_FIRST_SEAT_ROW - 1, 1);
+    Display_SendString("Seat        Temp   Level  Intensity");
+    Display_MoveTo(DISPLAY_SYSTEM_ROW, 1);
+    Display_SendString("CPU load %");
+    Display_MoveTo(DISPLAY_SYSTEM_ROW, DISPLAY_FAULTS_COLUMN - 8);
+    Display_SendString("Faults");
+    Display_MoveTo(DISPLAY_SYSTEM_ROW, DISPLAY_MISSES_COLUMN - 17);
+    Display_SendString("Deadline misses");
+}
+
+static boolean Display_SeatChanged(uint8 ucSeat)
+{
+    /* Intensities are constant strings, comparing the pointers is enough */
+    return ((axLatest[ucSeat].usTemp != axShown[ucSeat].usTemp) ||
+            (axLatest[ucSeat].ucLevel != axShown[ucSeat].ucLevel) ||
+            (axLatest[ucSeat].pcIntensity != axShown[ucSeat].pcIntensity)) ? TRUE : FALSE;
+}
+
+static boolean Display_SystemChanged(void)
+{
+    return ((xSystemLatest.ucCpuLoad != xSystemShown.ucCpuLoad) ||
+            (xSystemLatest.ulFaults != xSystemShown.ulFaults) ||
+            (xSystemLatest.ulDeadlineMisses != xSystemShown.ulDeadlineMisses)) ? TRUE : FALSE;
+}
+
+void Display_SetMode(Display_ModeType eNewMode)
+{
+    eMode = eNewMode;
+    bKeyframeDue = TRUE;
+}
+
+Display_ModeType Display_GetMode(void)
+{
+    return eMode;
+}
+
+void Display_SetSeat(uint8 ucSeat, const uint8 *pcName, uint16 usTemp, uint8 ucLevel, const uint8 *pcIntensity)
+{
+    axLatest[ucSeat].pcName = pcName;
+    axLatest[ucSeat].usTemp = usTemp;
+    axLatest[ucSeat].ucLevel = ucLevel;
+    axLatest[ucSeat].pcIntensity = pcIntensity;
+    ulKnownSeats |= (1UL << ucSeat);
+
+    /* Reference: the table used to be printed in full for every update of a heating seat */
+    if (ucLevel != 0)
+    {
+        xStats.ulBytesFullTable += (sizeof(DISPLAY_HEADER) - 1) + (sizeof(DISPLAY_SEPARATOR) - 1) +
+                                   Display_StringLength(pcName) + Display_TenthsLength(usTemp) +
+                                   Display_IntegerLength(ucLevel) + Display_StringLength(pcIntensity) + 8;
+    }
+}
+
+void Display_SetSystem(uint8 ucCpuLoad, uint32 ulFaults, uint32 ulDeadlineMisses)
+{
+    xSystemLatest.ucCpuLoad = ucCpuLoad;
+    xSystemLatest.ulFaults = ulFaults;
+    xSystemLatest.ulDeadlineMisses = ulDeadlineMisses;
+}
+
+boolean Display_BeginRefresh(void)
+{
+    uint8 ucSeat;
+
+    ucRefreshCount++;
+    if (ucRefreshCount >= DISPLAY_KEYFRAME_REFRESHES)
+    {
+        ucRefreshCount = 0;
+        bKeyframeDue = ((ulKnownSeats != 0) || (eMode == DISPLAY_MODE_DASHBOARD)) ? TRUE : FALSE;
+    }
+    if (bKeyframeDue == TRUE)
+    {
+        return TRUE;
+    }
+
+    if ((eMode == DISPLAY_MODE_DASHBOARD) && (Display_SystemChanged() == TRUE))
+    {
+        return TRUE;
+    }
+    for (ucSeat = 0; ucSeat < DISPLAY_MAX_SEATS; ucSeat++)
+    {
+        if ((ulKnownSeats & (1UL << ucSeat)) &&
+            (((ulShownSeats & (1UL << ucSeat)) == 0) || (Display_SeatChanged(ucSeat) == TRUE)))
+        {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+void Display_Flush(void)
+{
+    uint8 ucSeat;
+    boolean bKeyframe = bKeyframeDue;
+    boolean bFull;
+
+    bKeyframeDue = FALSE;
+    if (bKeyframe == TRUE)
+    {
+        xStats.ulKeyframes++;
+        if (eMode == DISPLAY_MODE_DASHBOARD)
+        {
+            Display_DrawLayout();
+        }
+        else
+        {
+            if (eDrawnMode == DISPLAY_MODE_DASHBOARD)
+            {
+                /* Give the whole screen back to the scrolling output */
+                Display_SendString(DISPLAY_RESET_SCROLL DISPLAY_CLEAR_SCREEN DISPLAY_ESC "[H");
+            }
+            Display_SendString(DISPLAY_HEADER);
+            Display_SendString(DISPLAY_SEPARATOR);
+        }
+        eDrawnMode = eMode;
+    }
+    else if (eMode == DISPLAY_MODE_DASHBOARD)
+    {
+        /* Cells are addressed absolutely, the cursor goes back to the scrolling output */
+        Display_SendString(DISPLAY_SAVE_CURSOR);
+    }
+
+    for (ucSeat = 0; ucSeat < DISPLAY_MAX_SEATS; ucSeat++)
+    {
+        if ((ulKnownSeats & (1UL << ucSeat)) == 0)
+        {
+            continue;
+        }
+
+        /* A seat shown for the first time gets its full row, afterwards only its changes */
+        bFull = ((bKeyframe == TRUE) || ((ulShownSeats & (1UL << ucSeat)) == 0)) ? TRUE : FALSE;
+        if (eMode == DISPLAY_MODE_DASHBOARD)
+        {
+            Display_SendSeatCells(ucSeat, bFull);
+        }
+        else if (bFull == TRUE)
+        {
+            Display_SendRow(ucSeat);
+        }
+        else if (Display_SeatChanged(ucSeat) == TRUE)
+        {
+            Display_SendChanges(ucSeat);
+        }
+        axShown[ucSeat] = axLatest[ucSeat];
+        ulShownSeats |= (1UL << ucSeat);
+    }
+
+    if (eMode == DISPLAY_MODE_DASHBOARD)
+    {
+        Display_SendSystemCells(bKeyframe);
+        if (bKeyframe == TRUE)
+        {
+            /* Setting the scrolling region homes the cursor, move it into the region */
+            Display_SendString(DISPLAY_ESC "[");
+            Display_SendInteger(DISPLAY_SCROLL_ROW);
+            Display_SendString(";");
+            Display_SendInteger(DISPLAY_TERMINAL_ROWS);
+            Display_SendString("r");
+            Display_MoveTo(DISPLAY_SCROLL_ROW, 1);
+        }
+        else
+        {
+            Display_SendString(DISPLAY_RESTORE_CURSOR);
+        }
+    }
+}
+
+void Display_GetStats(Display_Stats_t *pxStats)
+{
+    *pxStats = xStats;
+}
@@ -0,0 +1,58 @@
+/**********************************************************************************************
+ *
+ * Module: Display
+ *
+ * File Name: display.h
+ *
+ * Description: Header file for the change-only seat display engine
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef DISPLAY_H_
+#define DISPLAY_H_
+
+#include "std_types.h"
+
+#define DISPLAY_MAX_SEATS 8
+#define DISPLAY_KEYFRAME_REFRESHES 50   /* Full table once every N refreshes, for a terminal attached late */
+
+/* VT100 dashboard layout: fixed rows on top, the other console output scrolls below them */
+#define DISPLAY_TERMINAL_ROWS 24
+#define DISPLAY_FIRST_SEAT_ROW 3
+#define DISPLAY_SYSTEM_ROW (DISPLAY_FIRST_SEAT_ROW + DISPLAY_MAX_SEATS)
+#define DISPLAY_SCROLL_ROW (DISPLAY_SYSTEM_ROW + 2)
+
+typedef enum
+{
+    DISPLAY_MODE_LINES,         /* Scrolling lines with the changed fields */
+    DISPLAY_MODE_DASHBOARD      /* Fixed layout, changed cells rewritten in place */
+} Display_ModeType;
+
+typedef struct
+{
+    uint32 ulBytesSent;         /* Bytes transmitted by the engine */
+    uint32 ulBytesFullTable;    /* Bytes the full table per update would have cost */
+    uint32 ulKeyframes;
+} Display_Stats_t;
+
+/* Takes effect with a keyframe at the next refresh */
+void Display_SetMode(Display_ModeType eMode);
+Display_ModeType Display_GetMode(void);
+
+/* Newest state of a seat, nothing is transmitted here. The strings must be constant.
+ * The temperature is in tenths of a degree. */
+void Display_SetSeat(uint8 ucSeat, const uint8 *pcName, uint16 usTemp, uint8 ucLevel, const uint8 *pcIntensity);
+
+/* Newest system counters, only the dashboard shows them */
+void Display_SetSystem(uint8 ucCpuLoad, uint32 ulFaults, uint32 ulDeadlineMisses);
+
+/* Called once per refresh period, TRUE if the refresh has anything to transmit */
+boolean Display_BeginRefresh(void);
+
+/* Transmit the changed fields or the keyframe, the UART mutex must be held */
+void Display_Flush(void);
+
+void Display_GetStats(Display_Stats_t *pxStats);
+
+#endif /* DISPLAY_H_ */
@@ -0,0 +1,65 @@
+/**********************************************************************************************
+ *
+ * Module: Filter
+ *
+ * File Name: filter.c
+ *
+ * Description: source file for the fixed-point sensor filter (median spike rejection + Q15 IIR)
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "filter.h"
+
+void Filter_Init(Filter_t *pxFilter, uint8 ucMedianLength, sint16 sAlpha)
+{
+    if (ucMedianLength > FILTER_MEDIAN_MAX)
+    {
+        ucMedianLength = FILTER_MEDIAN_MAX;
+    }
+    pxFilter->ucMedianLength = (ucMedianLength == 0) ? 1 : (ucMedianLength | 1);
+    pxFilter->sAlpha = sAlpha;
+    pxFilter->ucNext = 0;
+    pxFilter->ucCount = 0;
+    pxFilter->lState = 0;
+}
+
+uint16 Filter_Update(Filter_t *pxFilter, uint16 usSample)
+{
+    uint16 ausSorted[FILTER_MEDIAN_MAX];
+    uint16 usMedian;
+    uint8 ucIndex;
+    uint8 ucHole;
+
+    pxFilter->ausWindow[pxFilter->ucNext] = usSample;
+    pxFilter->ucNext = (pxFilter->ucNext + 1) % pxFilter->ucMedianLength;
+
+    if (pxFilter->ucCount < pxFilter->ucMedianLength)
+    {
+        /* Until the window is full the IIR starts from the raw samples */
+        pxFilter->ucCount++;
+        if (pxFilter->ucCount == 1)
+        {
+            pxFilter->lState = (sint32)usSample << FILTER_STATE_SHIFT;
+            return usSample;
+        }
+        usMedian = usSample;
+    }
+    else
+    {
+        /* Insertion sort of the window, its length is a small constant */
+        for (ucIndex = 0; ucIndex < pxFilter->ucMedianLength; ucIndex++)
+        {
+            for (ucHole = ucIndex; (ucHole > 0) && (ausSorted[ucHole - 1] > pxFilter->ausWindow[ucIndex]); ucHole--)
+            {
+                ausSorted[ucHole] = ausSorted[ucHole - 1];
+            }
+            ausSorted[ucHole] = pxFilter->ausWindow[ucIndex];
+        }
+        usMedian = ausSorted[pxFilter->ucMedianLength / 2];
+    }
+
+    /* 64-bit product, the scaled error times a Q15 weight exceeds 32 bits */
+    pxFilter->lState += (sint32)(((sint64)(((sint32)usMedian << FILTER_STATE_SHIFT) - pxFilter->lState) * pxFilter->sAlpha) >> 15);
+    return (uint16)((pxFilter->lState + (1 << (FILTER_STATE_SHIFT - 1))) >> FILTER_STATE_SHIFT);
+}
@@ -0,0 +1,38 @@
+/**********************************************************************************************
+ *
+ * Module: Filter
+ *
+ * File Name: filter.h
+ *
+ * Description: Header file for the fixed-point sensor filter (median spike rejection + Q15 IIR)
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef FILTER_H_
+#define FILTER_H_
+
+#include "std_types.h"
+
+#define FILTER_MEDIAN_MAX 7                 /* Odd window lengths 1 .. 7, 1 disables the median */
+#define FILTER_Q15_ONE ((sint32)32767)      /* IIR weight 1.0: the IIR passes the median through */
+#define FILTER_Q15(x) ((sint16)(((x) >= 1.0f) ? 32767 : ((x) * 32768.0f)))
+#define FILTER_STATE_SHIFT 8                /* Fraction bits kept in the IIR state */
+
+typedef struct
+{
+    uint8 ucMedianLength;
+    sint16 sAlpha;                          /* Q15 weight of a new sample */
+    uint16 ausWindow[FILTER_MEDIAN_MAX];    /* Newest samples, circular */
+    uint8 ucNext;
+    uint8 ucCount;
+    sint32 lState;                          /* IIR output << FILTER_STATE_SHIFT */
+} Filter_t;
+
+void Filter_Init(Filter_t *pxFilter, uint8 ucMedianLength, sint16 sAlpha);
+
+/* Median of the last samples followed by y += alpha * (median - y).
+ * Integer only, bounded work per sample (at most FILTER_MEDIAN_MAX elements sorted). */
+uint16 Filter_Update(Filter_t *pxFilter, uint16 usSample);
+
+#endif /* FILTER_H_ */
@@ -0,0 +1,126 @@
+/**********************************************************************************************
+ *
+ * Module: Latency
+ *
+ * File Name: latency.c
+ *
+ * Description: source file for the latency probes, log2 bucketed histograms of DWT cycle counts
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "latency.h"
+#include "tm4c123gh6pm_registers.h"
+
+typedef struct
+{
+    uint32 aulBuckets[LATENCY_BUCKETS];
+    uint32 ulCount;
+    uint32 ulMax;
+} Latency_HistogramType;
+
+static Latency_HistogramType axHistogram[LATENCY_MAX_SOURCES];
+
+/* Index of the highest set bit, in 5 steps whatever the value */
+static uint8 Latency_Log2(uint32 ulValue)
+{
+    uint8 ucLog = 0;
+
+    if (ulValue >= (1UL << 16)) { ulValue >>= 16; ucLog += 16; }
+    if (ulValue >= (1UL << 8))  { ulValue >>= 8;  ucLog += 8;  }
+    if (ulValue >= (1UL << 4))  { ulValue >>= 4;  ucLog += 4;  }
+    if (ulValue >= (1UL << 2))  { ulValue >>= 2;  ucLog += 2;  }
+    if (ulValue >= (1UL << 1))  { ucLog += 1; }
+    return ucLog;
+}
+
+void Latency_Init(void)
+{
+    CORE_DEMCR_REG |= (1UL << 24);    /* TRCENA */
+    DWT_CYCCNT_REG = 0;
+    DWT_CTRL_REG |= 0x01;             /* CYCCNTENA */
+}
+
+uint32 Latency_Timestamp(void)
+{
+    return DWT_CYCCNT_REG;
+}
+
+void Latency_Record(uint8 ucSource, uint32 ulStartCycles)
+{
+    Latency_RecordCycles(ucSource, DWT_CYCCNT_REG - ulStartCycles);
+}
+
+void Latency_RecordCycles(uint8 ucSource, uint32 ulCycles)
+{
+    Latency_HistogramType *pxHistogram;
+
+    if (ucSource >= LATENCY_MAX_SOURCES)
+    {
+        return;
+    }
+    pxHistogram = &axHistogram[ucSource];
+    pxHistogram->aulBuckets[Latency_Log2(ulCycles)]++;
+    pxHistogram->ulCount++;
+    if (ulCycles > pxHistogram->ulMax)
+    {
+        pxHistogram->ulMax = ulCycles;
+    }
+}
+
+uint32 Latency_GetCount(uint8 ucSource)
+{
+    return (ucSource < LATENCY_MAX_SOURCES) ? axHistogram[ucSource].ulCount : 0;
+}
+
+uint32 Latency_GetMax(uint8 ucSource)
+{
+    return (ucSource < LATENCY_MAX_SOURCES) ? axHistogram[ucSource].ulMax : 0;
+}
+
+uint32 Latency_Percentile(uint8 ucSource, uint8 ucPercent)
+{
+    Latency_HistogramType *pxHistogram;
+    uint32 ulTarget, ulSeen = 0, ulBound;
+    uint8 ucBucket;
+
+    if (ucSource >= LATENCY_MAX_SOURCES || axHistogram[ucSource].ulCount == 0)
+    {
+        return 0;
+    }
+    pxHistogram = &axHistogram[ucSource];
+
+    /* Rank of the sample at the percentile, rounded up */
+    ulTarget = (uint32)(((uint64)pxHistogram->ulCount * ucPercent + 99) / 100);
+    if (ulTarget == 0)
+    {
+        ulTarget = 1;
+    }
+
+    for (ucBucket = 0; ucBucket < LATENCY_BUCKETS; ucBucket++)
+    {
+        ulSeen += pxHistogram->aulBuckets[ucBucket];
+        if (ulSeen >= ulTarget)
+        {
+            break;
+        }
+    }
+    ulBound = (ucBucket >= 31) ? 0xFFFFFFFFUL : ((2UL << ucBucket) - 1);
+    return (ulBound < pxHistogram->ulMax) ? ulBound : pxHistogram->ulMax;
+}
+
+void Latency_Reset(uint8 ucSource)
+{
+    uint8 ucBucket;
+
+    if (ucSource >= LATENCY_MAX_SOURCES)
+    {
+        return;
+    }
+    for (ucBucket = 0; ucBucket < LATENCY_BUCKETS; ucBucket++)
+    {
+        axHistogram[ucSource].aulBuckets[ucBucket] = 0;
+    }
+    axHistogram[ucSource].ulCount = 0;
+    axHistogram[ucSource].ulMax = 0;
+}
@@ -0,0 +1,45 @@
+/**********************************************************************************************
+ *
+ * Module: Latency
+ *
+ * File Name: latency.h
+ *
+ * Description: Header file for the latency probes, log2 bucketed histograms of DWT cycle counts
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef LATENCY_H_
+#define LATENCY_H_
+
+#include "std_types.h"
+
+#define LATENCY_MAX_SOURCES     4
+
+/* Bucket n counts the latencies in [2^n, 2^(n+1)) cycles, bucket 0 also counts 0 */
+#define LATENCY_BUCKETS         32
+
+#define LATENCY_CLOCK_HZ        16000000UL
+#define LATENCY_CYCLES_TO_US(c) ((c) / (LATENCY_CLOCK_HZ / 1000000UL))
+
+/* Start the DWT cycle counter, must be called before the first probe */
+void Latency_Init(void);
+
+/* Time stamp of the start of an event, usually taken at ISR entry */
+uint32 Latency_Timestamp(void);
+
+/* Record the cycles elapsed since ulStartCycles (typically at task wake-up) */
+void Latency_Record(uint8 ucSource, uint32 ulStartCycles);
+
+/* Record a latency measured elsewhere, in cycles */
+void Latency_RecordCycles(uint8 ucSource, uint32 ulCycles);
+
+uint32 Latency_GetCount(uint8 ucSource);
+uint32 Latency_GetMax(uint8 ucSource);
+
+/* Upper bound (cycles) of the bucket holding the given percentile, clamped to the maximum */
+uint32 Latency_Percentile(uint8 ucSource, uint8 ucPercent);
+
+void Latency_Reset(uint8 ucSource);
+
+#endif /* LATENCY_H_ */
@@ -0,0 +1,105 @@
+/**********************************************************************************************
+ *
+ * Module: Low Power
+ *
+ * File Name: low_power.c
+ *
+ * Description: source file for the tickless idle implementation (GPTM wake-up + WFI sleep)
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "low_power.h"
+#include "GPTM.h"
+#include "tm4c123gh6pm_registers.h"
+
+#define LOW_POWER_SYSTICK_ENABLE_MASK   0x00000001
+#define LOW_POWER_CYCLES_PER_TICK       (configCPU_CLOCK_HZ / configTICK_RATE_HZ)
+#define LOW_POWER_WTIMER_PER_TICK       (10000UL / configTICK_RATE_HZ)   /* WTimer0 runs at 10kHz */
+
+/* Longest sleep so that the reload value fits in the 32-bit wake-up timer */
+#define LOW_POWER_MAX_IDLE_TICKS        (0xFFFFFFFFUL / LOW_POWER_CYCLES_PER_TICK)
+
+static LowPower_Stats_t xSleepStats = {0, 0};
+static uint32 ulPartialTick = 0;    /* Sleep time not yet accounted as a whole tick */
+
+void LowPower_Init(void)
+{
+    GPTM_Timer0Init();
+}
+
+void LowPower_GetStats(LowPower_Stats_t *pxStats)
+{
+    taskENTER_CRITICAL();
+    *pxStats = xSleepStats;
+    taskEXIT_CRITICAL();
+}
+
+/* Called by the idle task through portSUPPRESS_TICKS_AND_SLEEP() */
+void vLowPowerSuppressTicksAndSleep(uint32_t xExpectedIdleTime)
+{
+    uint32 ulSleepStart, ulSlept, ulTicks;
+
+    if (xExpectedIdleTime > LOW_POWER_MAX_IDLE_TICKS)
+    {
+        xExpectedIdleTime = LOW_POWER_MAX_IDLE_TICKS;
+    }
+
+    /* Stop the tick, the part of the current tick that is left is added to the sleep */
+    SYSTICK_CTRL_REG &= ~LOW_POWER_SYSTICK_ENABLE_MASK;
+
+    __asm(" cpsid i");
+    __asm(" dsb");
+    __asm(" isb");
+
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep)
+    {
+        /* A task became ready meanwhile, resume the tick where it stopped */
+        SYSTICK_CTRL_REG |= LOW_POWER_SYSTICK_ENABLE_MASK;
+        __asm(" cpsie i");
+        return;
+    }
+
+    ulSleepStart = GPTM_WTimer0Read();
+    GPTM_Timer0StartOneShot(((xExpectedIdleTime - 1) * LOW_POWER_CYCLES_PER_TICK) + SYSTICK_CURRENT_REG);
+
+    __asm(" dsb");
+    __asm(" wfi");
+    __asm(" isb");
+
+    /* Let the wake-up interrupt (or whatever woke us) run, then account for the sleep */
+    __asm(" cpsie i");
+    __asm(" dsb");
+    __asm(" isb");
+    __asm(" cpsid i");
+
+    GPTM_Timer0Stop();
+
+    /* WTimer0 kept running, so it tells how long we really slept */
+    ulSlept = GPTM_WTimer0Read() - ulSleepStart;
+    xSleepStats.ulTimeAsleep += ulSlept;
+    xSleepStats.ulSleepCount++;
+
+    ulPartialTick += ulSlept;
+    ulTicks = ulPartialTick / LOW_POWER_WTIMER_PER_TICK;
+    /* Stepping up to the unblock time is allowed, the kernel pends that last tick */
+    if (ulTicks > xExpectedIdleTime)
+    {
+        ulTicks = xExpectedIdleTime;
+    }
+    ulPartialTick -= ulTicks * LOW_POWER_WTIMER_PER_TICK;
+    if (ulPartialTick >= LOW_POWER_WTIMER_PER_TICK)
+    {
+        ulPartialTick = LOW_POWER_WTIMER_PER_TICK - 1;
+    }
+    vTaskStepTick(ulTicks);
+
+    /* Restart the tick with a full period */
+    SYSTICK_CURRENT_REG = 0;
+    SYSTICK_CTRL_REG |= LOW_POWER_SYSTICK_ENABLE_MASK;
+
+    __asm(" cpsie i");
+}
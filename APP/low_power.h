@@ -0,0 +1,29 @@
+/**********************************************************************************************
+ *
+ * Module: Low Power
+ *
+ * File Name: low_power.h
+ *
+ * Description: Header file for the tickless idle implementation (GPTM wake-up + WFI sleep)
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef LOW_POWER_H_
+#define LOW_POWER_H_
+
+#include "std_types.h"
+
+/* Sleep statistics, the time is in WTimer0 ticks (0.1 msec) */
+typedef struct
+{
+    uint32 ulTimeAsleep;
+    uint32 ulSleepCount;
+} LowPower_Stats_t;
+
+/* Must be called before the scheduler starts */
+void LowPower_Init(void);
+
+void LowPower_GetStats(LowPower_Stats_t *pxStats);
+
+#endif /* LOW_POWER_H_ */
@@ -0,0 +1,60 @@
+/**********************************************************************************************
+ *
+ * Module: Periodic
+ *
+ * File Name: periodic.c
+ *
+ * Description: source file for the periodic task wrapper with deadline miss detection
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "periodic.h"
+
+void Periodic_Init(Periodic_Task_t *pxTask, const uint8 *pcName, uint8 ucId,
+                   TickType_t xPeriod, TickType_t xDeadline, Periodic_MissHookType pfMissHook)
+{
+    pxTask->pcName = pcName;
+    pxTask->ucId = ucId;
+    pxTask->xPeriod = xPeriod;
+    pxTask->xDeadline = xDeadline;
+    pxTask->pfMissHook = pfMissHook;
+    pxTask->xRelease = xTaskGetTickCount();
+    pxTask->bJobRunning = FALSE;
+    pxTask->ulJobs = 0;
+    pxTask->ulMisses = 0;
+    pxTask->xMaxLateness = 0;
+    pxTask->xMaxResponse = 0;
+}
+
+void Periodic_WaitNextJob(Periodic_Task_t *pxTask)
+{
+    TickType_t xResponse;
+
+    if (pxTask->bJobRunning == TRUE)
+    {
+        /* Response time of the job that just completed, from its ideal release */
+        xResponse = xTaskGetTickCount() - pxTask->xRelease;
+        if (xResponse > pxTask->xMaxResponse)
+        {
+            pxTask->xMaxResponse = xResponse;
+        }
+        if (xResponse > pxTask->xDeadline)
+        {
+            pxTask->ulMisses++;
+            if ((xResponse - pxTask->xDeadline) > pxTask->xMaxLateness)
+            {
+                pxTask->xMaxLateness = xResponse - pxTask->xDeadline;
+            }
+            if (pxTask->pfMissHook != NULL_PTR)
+            {
+                pxTask->pfMissHook(pxTask, xResponse - pxTask->xDeadline);
+            }
+        }
+    }
+
+    /* xRelease becomes the ideal release time, even when an overrun made it pass already */
+    vTaskDelayUntil(&pxTask->xRelease, pxTask->xPeriod);
+    pxTask->ulJobs++;
+    pxTask->bJobRunning = TRUE;
+}
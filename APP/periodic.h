@@ -0,0 +1,47 @@
+/**********************************************************************************************
+ *
+ * Module: Periodic
+ *
+ * File Name: periodic.h
+ *
+ * Description: Header file for the periodic task wrapper with deadline miss detection
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef PERIODIC_H_
+#define PERIODIC_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "std_types.h"
+
+typedef struct Periodic_Task Periodic_Task_t;
+
+/* Called by the task itself when a job completes after its deadline */
+typedef void (*Periodic_MissHookType)(Periodic_Task_t *pxTask, TickType_t xLateness);
+
+struct Periodic_Task
+{
+    const uint8 *pcName;
+    uint8 ucId;                     /* Free for the application, e.g. the task tag */
+    TickType_t xPeriod;
+    TickType_t xDeadline;           /* Relative to the release */
+    Periodic_MissHookType pfMissHook;
+    TickType_t xRelease;            /* Ideal release time of the current job */
+    boolean bJobRunning;
+    uint32 ulJobs;
+    uint32 ulMisses;
+    TickType_t xMaxLateness;
+    TickType_t xMaxResponse;
+};
+
+/* Must be called by the task before its loop, the first release is one period later */
+void Periodic_Init(Periodic_Task_t *pxTask, const uint8 *pcName, uint8 ucId,
+                   TickType_t xPeriod, TickType_t xDeadline, Periodic_MissHookType pfMissHook);
+
+/* Replaces vTaskDelayUntil at the top of the loop: completes the previous job,
+ * then blocks until the next release. Constant work per period. */
+void Periodic_WaitNextJob(Periodic_Task_t *pxTask);
+
+#endif /* PERIODIC_H_ */
@@ -0,0 +1,75 @@
+/**********************************************************************************************
+ *
+ * Module: PID
+ *
+ * File Name: pid.c
+ *
+ * Description: source file for the fixed-point (Q15) PID temperature controller
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "pid.h"
+
+static sint32 PID_Clamp(sint32 lValue, sint32 lMin, sint32 lMax)
+{
+    if (lValue < lMin)
+    {
+        return lMin;
+    }
+    if (lValue > lMax)
+    {
+        return lMax;
+    }
+    return lValue;
+}
+
+void PID_Init(PID_Controller_t *pxPid, const PID_Gains_t *pxGains)
+{
+    pxPid->pxGains = pxGains;
+    PID_Reset(pxPid);
+}
+
+void PID_SetGains(PID_Controller_t *pxPid, const PID_Gains_t *pxGains)
+{
+    pxPid->pxGains = pxGains;
+}
+
+void PID_Reset(PID_Controller_t *pxPid)
+{
+    pxPid->lIntegral = 0;
+    pxPid->sPrevMeasurement = 0;
+    pxPid->bFirstRun = TRUE;
+}
+
+uint16 PID_Update(PID_Controller_t *pxPid, sint16 sSetPoint, sint16 sMeasurement, uint16 usDt)
+{
+    sint32 lError = (sint32)sSetPoint - sMeasurement;
+    sint32 lProportional, lDerivative, lIntegral, lOutput;
+    sint32 lDt = PID_Clamp(usDt, 1, PID_DT_MAX);
+
+    if (pxPid->bFirstRun == TRUE)
+    {
+        pxPid->sPrevMeasurement = sMeasurement;
+        pxPid->bFirstRun = FALSE;
+    }
+
+    lProportional = (sint32)pxPid->pxGains->sKp * lError;
+
+    /* Derivative on measurement so a level change doesn't kick the output */
+    lDerivative = -(sint32)(((sint64)pxPid->pxGains->sKd * ((sint32)sMeasurement - pxPid->sPrevMeasurement) * PID_DT_ONE) / lDt);
+    pxPid->sPrevMeasurement = sMeasurement;
+
+    /* The integral grows with the time the error lasted, not with the number of updates */
+    lIntegral = pxPid->lIntegral + (sint32)(((sint64)pxPid->pxGains->sKi * lError * lDt) / PID_DT_ONE);
+    lOutput = lProportional + (lIntegral >> PID_KI_EXTRA_BITS) + lDerivative;
+
+    /* Anti-windup: only integrate when it doesn't push a saturated output further */
+    if (!((lOutput > PID_Q15_ONE && lError > 0) || (lOutput < 0 && lError < 0)))
+    {
+        pxPid->lIntegral = PID_Clamp(lIntegral, 0, PID_INTEGRAL_MAX);
+    }
+
+    lOutput = lProportional + (pxPid->lIntegral >> PID_KI_EXTRA_BITS) + lDerivative;
+    return (uint16)PID_Clamp(lOutput, 0, PID_Q15_ONE);
+}
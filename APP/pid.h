@@ -0,0 +1,63 @@
+/**********************************************************************************************
+ *
+ * Module: PID
+ *
+ * File Name: pid.h
+ *
+ * Description: Header file for the fixed-point (Q15) PID temperature controller
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef PID_H_
+#define PID_H_
+
+#include "std_types.h"
+
+/* Q15 representation of 1.0 (full heater power) */
+#define PID_Q15_ONE          ((sint32)32767)
+
+/* Convert a constant fraction (< 1.0) to Q15 at compile time */
+#define PID_Q15(x)           ((sint16)((x) * 32768.0f))
+
+/* The integral gain and the integrator carry PID_KI_EXTRA_BITS more fraction bits than Q15:
+ * a Ki of 0.0004 is 210 counts (0.13% off) instead of 13 (0.8% off). Up to 0.0625. */
+#define PID_KI_EXTRA_BITS    4
+#define PID_KI(x)            ((sint16)((x) * (32768.0f * (1 << PID_KI_EXTRA_BITS)) + 0.5f))
+#define PID_INTEGRAL_MAX     (PID_Q15_ONE << PID_KI_EXTRA_BITS)
+
+/* Time since the previous update, in PID_DT_ONE units of the period the gains are tuned for.
+ * Longer gaps are clamped to PID_DT_MAX so a stalled sensor doesn't wind the integral up. */
+#define PID_DT_ONE           256
+#define PID_DT_MAX           (4 * PID_DT_ONE)
+#define PID_DT(elapsed, period)  ((uint16)((((uint32)(elapsed) * PID_DT_ONE) + ((period) / 2)) / (period)))
+
+/* Gains are fractions of full power per unit of error (Ki per period, Kd per unit per period),
+ * Kp and Kd in Q15 and Ki from PID_KI. The unit is the one of the set point and the measurement. */
+typedef struct
+{
+    sint16 sKp;
+    sint16 sKi;
+    sint16 sKd;
+} PID_Gains_t;
+
+typedef struct
+{
+    const PID_Gains_t *pxGains;
+    sint32 lIntegral;           /* Q15 + PID_KI_EXTRA_BITS, kept within [0, PID_INTEGRAL_MAX] */
+    sint16 sPrevMeasurement;
+    boolean bFirstRun;
+} PID_Controller_t;
+
+void PID_Init(PID_Controller_t *pxPid, const PID_Gains_t *pxGains);
+
+/* Switch gains without resetting the integrator (bumpless level change) */
+void PID_SetGains(PID_Controller_t *pxPid, const PID_Gains_t *pxGains);
+
+void PID_Reset(PID_Controller_t *pxPid);
+
+/* Run one controller step usDt after the previous one (PID_DT_ONE at the tuned rate),
+ * returns the heater duty in Q15 (0 .. PID_Q15_ONE) */
+uint16 PID_Update(PID_Controller_t *pxPid, sint16 sSetPoint, sint16 sMeasurement, uint16 usDt);
+
+#endif /* PID_H_ */
@@ -0,0 +1,124 @@
+/**********************************************************************************************
+ *
+ * Module: Plant
+ *
+ * File Name: plant.c
+ *
+ * Description: source file for the seat thermal model used to close the control loop without a car
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "plant.h"
+#include "potentiometer.h"
+
+#define PLANT_MICRO_PER_TENTH 100000L
+
+void Plant_Init(Plant_t *pxPlant, const Plant_Config_t *pxConfig, uint32 ulSeed)
+{
+    pxPlant->pxConfig = pxConfig;
+    pxPlant->lTempMicro = pxConfig->lAmbientMilli * 1000L;
+    pxPlant->ucDuty = 0;
+    pxPlant->ulNoiseState = ulSeed;
+    pxPlant->ullTimeMs = 0;
+    pxPlant->ullEnergyUj = 0;
+    pxPlant->usTarget = 0;
+    pxPlant->bRising = FALSE;
+    pxPlant->ullStepStartMs = 0;
+    pxPlant->ullLastOutsideMs = 0;
+    pxPlant->sOvershoot = 0;
+}
+
+void Plant_SetDuty(Plant_t *pxPlant, uint8 ucDuty)
+{
+    pxPlant->ucDuty = (ucDuty > 100) ? 100 : ucDuty;
+}
+
+void Plant_SetTarget(Plant_t *pxPlant, uint16 usTarget)
+{
+    if (usTarget == pxPlant->usTarget)
+    {
+        return;
+    }
+    pxPlant->usTarget = usTarget;
+    pxPlant->bRising = (usTarget > Plant_GetTemperature(pxPlant)) ? TRUE : FALSE;
+    pxPlant->ullStepStartMs = pxPlant->ullTimeMs;
+    pxPlant->ullLastOutsideMs = pxPlant->ullTimeMs;
+    pxPlant->sOvershoot = 0;
+}
+
+void Plant_Advance(Plant_t *pxPlant, uint32 ulMs)
+{
+    const Plant_Config_t *pxConfig = pxPlant->pxConfig;
+    sint64 llHeaterMw = ((sint64)pxConfig->ulHeaterPowerMw * pxPlant->ucDuty) / 100;
+    sint64 llLossMw;
+    sint32 lError;
+
+    /* mW * (micro-degrees / 10^6) --> mW lost through each path */
+    llLossMw = ((sint64)pxConfig->ulAmbientConductance * (pxPlant->lTempMicro - pxConfig->lAmbientMilli * 1000L) +
+                (sint64)pxConfig->ulOccupantConductance * (pxPlant->lTempMicro - pxConfig->lOccupantMilli * 1000L)) / 1000000L;
+
+    /* mW * msec = uJ, uJ / (J/K) = micro-degrees */
+    pxPlant->lTempMicro += (sint32)(((llHeaterMw - llLossMw) * ulMs) / pxConfig->ulHeatCapacity);
+    pxPlant->ullEnergyUj += (uint64)llHeaterMw * ulMs;
+    pxPlant->ullTimeMs += ulMs;
+
+    if (pxPlant->usTarget == 0)
+    {
+        return;
+    }
+
+    lError = (sint32)Plant_GetTemperature(pxPlant) - pxPlant->usTarget;
+    if (pxPlant->bRising == FALSE)
+    {
+        lError = -lError;
+    }
+    if (lError > pxPlant->sOvershoot)
+    {
+        pxPlant->sOvershoot = (sint16)lError;
+    }
+    if (lError > PLANT_SETTLING_BAND || lError < -PLANT_SETTLING_BAND)
+    {
+        pxPlant->ullLastOutsideMs = pxPlant->ullTimeMs;
+    }
+}
+
+uint16 Plant_GetTemperature(const Plant_t *pxPlant)
+{
+    if (pxPlant->lTempMicro <= 0)
+    {
+        return 0;
+    }
+    return (uint16)((pxPlant->lTempMicro + (PLANT_MICRO_PER_TENTH / 2)) / PLANT_MICRO_PER_TENTH);
+}
+
+uint16 Plant_ReadSensor(Plant_t *pxPlant)
+{
+    sint32 lCode = Temperature_to_ADC(Plant_GetTemperature(pxPlant));
+    uint32 ulSpan = 2UL * pxPlant->pxConfig->ucNoiseLsb + 1;
+
+    /* Numerical Recipes LCG, the upper bits are the better ones */
+    pxPlant->ulNoiseState = pxPlant->ulNoiseState * 1664525UL + 1013904223UL;
+    lCode += (sint32)((pxPlant->ulNoiseState >> 16) % ulSpan) - pxPlant->pxConfig->ucNoiseLsb;
+
+    if (lCode < 0)
+    {
+        lCode = 0;
+    }
+    else if (lCode > ADC_RANGE)
+    {
+        lCode = ADC_RANGE;
+    }
+    return (uint16)lCode;
+}
+
+uint32 Plant_GetSettlingMs(const Plant_t *pxPlant)
+{
+    sint32 lError = (sint32)Plant_GetTemperature(pxPlant) - pxPlant->usTarget;
+
+    if (pxPlant->usTarget == 0 || lError > PLANT_SETTLING_BAND || lError < -PLANT_SETTLING_BAND)
+    {
+        return PLANT_NOT_SETTLED;
+    }
+    return (uint32)(pxPlant->ullLastOutsideMs - pxPlant->ullStepStartMs);
+}
@@ -0,0 +1,76 @@
+/**********************************************************************************************
+ *
+ * Module: Plant
+ *
+ * File Name: plant.h
+ *
+ * Description: Header file for the seat thermal model used to close the control loop without a car
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef PLANT_H_
+#define PLANT_H_
+
+#include "std_types.h"
+
+/*
+ * Lumped model of one seat cushion:
+ *
+ *   C * dT/dt = duty * P  -  Ga * (T - Tambient)  -  Go * (T - Toccupant)
+ *
+ * Integer Euler steps, temperatures in micro-degrees, energy in micro-joules.
+ */
+#define PLANT_SETTLING_BAND 5           /* Tenths of a degree around the target */
+#define PLANT_NOT_SETTLED 0xFFFFFFFFUL
+
+typedef struct
+{
+    uint32 ulHeaterPowerMw;             /* Heater power at 100 % duty */
+    uint32 ulHeatCapacity;              /* J/K of the cushion and its cover */
+    uint32 ulAmbientConductance;        /* mW/K to the cabin air */
+    uint32 ulOccupantConductance;       /* mW/K to the occupant, 0 for an empty seat */
+    sint32 lAmbientMilli;               /* Cabin temperature, milli-degrees */
+    sint32 lOccupantMilli;              /* Skin temperature, milli-degrees */
+    uint8 ucNoiseLsb;                   /* Peak sensor noise in ADC codes */
+} Plant_Config_t;
+
+typedef struct
+{
+    const Plant_Config_t *pxConfig;
+    sint32 lTempMicro;
+    uint8 ucDuty;
+    uint32 ulNoiseState;
+    uint64 ullTimeMs;                   /* Simulated time */
+    uint64 ullEnergyUj;                 /* Heater energy */
+
+    /* Response to the last change of the target */
+    uint16 usTarget;                    /* Tenths of a degree, 0 = no target */
+    boolean bRising;
+    uint64 ullStepStartMs;
+    uint64 ullLastOutsideMs;            /* Last time the temperature was out of the settling band */
+    sint16 sOvershoot;                  /* Tenths of a degree beyond the target */
+} Plant_t;
+
+/* Start at the ambient temperature with the heater off */
+void Plant_Init(Plant_t *pxPlant, const Plant_Config_t *pxConfig, uint32 ulSeed);
+
+/* Heater duty in percent, applied until the next call */
+void Plant_SetDuty(Plant_t *pxPlant, uint8 ucDuty);
+
+/* Set point of the controller, a change starts a new step response */
+void Plant_SetTarget(Plant_t *pxPlant, uint16 usTarget);
+
+/* Advance the model by ulMs of simulated time */
+void Plant_Advance(Plant_t *pxPlant, uint32 ulMs);
+
+/* Seat temperature in tenths of a degree */
+uint16 Plant_GetTemperature(const Plant_t *pxPlant);
+
+/* Reading of the seat sensor as a single ADC conversion, noise included */
+uint16 Plant_ReadSensor(Plant_t *pxPlant);
+
+/* Time from the last target change until the temperature stayed in the band, PLANT_NOT_SETTLED if outside now */
+uint32 Plant_GetSettlingMs(const Plant_t *pxPlant);
+
+#endif /* PLANT_H_ */
@@ -0,0 +1,98 @@
+/**********************************************************************************************
+ *
+ * Module: RTA
+ *
+ * File Name: rta.c
+ *
+ * Description: source file for the fixed-priority response time analysis of the task set
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "rta.h"
+
+void RTA_UpdateMeasurement(RTA_Task_t *pxTask, uint32 ulExecution, uint32 ulCriticalSection, uint32 ulNonPreemptive)
+{
+    if (ulExecution > pxTask->ulWcet)
+    {
+        pxTask->ulWcet = ulExecution;
+    }
+    if (ulCriticalSection > pxTask->ulCriticalSection)
+    {
+        pxTask->ulCriticalSection = ulCriticalSection;
+    }
+    if (ulNonPreemptive > pxTask->ulNonPreemptive)
+    {
+        pxTask->ulNonPreemptive = ulNonPreemptive;
+    }
+}
+
+/* Longest critical section of a lower priority task that can block pxTask: a shared resource
+ * held under priority inheritance, or any section with interrupts disabled */
+static uint32 RTA_Blocking(const RTA_Task_t *pxTasks, uint8 ucCount, const RTA_Task_t *pxTask)
+{
+    uint8 ucIndex;
+    uint32 ulBlocking = 0;
+
+    for (ucIndex = 0; ucIndex < ucCount; ucIndex++)
+    {
+        const RTA_Task_t *pxOther = &pxTasks[ucIndex];
+        if (pxOther->ucPriority >= pxTask->ucPriority)
+        {
+            continue;
+        }
+        if (((pxOther->ucResources & pxTask->ucResources) != 0) &&
+            (pxOther->ulCriticalSection > ulBlocking))
+        {
+            ulBlocking = pxOther->ulCriticalSection;
+        }
+        if (pxOther->ulNonPreemptive > ulBlocking)
+        {
+            ulBlocking = pxOther->ulNonPreemptive;
+        }
+    }
+    return ulBlocking;
+}
+
+void RTA_Analyse(RTA_Task_t *pxTasks, uint8 ucCount)
+{
+    uint8 ucTask, ucIndex;
+    uint32 ulResponse, ulNext;
+
+    for (ucTask = 0; ucTask < ucCount; ucTask++)
+    {
+        RTA_Task_t *pxTask = &pxTasks[ucTask];
+
+        pxTask->ulBlocking = RTA_Blocking(pxTasks, ucCount, pxTask);
+
+        /* R = C + B + sum over higher/equal priority tasks of ceil(R / Tj) * Cj */
+        ulResponse = pxTask->ulWcet + pxTask->ulBlocking;
+        for (;;)
+        {
+            ulNext = pxTask->ulWcet + pxTask->ulBlocking;
+            for (ucIndex = 0; ucIndex < ucCount; ucIndex++)
+            {
+                const RTA_Task_t *pxOther = &pxTasks[ucIndex];
+                /* Equal priority tasks are round-robin scheduled, count them as interference */
+                if (ucIndex == ucTask || pxOther->ucPriority < pxTask->ucPriority || pxOther->ulPeriod == 0)
+                {
+                    continue;
+                }
+                ulNext += ((ulResponse + pxOther->ulPeriod - 1) / pxOther->ulPeriod) * pxOther->ulWcet;
+            }
+
+            if (ulNext > pxTask->ulPeriod)
+            {
+                ulResponse = RTA_UNSCHEDULABLE;
+                break;
+            }
+            if (ulNext == ulResponse)
+            {
+                break;
+            }
+            ulResponse = ulNext;
+        }
+        pxTask->ulResponse = ulResponse;
+        pxTask->ulSlack = (ulResponse == RTA_UNSCHEDULABLE) ? 0 : (pxTask->ulPeriod - ulResponse);
+    }
+}
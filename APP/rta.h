@@ -0,0 +1,44 @@
+/**********************************************************************************************
+ *
+ * Module: RTA
+ *
+ * File Name: rta.h
+ *
+ * Description: Header file for the fixed-priority response time analysis of the task set
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef RTA_H_
+#define RTA_H_
+
+#include "std_types.h"
+
+/* Shared resources a task may lock, used to compute the blocking terms */
+#define RTA_RESOURCE_UART_MUTEX     (1U << 0)
+
+/* Response time reported when the iteration exceeds the deadline */
+#define RTA_UNSCHEDULABLE           0xFFFFFFFFUL
+
+/* All times are in WTimer0 ticks (0.1 msec), deadlines are equal to the periods */
+typedef struct
+{
+    const uint8 *pcName;
+    uint32 ulPeriod;            /* Period or minimum inter-arrival time */
+    uint8 ucPriority;
+    uint8 ucResources;          /* RTA_RESOURCE_xxx used by the task */
+    uint32 ulWcet;              /* Worst measured execution time of one job */
+    uint32 ulCriticalSection;   /* Worst measured time holding one of its resources */
+    uint32 ulNonPreemptive;     /* Worst measured time with interrupts disabled, blocks everyone */
+    uint32 ulBlocking;          /* Output: blocking by lower priority tasks */
+    uint32 ulResponse;          /* Output: worst-case response time */
+    uint32 ulSlack;             /* Output: deadline - response, 0 when unschedulable */
+} RTA_Task_t;
+
+/* Keep the worst of the measured values */
+void RTA_UpdateMeasurement(RTA_Task_t *pxTask, uint32 ulExecution, uint32 ulCriticalSection, uint32 ulNonPreemptive);
+
+/* Compute the blocking terms and the worst-case response times of the whole set */
+void RTA_Analyse(RTA_Task_t *pxTasks, uint8 ucCount);
+
+#endif /* RTA_H_ */
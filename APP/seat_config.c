@@ -0,0 +1,20 @@
+/**********************************************************************************************
+ *
+ * Module: Seat Config
+ *
+ * File Name: seat_config.c
+ *
+ * Description: source file for the compile-time table of the heated seats
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "seat_config.h"
+
+#define SEAT_CONFIG_ENTRY(id, name, adc, button, heater, period, median, alpha) \
+    { (const uint8 *)name, adc, button, heater, period, median, FILTER_Q15(alpha) },
+
+const SeatConfig_t xSeatConfig[SEAT_NUM] =
+{
+    SEAT_TABLE(SEAT_CONFIG_ENTRY)
+};
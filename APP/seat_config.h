@@ -0,0 +1,53 @@
+/**********************************************************************************************
+ *
+ * Module: Seat Config
+ *
+ * File Name: seat_config.h
+ *
+ * Description: Compile-time table of the heated seats, the tasks, state arrays and event
+ *              bits of the application are generated from it
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef SEAT_CONFIG_H_
+#define SEAT_CONFIG_H_
+
+#include "std_types.h"
+#include "adc.h"
+#include "pwm.h"
+#include "filter.h"
+
+/* One X(...) entry per seat:
+ * X(Id, Name, ADC channel, Port F button pin, Heater channel, Sensor period in msec,
+ *   Median window (odd, 1 = off), IIR weight of a new sample (1.0 = off))
+ * Both LaunchPad seats share the potentiometer on AIN2 (PE1). */
+#define SEAT_TABLE(X)                                                                       \
+    X(DriverTask,    "Driver",    ADC_CHANNEL_AIN2, 0, PWM_CHANNEL_PF3, 40, 5, 0.25)       \
+    X(PassengerTask, "Passenger", ADC_CHANNEL_AIN2, 4, PWM_CHANNEL_PF2, 60, 3, 0.35)
+
+/* Button pin of a seat that has no button on this board */
+#define SEAT_NO_BUTTON      0xFF
+
+#define SEAT_COUNT_ONE(id, name, adc, button, heater, period, median, alpha) + 1
+#define SEAT_NUM            (0 SEAT_TABLE(SEAT_COUNT_ONE))
+
+/* Each seat owns one event group bit (24 usable) and one task notification bit */
+#if (SEAT_NUM > 24)
+#error "The seat table is limited to 24 seats"
+#endif
+
+typedef struct
+{
+    const uint8 *pcName;
+    uint8 ucAdcChannel;
+    uint8 ucButtonPin;
+    PWM_ChannelType xHeater;
+    uint16 usPeriodMs;
+    uint8 ucMedianLength;
+    sint16 sFilterAlpha;        /* Q15 */
+} SeatConfig_t;
+
+extern const SeatConfig_t xSeatConfig[SEAT_NUM];
+
+#endif /* SEAT_CONFIG_H_ */
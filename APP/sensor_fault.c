@@ -0,0 +1,69 @@
+/**********************************************************************************************
+ *
+ * Module: SensorFault
+ *
+ * File Name: sensor_fault.c
+ *
+ * Description: source file for the per-seat sensor fault state machine with hysteresis
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "sensor_fault.h"
+
+void SensorFault_Init(SensorFault_t *pxSensor, const SensorFault_Config_t *pxConfig)
+{
+    pxSensor->pxConfig = pxConfig;
+    pxSensor->eState = SENSOR_OK;
+    pxSensor->ucCount = 0;
+    pxSensor->ulFaults = 0;
+}
+
+SensorFault_StateType SensorFault_Update(SensorFault_t *pxSensor, uint16 usSample)
+{
+    const SensorFault_Config_t *pxConfig = pxSensor->pxConfig;
+    boolean bBad = ((usSample < pxConfig->usFaultLow) || (usSample >= pxConfig->usFaultHigh)) ? TRUE : FALSE;
+    boolean bInRecoveryBand = ((usSample >= pxConfig->usRecoverLow) && (usSample < pxConfig->usRecoverHigh)) ? TRUE : FALSE;
+
+    switch (pxSensor->eState)
+    {
+    case SENSOR_OK:
+    case SENSOR_SUSPECT:
+        if (bBad == FALSE)
+        {
+            pxSensor->eState = SENSOR_OK;
+            pxSensor->ucCount = 0;
+            break;
+        }
+        pxSensor->ucCount++;
+        pxSensor->eState = SENSOR_SUSPECT;
+        if (pxSensor->ucCount >= pxConfig->ucConfirmCount)
+        {
+            pxSensor->eState = SENSOR_FAULTED;
+            pxSensor->ucCount = 0;
+            pxSensor->ulFaults++;
+        }
+        break;
+
+    case SENSOR_FAULTED:
+    case SENSOR_RECOVERING:
+        if (bInRecoveryBand == FALSE)
+        {
+            pxSensor->eState = SENSOR_FAULTED;
+            pxSensor->ucCount = 0;
+            break;
+        }
+        pxSensor->ucCount++;
+        pxSensor->eState = SENSOR_RECOVERING;
+        if (pxSensor->ucCount >= pxConfig->ucRecoverCount)
+        {
+            pxSensor->eState = SENSOR_OK;
+            pxSensor->ucCount = 0;
+        }
+        break;
+
+    default:
+        break;
+    }
+    return pxSensor->eState;
+}
@@ -0,0 +1,56 @@
+/**********************************************************************************************
+ *
+ * Module: SensorFault
+ *
+ * File Name: sensor_fault.h
+ *
+ * Description: Header file for the per-seat sensor fault state machine with hysteresis
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef SENSOR_FAULT_H_
+#define SENSOR_FAULT_H_
+
+#include "std_types.h"
+
+/*
+ *   OK --bad--> SUSPECT --bad x ucConfirmCount--> FAULTED --in recovery band--> RECOVERING
+ *    ^             |                                 ^                              |
+ *    +----good-----+                                 +------out of recovery band----+
+ *    ^                                                                              |
+ *    +-----------------------in recovery band x ucRecoverCount----------------------+
+ */
+/* Ordered: the states from SENSOR_FAULTED on keep the heater off */
+typedef enum
+{
+    SENSOR_OK,
+    SENSOR_SUSPECT,         /* Bad samples are dropped, the last good one still holds */
+    SENSOR_FAULTED,         /* The heater must be off */
+    SENSOR_RECOVERING       /* Heater still off until the sensor proved stable */
+} SensorFault_StateType;
+
+typedef struct
+{
+    uint16 usFaultLow;      /* Samples below are bad */
+    uint16 usFaultHigh;     /* Samples at or above are bad */
+    uint16 usRecoverLow;    /* Narrower band a faulted sensor must return to */
+    uint16 usRecoverHigh;
+    uint8 ucConfirmCount;   /* Consecutive bad samples that confirm a fault */
+    uint8 ucRecoverCount;   /* Consecutive samples in the recovery band that clear it */
+} SensorFault_Config_t;
+
+typedef struct
+{
+    const SensorFault_Config_t *pxConfig;
+    SensorFault_StateType eState;
+    uint8 ucCount;
+    uint32 ulFaults;        /* Confirmed faults since init */
+} SensorFault_t;
+
+void SensorFault_Init(SensorFault_t *pxSensor, const SensorFault_Config_t *pxConfig);
+
+/* Advance the state machine by one raw sample, returns the new state */
+SensorFault_StateType SensorFault_Update(SensorFault_t *pxSensor, uint16 usSample);
+
+#endif /* SENSOR_FAULT_H_ */
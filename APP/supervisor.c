@@ -0,0 +1,46 @@
+/**********************************************************************************************
+ *
+ * Module: Supervisor
+ *
+ * File Name: supervisor.c
+ *
+ * Description: source file for the task heartbeat supervisor that gates the watchdog feed
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "supervisor.h"
+
+volatile uint32 aulSupervisorBeat[SUPERVISOR_MAX_CLIENTS];
+
+static uint32 aulMaxInterval[SUPERVISOR_MAX_CLIENTS];
+static uint8 ucLateClient = SUPERVISOR_NONE;
+
+void Supervisor_Monitor(uint8 ucId, uint32 ulMaxInterval, uint32 ulNow)
+{
+    /* Start from a fresh beat so a new client isn't late before its first job */
+    aulSupervisorBeat[ucId] = ulNow;
+    aulMaxInterval[ucId] = ulMaxInterval;
+}
+
+boolean Supervisor_Check(uint32 ulNow)
+{
+    uint8 ucId;
+
+    ucLateClient = SUPERVISOR_NONE;
+    for (ucId = 0; ucId < SUPERVISOR_MAX_CLIENTS; ucId++)
+    {
+        /* Signed difference: correct across a wrap, and a beat stored after ulNow was taken counts as alive */
+        if ((aulMaxInterval[ucId] != 0) && ((sint32)(ulNow - aulSupervisorBeat[ucId]) > (sint32)aulMaxInterval[ucId]))
+        {
+            ucLateClient = ucId;
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+uint8 Supervisor_GetLate(void)
+{
+    return ucLateClient;
+}
@@ -0,0 +1,36 @@
+/**********************************************************************************************
+ *
+ * Module: Supervisor
+ *
+ * File Name: supervisor.h
+ *
+ * Description: Header file for the task heartbeat supervisor that gates the watchdog feed
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef SUPERVISOR_H_
+#define SUPERVISOR_H_
+
+#include "std_types.h"
+
+#define SUPERVISOR_MAX_CLIENTS 16
+#define SUPERVISOR_NONE 0xFF
+
+/* Time of the last heartbeat of each client, in the caller's time base */
+extern volatile uint32 aulSupervisorBeat[SUPERVISOR_MAX_CLIENTS];
+
+/* A heartbeat is a single word store, cheap enough for every job of a task */
+#define Supervisor_Heartbeat(id, now) (aulSupervisorBeat[(id)] = (now))
+
+/* Monitor a client that must beat at least every ulMaxInterval, 0 stops monitoring it */
+void Supervisor_Monitor(uint8 ucId, uint32 ulMaxInterval, uint32 ulNow);
+
+/* TRUE if every monitored client beat in time, only then the watchdog may be fed.
+ * No hardware access, the time is passed in so the logic runs on any time base. */
+boolean Supervisor_Check(uint32 ulNow);
+
+/* First client found late by the last check, SUPERVISOR_NONE if all were alive */
+uint8 Supervisor_GetLate(void);
+
+#endif /* SUPERVISOR_H_ */
@@ -0,0 +1,122 @@
+/**********************************************************************************************
+ *
+ * Module: Trace
+ *
+ * File Name: trace.c
+ *
+ * Description: source file for the capture and replay of the sensor and button inputs
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "trace.h"
+
+static Trace_Record_t axTrace[TRACE_CAPACITY];
+static uint16 usTraceCount = 0;
+static uint32 ulTraceDropped = 0;
+
+static const Trace_Record_t *pxReplay = NULL_PTR;
+static uint16 usReplayCount = 0;
+static uint16 ausAdcCursor[TRACE_MAX_SOURCES];
+static uint16 usButtonCursor = 0;
+static uint16 usReplayPosition = 0;     /* One past the newest ADC record handed out */
+static uint16 usReplayed = 0;
+
+void Trace_Capture(Trace_EventType eType, uint8 ucSource, uint16 usValue, uint32 ulTimeStamp)
+{
+    if (usTraceCount >= TRACE_CAPACITY)
+    {
+        ulTraceDropped++;
+        return;
+    }
+    axTrace[usTraceCount].ulTimeStamp = ulTimeStamp;
+    axTrace[usTraceCount].ucType = (uint8)eType;
+    axTrace[usTraceCount].ucSource = ucSource;
+    axTrace[usTraceCount].usValue = usValue;
+    usTraceCount++;
+}
+
+uint16 Trace_GetCount(void)
+{
+    return usTraceCount;
+}
+
+uint32 Trace_GetDropped(void)
+{
+    return ulTraceDropped;
+}
+
+boolean Trace_Read(uint16 usIndex, Trace_Record_t *pxRecord)
+{
+    if (usIndex >= usTraceCount)
+    {
+        return FALSE;
+    }
+    *pxRecord = axTrace[usIndex];
+    return TRUE;
+}
+
+void Trace_StartReplay(const Trace_Record_t *pxTrace, uint16 usCount)
+{
+    uint8 ucSource;
+
+    pxReplay = pxTrace;
+    usReplayCount = usCount;
+    for (ucSource = 0; ucSource < TRACE_MAX_SOURCES; ucSource++)
+    {
+        ausAdcCursor[ucSource] = 0;
+    }
+    usButtonCursor = 0;
+    usReplayPosition = 0;
+    usReplayed = 0;
+}
+
+boolean Trace_NextAdc(uint8 ucSource, Trace_Record_t *pxRecord)
+{
+    uint16 usIndex;
+
+    if (pxReplay == NULL_PTR || ucSource >= TRACE_MAX_SOURCES)
+    {
+        return FALSE;
+    }
+    for (usIndex = ausAdcCursor[ucSource]; usIndex < usReplayCount; usIndex++)
+    {
+        if (pxReplay[usIndex].ucType == TRACE_EVENT_ADC && pxReplay[usIndex].ucSource == ucSource)
+        {
+            *pxRecord = pxReplay[usIndex];
+            ausAdcCursor[ucSource] = usIndex + 1;
+            if (usIndex + 1 > usReplayPosition)
+            {
+                usReplayPosition = usIndex + 1;
+            }
+            usReplayed++;
+            return TRUE;
+        }
+    }
+    ausAdcCursor[ucSource] = usReplayCount;
+    return FALSE;
+}
+
+boolean Trace_NextButton(Trace_Record_t *pxRecord)
+{
+    if (pxReplay == NULL_PTR)
+    {
+        return FALSE;
+    }
+    for (; usButtonCursor < usReplayPosition; usButtonCursor++)
+    {
+        if (pxReplay[usButtonCursor].ucType == TRACE_EVENT_BUTTON)
+        {
+            *pxRecord = pxReplay[usButtonCursor];
+            usButtonCursor++;
+            usReplayed++;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+uint16 Trace_GetReplayed(void)
+{
+    return usReplayed;
+}
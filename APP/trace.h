@@ -0,0 +1,63 @@
+/**********************************************************************************************
+ *
+ * Module: Trace
+ *
+ * File Name: trace.h
+ *
+ * Description: Header file for the capture and replay of the sensor and button inputs
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include "std_types.h"
+
+#define TRACE_CAPACITY 512          /* Records kept in RAM, 8 bytes each */
+#define TRACE_MAX_SOURCES 8         /* Replay cursors, one per seat */
+
+typedef enum
+{
+    TRACE_EVENT_ADC,                /* Value: oversampled ADC code of one sensor reading */
+    TRACE_EVENT_BUTTON              /* Value: debounced gesture */
+} Trace_EventType;
+
+typedef struct
+{
+    uint32 ulTimeStamp;             /* WTimer0 ticks */
+    uint8 ucType;
+    uint8 ucSource;                 /* Seat */
+    uint16 usValue;
+} Trace_Record_t;
+
+/*
+ * Capture. The callers serialize: the sensor tasks record inside the ADC critical
+ * section and the button callback runs in an interrupt that critical section masks.
+ * Records beyond TRACE_CAPACITY are counted as dropped.
+ */
+void Trace_Capture(Trace_EventType eType, uint8 ucSource, uint16 usValue, uint32 ulTimeStamp);
+uint16 Trace_GetCount(void);
+uint32 Trace_GetDropped(void);
+boolean Trace_Read(uint16 usIndex, Trace_Record_t *pxRecord);
+
+/*
+ * Replay. The ADC records of a source are handed out in order, one per reading, so the
+ * pipeline sees the captured sample sequence whatever the timing of the replay run.
+ */
+void Trace_StartReplay(const Trace_Record_t *pxTrace, uint16 usCount);
+
+/* Next ADC record of a source, FALSE when the source has none left */
+boolean Trace_NextAdc(uint8 ucSource, Trace_Record_t *pxRecord);
+
+/* Next button record captured before the newest ADC record handed out, FALSE if none is due */
+boolean Trace_NextButton(Trace_Record_t *pxRecord);
+
+/* Records handed out so far */
+uint16 Trace_GetReplayed(void);
+
+/* Trace replayed by the firmware, APP/trace_replay.c */
+extern const Trace_Record_t xTraceReplay[];
+extern const uint16 usTraceReplayCount;
+
+#endif /* TRACE_H_ */
@@ -0,0 +1,42 @@
+/**********************************************************************************************
+ *
+ * Module: Trace
+ *
+ * File Name: trace_replay.c
+ *
+ * Description: Input trace replayed when ENABLE_TRACE_REPLAY is set
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "trace.h"
+
+/* Paste the records printed by the "trace" console command of a capture run here.
+ * {time stamp (0.1 msec), type, seat, oversampled ADC code or gesture} */
+const Trace_Record_t xTraceReplay[] =
+{
+    {0, TRACE_EVENT_ADC, 0, 3640},
+    {100, TRACE_EVENT_ADC, 1, 3660},
+    {400, TRACE_EVENT_ADC, 0, 3644},
+    {700, TRACE_EVENT_ADC, 1, 3662},
+    {800, TRACE_EVENT_ADC, 0, 3648},
+    {1200, TRACE_EVENT_ADC, 0, 3652},
+    {1300, TRACE_EVENT_ADC, 1, 3664},
+    {1600, TRACE_EVENT_ADC, 0, 3656},
+    {1730, TRACE_EVENT_BUTTON, 0, 0},
+    {1900, TRACE_EVENT_ADC, 1, 3666},
+    {2000, TRACE_EVENT_ADC, 0, 3660},
+    {2400, TRACE_EVENT_ADC, 0, 3664},
+    {2500, TRACE_EVENT_ADC, 1, 3668},
+    {2800, TRACE_EVENT_ADC, 0, 3668},
+    {3100, TRACE_EVENT_ADC, 1, 3670},
+    {3200, TRACE_EVENT_ADC, 0, 3672},
+    {3600, TRACE_EVENT_ADC, 0, 3676},
+    {3700, TRACE_EVENT_ADC, 1, 3672},
+    {3950, TRACE_EVENT_BUTTON, 1, 2},
+    {4000, TRACE_EVENT_ADC, 0, 3680},
+    {4300, TRACE_EVENT_ADC, 1, 3674},
+    {4400, TRACE_EVENT_ADC, 0, 3684}
+};
+
+const uint16 usTraceReplayCount = sizeof(xTraceReplay) / sizeof(xTraceReplay[0]);
@@ -0,0 +1,110 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+SHELL = cmd.exe
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../APP/bench.c \
+../APP/console.c \
+../APP/display.c \
+../APP/filter.c \
+../APP/latency.c \
+../APP/low_power.c \
+../APP/periodic.c \
+../APP/pid.c \
+../APP/plant.c \
+../APP/rta.c \
+../APP/seat_config.c \
+../APP/sensor_fault.c \
+../APP/supervisor.c \
+../APP/trace.c \
+../APP/trace_replay.c 
+
+C_DEPS += \
+./APP/bench.d \
+./APP/console.d \
+./APP/display.d \
+./APP/filter.d \
+./APP/latency.d \
+./APP/low_power.d \
+./APP/periodic.d \
+./APP/pid.d \
+./APP/plant.d \
+./APP/rta.d \
+./APP/seat_config.d \
+./APP/sensor_fault.d \
+./APP/supervisor.d \
+./APP/trace.d \
+./APP/trace_replay.d 
+
+OBJS += \
+./APP/bench.obj \
+./APP/console.obj \
+./APP/display.obj \
+./APP/filter.obj \
+./APP/latency.obj \
+./APP/low_power.obj \
+./APP/periodic.obj \
+./APP/pid.obj \
+./APP/plant.obj \
+./APP/rta.obj \
+./APP/seat_config.obj \
+./APP/sensor_fault.obj \
+./APP/supervisor.obj \
+./APP/trace.obj \
+./APP/trace_replay.obj 
+
+OBJS__QUOTED += \
+"APP\bench.obj" \
+"APP\console.obj" \
+"APP\display.obj" \
+"APP\filter.obj" \
+"APP\latency.obj" \
+"APP\low_power.obj" \
+"APP\periodic.obj" \
+"APP\pid.obj" \
+"APP\plant.obj" \
+"APP\rta.obj" \
+"APP\seat_config.obj" \
+"APP\sensor_fault.obj" \
+"APP\supervisor.obj" \
+"APP\trace.obj" \
+"APP\trace_replay.obj" 
+
+C_DEPS__QUOTED += \
+"APP\bench.d" \
+"APP\console.d" \
+"APP\display.d" \
+"APP\filter.d" \
+"APP\latency.d" \
+"APP\low_power.d" \
+"APP\periodic.d" \
+"APP\pid.d" \
+"APP\plant.d" \
+"APP\rta.d" \
+"APP\seat_config.d" \
+"APP\sensor_fault.d" \
+"APP\supervisor.d" \
+"APP\trace.d" \
+"APP\trace_replay.d" 
+
+C_SRCS__QUOTED += \
+"../APP/bench.c" \
+"../APP/console.c" \
+"../APP/display.c" \
+"../APP/filter.c" \
+"../APP/latency.c" \
+"../APP/low_power.c" \
+"../APP/periodic.c" \
+"../APP/pid.c" \
+"../APP/plant.c" \
+"../APP/rta.c" \
+"../APP/seat_config.c" \
+"../APP/sensor_fault.c" \
+"../APP/supervisor.c" \
+"../APP/trace.c" \
+"../APP/trace_replay.c" 
+
+
@@ -6,21 +6,39 @@ SHELL = cmd.exe
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../HAL/button.c \
+../HAL/fault_log.c \
+../HAL/heater.c \
 ../HAL/potentiometer.c 
 
 C_DEPS += \
+./HAL/button.d \
+./HAL/fault_log.d \
+./HAL/heater.d \
 ./HAL/potentiometer.d 
 
 OBJS += \
+./HAL/button.obj \
+./HAL/fault_log.obj \
+./HAL/heater.obj \
 ./HAL/potentiometer.obj 
 
 OBJS__QUOTED += \
+"HAL\button.obj" \
+"HAL\fault_log.obj" \
+"HAL\heater.obj" \
 "HAL\potentiometer.obj" 
 
 C_DEPS__QUOTED += \
+"HAL\button.d" \
+"HAL\fault_log.d" \
+"HAL\heater.d" \
 "HAL\potentiometer.d" 
 
 C_SRCS__QUOTED += \
+"../HAL/button.c" \
+"../HAL/fault_log.c" \
+"../HAL/heater.c" \
 "../HAL/potentiometer.c" 
 
 
@@ -0,0 +1,26 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+SHELL = cmd.exe
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../MCAL/EEPROM/eeprom.c 
+
+C_DEPS += \
+./MCAL/EEPROM/eeprom.d 
+
+OBJS += \
+./MCAL/EEPROM/eeprom.obj 
+
+OBJS__QUOTED += \
+"MCAL\EEPROM\eeprom.obj" 
+
+C_DEPS__QUOTED += \
+"MCAL\EEPROM\eeprom.d" 
+
+C_SRCS__QUOTED += \
+"../MCAL/EEPROM/eeprom.c" 
+
+
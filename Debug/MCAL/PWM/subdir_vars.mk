@@ -0,0 +1,26 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+SHELL = cmd.exe
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../MCAL/PWM/pwm.c 
+
+C_DEPS += \
+./MCAL/PWM/pwm.d 
+
+OBJS += \
+./MCAL/PWM/pwm.obj 
+
+OBJS__QUOTED += \
+"MCAL\PWM\pwm.obj" 
+
+C_DEPS__QUOTED += \
+"MCAL\PWM\pwm.d" 
+
+C_SRCS__QUOTED += \
+"../MCAL/PWM/pwm.c" 
+
+
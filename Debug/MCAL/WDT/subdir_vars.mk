@@ -0,0 +1,26 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+SHELL = cmd.exe
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../MCAL/WDT/wdt.c 
+
+C_DEPS += \
+./MCAL/WDT/wdt.d 
+
+OBJS += \
+./MCAL/WDT/wdt.obj 
+
+OBJS__QUOTED += \
+"MCAL\WDT\wdt.obj" 
+
+C_DEPS__QUOTED += \
+"MCAL\WDT\wdt.d" 
+
+C_SRCS__QUOTED += \
+"../MCAL/WDT/wdt.c" 
+
+
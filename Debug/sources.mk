@@ -115,9 +115,13 @@ SUBDIRS := \
 FreeRTOS/Source \
 FreeRTOS/Source/portable/CCS/ARM_CM4F \
 FreeRTOS/Source/portable/MemMang \
+APP \
 HAL \
 MCAL/ADC \
+MCAL/EEPROM \
 MCAL/GPIO \
 MCAL/GPTM \
+MCAL/PWM \
 MCAL/UART \
+MCAL/WDT \
 
@@ -59,8 +59,17 @@
 /* Sets the total size of the FreeRTOS heap, in bytes, when heap_1.c, heap_2.c
  * or heap_4.c are included in the build. This value is defaulted to 4096 bytes but
  * it must be tailored to each application. Note the heap will appear in the .bss
- * section. */
-#define configTOTAL_HEAP_SIZE                 ((size_t)(4096))
+ * section. heap_1 rounds every block up to 8 bytes and never frees one:
+ *   task     : 88 byte TCB + configMINIMAL_STACK_SIZE words of stack   =  600
+ *   queue    : 72 byte header + length * item size                     =   72 + n
+ *   7 tasks of main + 1 sensor task per seat + idle + timer, 2 seats   = 6600
+ *   button and diagnostics queues, 8 x 20 bytes each                   =  464
+ *   sample and display queues per seat, 1 x 16 bytes each, 2 seats     =  352
+ *   UART mutex 72, timer command queue 72 + 10 x 16                    =  304
+ *   alignment of the heap start                                        =    8
+ * That is 7728 bytes, and ENABLE_MICRO_BENCHMARK adds two tasks, a semaphore and an
+ * event group (1296). 10KB keeps room for one more seat (776) on top of both. */
+#define configTOTAL_HEAP_SIZE                 ((size_t)(10240))
 
 
 /******************************************************************************/
@@ -134,6 +143,19 @@
  * for any set to 1. */
 #define configUSE_IDLE_HOOK                   0
 #define configUSE_TICK_HOOK                   0
+#define configUSE_MALLOC_FAILED_HOOK          1
+
+/******************************************************************************/
+/* Low power related definitions. *********************************************/
+/******************************************************************************/
+
+/* Set configUSE_TICKLESS_IDLE to 2 to stop the tick while the system is idle using
+ * the application sleep function below. It programs Timer0A to wake the CPU up
+ * and sleeps with WFI, WTimer0 keeps counting so the time stamps stay valid. */
+#define configUSE_TICKLESS_IDLE               2
+
+extern void vLowPowerSuppressTicksAndSleep( uint32_t xExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )   vLowPowerSuppressTicksAndSleep( xExpectedIdleTime )
 /******************************************************************************/
 /* ARM Cortex-M Specific Definitions. *****************************************/
 /******************************************************************************/
@@ -170,15 +192,35 @@ PRIORITY THAN THIS! (higher priorities are lower numeric values. */
 /* RTOS Runtime Measurements. *************************************************/
 /******************************************************************************/
 
-extern uint32 ullTasksOutTime[9];
-extern uint32 ullTasksInTime[9];
-extern uint32 ullTasksExecutionTime[9];
-extern uint32 ullTasksTotalTime[9];
+extern uint32 ullTasksOutTime[];
+extern uint32 ullTasksInTime[];
+extern uint32 ullTasksExecutionTime[];
+extern uint32 ullTasksTotalTime[];
+extern uint32 ullTasksMaxExecutionTime[];
+extern uint32 ullTasksJobTime[];
+extern uint32 ulTaskJobDone;
+extern uint32 ulContextSwitchCount;
+
+/* A task that blocks on anything but a mutex has finished its job, the switch out that follows
+ * closes the job. Waiting for a mutex is blocking inside the job and doesn't close it. */
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )                              \
+        do{                                                                    \
+            if((pxQueue)->uxQueueType != queueQUEUE_IS_MUTEX)                  \
+            {                                                                  \
+                ulTaskJobDone = 1;                                             \
+            }                                                                  \
+        }while(0);
+#define traceTASK_DELAY_UNTIL( xTimeToWake )                         do{ ulTaskJobDone = 1; }while(0);
+#define traceTASK_DELAY()                                            do{ ulTaskJobDone = 1; }while(0);
+#define traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait )                 do{ ulTaskJobDone = 1; }while(0);
+#define traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait )                 do{ ulTaskJobDone = 1; }while(0);
+#define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor ) do{ ulTaskJobDone = 1; }while(0);
 
 #define traceTASK_SWITCHED_IN()                                    \
         do{                                                                \
             uint32 taskInTag = (uint32)(pxCurrentTCB->pxTaskTag);          \
             ullTasksInTime[taskInTag] = GPTM_WTimer0Read();                \
+            ulContextSwitchCount++;                                        \
         }while(0);
 
 #define traceTASK_SWITCHED_OUT()                                                                  \
@@ -187,6 +229,16 @@ extern uint32 ullTasksTotalTime[9];
             ullTasksOutTime[taskOutTag] = GPTM_WTimer0Read();                                             \
             ullTasksExecutionTime[taskOutTag] = ullTasksOutTime[taskOutTag] - ullTasksInTime[taskOutTag];\
             ullTasksTotalTime[taskOutTag] += ullTasksExecutionTime[taskOutTag];\
+            ullTasksJobTime[taskOutTag] += ullTasksExecutionTime[taskOutTag];\
+            if(ulTaskJobDone != 0)\
+            {\
+                ulTaskJobDone = 0;\
+                if(ullTasksJobTime[taskOutTag] > ullTasksMaxExecutionTime[taskOutTag])\
+                {\
+                    ullTasksMaxExecutionTime[taskOutTag] = ullTasksJobTime[taskOutTag];\
+                }\
+                ullTasksJobTime[taskOutTag] = 0;\
+            }\
         }while(0);
 
 
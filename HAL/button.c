@@ -0,0 +1,175 @@
+/**********************************************************************************************
+ *
+ * HAL DRIVER: Button
+ *
+ * File Name: button.c
+ *
+ * Description: source file for the debounced push button driver with gesture detection
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "button.h"
+#include "gpio.h"
+#include "GPTM.h"
+
+#define BUTTON_MS_TO_WTIMER(ms)        ((uint32)(ms) * 10UL)                   /* WTimer0 tick is 0.1 msec */
+#define BUTTON_WTIMER_TO_CYCLES(ticks) ((uint32)(ticks) * (BUTTON_CLOCK_HZ / 10000UL))
+#define BUTTON_TIMER(button)           ((GPTM_TimerType)(button))
+
+typedef enum
+{
+    BUTTON_IDLE,
+    BUTTON_PRESSED,          /* First press, waiting for the release or the long press time */
+    BUTTON_HELD,             /* Long press reported, waiting for the release */
+    BUTTON_WAIT_SECOND,      /* Released, waiting for a second press */
+    BUTTON_PRESSED_TWICE     /* Second press, reported as double press on its release */
+} Button_StateType;
+
+typedef struct
+{
+    uint8 ucPin;
+    Button_CallbackType pfCallback;
+    Button_StateType eState;
+    boolean bSettling;       /* The timer runs the settle time and the pin is masked */
+    boolean bPressed;        /* Last confirmed level */
+    boolean bDeadline;       /* A gesture time-out is pending at ulDeadline */
+    uint32 ulDeadline;
+    uint32 ulEdgeTime;       /* First edge of the current bounce burst */
+    uint32 ulPressTime;
+} Button_Type;
+
+static Button_Type axButtons[BUTTON_NUM];
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* (Re)start the timer for the time left until the pending gesture deadline */
+static void Button_StartDeadline(uint8 ucButton, uint32 ulNow)
+{
+    sint32 lRemaining = (sint32)(axButtons[ucButton].ulDeadline - ulNow);
+    GPTM_OneShotStart(BUTTON_TIMER(ucButton), (lRemaining > 0) ? BUTTON_WTIMER_TO_CYCLES(lRemaining) : 1);
+}
+
+static void Button_ArmDeadline(uint8 ucButton, uint32 ulMs, uint32 ulNow)
+{
+    axButtons[ucButton].bDeadline = TRUE;
+    axButtons[ucButton].ulDeadline = axButtons[ucButton].ulEdgeTime + BUTTON_MS_TO_WTIMER(ulMs);
+    Button_StartDeadline(ucButton, ulNow);
+}
+
+static void Button_Report(uint8 ucButton, Button_GestureType eGesture)
+{
+    if (axButtons[ucButton].pfCallback != NULL_PTR)
+    {
+        axButtons[ucButton].pfCallback(ucButton, eGesture, axButtons[ucButton].ulPressTime);
+    }
+}
+
+/* A new level was confirmed, the gesture times are measured from its first edge */
+static void Button_Transition(uint8 ucButton, uint32 ulNow)
+{
+    Button_Type *pxButton = &axButtons[ucButton];
+
+    if (pxButton->bPressed == TRUE)
+    {
+        pxButton->eState = (pxButton->eState == BUTTON_WAIT_SECOND) ? BUTTON_PRESSED_TWICE : BUTTON_PRESSED;
+        pxButton->ulPressTime = pxButton->ulEdgeTime;
+        Button_ArmDeadline(ucButton, BUTTON_LONG_PRESS_MS, ulNow);
+    }
+    else if (pxButton->eState == BUTTON_PRESSED)
+    {
+        pxButton->eState = BUTTON_WAIT_SECOND;
+        Button_ArmDeadline(ucButton, BUTTON_DOUBLE_PRESS_MS, ulNow);
+    }
+    else
+    {
+        if (pxButton->eState == BUTTON_PRESSED_TWICE)
+        {
+            Button_Report(ucButton, BUTTON_DOUBLE_PRESS);
+        }
+        pxButton->eState = BUTTON_IDLE;
+        pxButton->bDeadline = FALSE;
+    }
+}
+
+/* Port F callback of the button pin. The pin stays masked until the settle time
+ * expired, so bounces cost no ISR time. No task is woken here. */
+static boolean Button_EdgeISR(uint8 ucButton)
+{
+    Button_Type *pxButton = &axButtons[ucButton];
+
+    GPIO_PortFInterruptMask(pxButton->ucPin);
+    if (pxButton->bSettling == FALSE)
+    {
+        pxButton->bSettling = TRUE;
+        pxButton->ulEdgeTime = GPTM_WTimer0Read();
+        GPTM_OneShotStart(BUTTON_TIMER(ucButton), BUTTON_WTIMER_TO_CYCLES(BUTTON_MS_TO_WTIMER(BUTTON_SETTLE_MS)));
+    }
+    return FALSE;
+}
+
+static void Button_TimerISR(uint8 ucButton)
+{
+    Button_Type *pxButton = &axButtons[ucButton];
+    uint32 ulNow = GPTM_WTimer0Read();
+    boolean bPressed;
+
+    if (pxButton->bSettling == TRUE)
+    {
+        /* Settle time over: listen to the pin again, then sample its level */
+        pxButton->bSettling = FALSE;
+        GPIO_PortFInterruptUnmask(pxButton->ucPin);
+        bPressed = (GPIO_PortFReadPin(pxButton->ucPin) == PRESSED) ? TRUE : FALSE;
+
+        if (bPressed != pxButton->bPressed)
+        {
+            pxButton->bPressed = bPressed;
+            Button_Transition(ucButton, ulNow);
+        }
+        else if (pxButton->bDeadline == TRUE)
+        {
+            /* Only a bounce, resume the gesture time-out it interrupted */
+            Button_StartDeadline(ucButton, ulNow);
+        }
+        return;
+    }
+
+    /* Gesture time-out */
+    pxButton->bDeadline = FALSE;
+    if (pxButton->eState == BUTTON_PRESSED || pxButton->eState == BUTTON_PRESSED_TWICE)
+    {
+        pxButton->eState = BUTTON_HELD;
+        Button_Report(ucButton, BUTTON_LONG_PRESS);
+    }
+    else if (pxButton->eState == BUTTON_WAIT_SECOND)
+    {
+        pxButton->eState = BUTTON_IDLE;
+        Button_Report(ucButton, BUTTON_SHORT_PRESS);
+    }
+}
+
+/*******************************************************************************
+ *                      Public Functions Definitions                           *
+ *******************************************************************************/
+
+boolean Button_Init(uint8 ucButton, uint8 ucPin, Button_CallbackType pfCallback)
+{
+    if (ucButton >= BUTTON_NUM)
+    {
+        return FALSE;
+    }
+
+    axButtons[ucButton].ucPin = ucPin;
+    axButtons[ucButton].pfCallback = pfCallback;
+    axButtons[ucButton].eState = BUTTON_IDLE;
+    axButtons[ucButton].bSettling = FALSE;
+    axButtons[ucButton].bPressed = FALSE;
+    axButtons[ucButton].bDeadline = FALSE;
+
+    GPTM_OneShotInit(BUTTON_TIMER(ucButton), Button_TimerISR, ucButton);
+    GPIO_PortFSetCallback(ucPin, Button_EdgeISR, ucButton);
+    GPIO_PortFBothEdgesInterruptInit(ucPin);
+    return TRUE;
+}
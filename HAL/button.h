@@ -0,0 +1,43 @@
+/**********************************************************************************************
+ *
+ * HAL DRIVER: Button
+ *
+ * File Name: button.h
+ *
+ * Description: Header file for the debounced push button driver with gesture detection
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef BUTTON_H_
+#define BUTTON_H_
+
+#include "std_types.h"
+
+/* Button n is debounced by one-shot GPTM Timer(n + 1) */
+#define BUTTON_NUM                5
+
+/* Time the pin must be stable before a level is confirmed */
+#define BUTTON_SETTLE_MS          20
+/* Holding the button at least this long is a long press */
+#define BUTTON_LONG_PRESS_MS      800
+/* A second press within this time after a release is a double press */
+#define BUTTON_DOUBLE_PRESS_MS    300
+
+#define BUTTON_CLOCK_HZ           16000000UL
+
+typedef enum
+{
+    BUTTON_SHORT_PRESS,
+    BUTTON_LONG_PRESS,
+    BUTTON_DOUBLE_PRESS
+} Button_GestureType;
+
+/* Called from the timer interrupt, ulTimeStamp is the WTimer0 time of the confirmed edge */
+typedef void (*Button_CallbackType)(uint8 ucButton, Button_GestureType eGesture, uint32 ulTimeStamp);
+
+/* Attach a Port F pin to a button, must be called after GPIO_BuiltinButtonsLedsInit.
+ * Its edges are serviced through GPIO_PortFDispatch from the Port F interrupt. */
+boolean Button_Init(uint8 ucButton, uint8 ucPin, Button_CallbackType pfCallback);
+
+#endif /* BUTTON_H_ */
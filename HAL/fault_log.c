@@ -0,0 +1,254 @@
+/**********************************************************************************************
+ *
+ * HAL DRIVER: Fault Log
+ *
+ * File Name: fault_log.c
+ *
+ * Description: source file for the persistent fault log stored in the on-chip EEPROM
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "fault_log.h"
+
+static uint16 usNextSlot = 0;       /* Slot that the next record is written to */
+static uint16 usNextSequence = 0;   /* Sequence number of the next record */
+static uint16 usRecordCount = 0;    /* Number of valid records in the ring */
+static boolean bMounted = FALSE;    /* Set by FaultLog_Init, once the EEPROM is usable */
+
+/* Where the last FaultLog_Read stopped: index of the next record and the age it is searched from */
+static uint16 usCursorIndex = 0;
+static uint16 usCursorAge = 0;
+
+// CRC-8 (polynomial 0x07) over the time stamp and the upper three bytes of word 1
+static uint8 FaultLog_Crc8(uint32 ulWord0, uint32 ulWord1)
+{
+    uint8 ucBytes[7];
+    uint8 ucCrc = 0;
+    uint8 ucByte, ucBit;
+
+    ucBytes[0] = (uint8)(ulWord0);
+    ucBytes[1] = (uint8)(ulWord0 >> 8);
+    ucBytes[2] = (uint8)(ulWord0 >> 16);
+    ucBytes[3] = (uint8)(ulWord0 >> 24);
+    ucBytes[4] = (uint8)(ulWord1 >> 8);
+    ucBytes[5] = (uint8)(ulWord1 >> 16);
+    ucBytes[6] = (uint8)(ulWord1 >> 24);
+
+    for(ucByte = 0; ucByte < 7; ucByte++)
+    {
+        ucCrc ^= ucBytes[ucByte];
+        for(ucBit = 0; ucBit < 8; ucBit++)
+        {
+            ucCrc = (ucCrc & 0x80) ? (uint8)((ucCrc << 1) ^ 0x07) : (uint8)(ucCrc << 1);
+        }
+    }
+    return ucCrc;
+}
+
+static boolean FaultLog_IsValid(uint32 ulWord0, uint32 ulWord1)
+{
+    if(ulWord1 == EEPROM_ERASED_WORD)
+    {
+        return FALSE;
+    }
+    return (FaultLog_Crc8(ulWord0, ulWord1) == (uint8)ulWord1) ? TRUE : FALSE;
+}
+
+/* Read the record written usAge appends before the newest one, FALSE if that slot
+ * doesn't hold a valid record with the expected sequence number */
+static boolean FaultLog_ReadAge(uint16 usAge, uint32 *pulWord0, uint32 *pulWord1)
+{
+    uint16 usSlot = (usNextSlot + (2 * FAULT_LOG_CAPACITY) - 1 - usAge) % FAULT_LOG_CAPACITY;
+    uint16 usSequence = (usNextSequence - 1 - usAge) & FAULT_LOG_SEQUENCE_MASK;
+
+    *pulWord0 = EEPROM_ReadWord(usSlot * FAULT_LOG_WORDS_PER_RECORD);
+    *pulWord1 = EEPROM_ReadWord(usSlot * FAULT_LOG_WORDS_PER_RECORD + 1);
+
+    if(FaultLog_IsValid(*pulWord0, *pulWord1) == FALSE)
+    {
+        return FALSE;
+    }
+    return ((uint16)(*pulWord1 >> 20) == usSequence) ? TRUE : FALSE;
+}
+
+void FaultLog_Init(void)
+{
+    uint32 ulBlock[EEPROM_WORDS_PER_BLOCK];
+    uint16 usWord;
+    uint16 usSlot = 0;
+    uint16 usSequence;
+    uint16 usNewestSequence = 0;
+    boolean bFound = FALSE;
+
+    uint16 usAge;
+    uint32 ulWord0, ulWord1;
+
+    usRecordCount = 0;
+    usNextSlot = 0;
+    usNextSequence = 0;
+    usCursorIndex = 0;
+
+    /* Read the EEPROM one block at a time and keep the record with the newest sequence number */
+    for(usWord = 0; usWord < EEPROM_TOTAL_WORDS; usWord += EEPROM_WORDS_PER_BLOCK)
+    {
+        uint8 ucIndex;
+        EEPROM_ReadWords(usWord, ulBlock, EEPROM_WORDS_PER_BLOCK);
+
+        for(ucIndex = 0; ucIndex < EEPROM_WORDS_PER_BLOCK; ucIndex += FAULT_LOG_WORDS_PER_RECORD, usSlot++)
+        {
+            if(FaultLog_IsValid(ulBlock[ucIndex], ulBlock[ucIndex + 1]) == FALSE)
+            {
+                continue;
+            }
+
+            usSequence = (uint16)(ulBlock[ucIndex + 1] >> 20);
+
+            /* Serial number comparison so the sequence can wrap around */
+            if((bFound == FALSE) ||
+               (((usSequence - usNewestSequence) & FAULT_LOG_SEQUENCE_MASK) < (FAULT_LOG_SEQUENCE_MASK / 2)))
+            {
+                bFound = TRUE;
+                usNewestSequence = usSequence;
+                usNextSlot = (usSlot + 1) % FAULT_LOG_CAPACITY;
+            }
+        }
+    }
+
+    if(bFound == TRUE)
+    {
+        usNextSequence = (usNewestSequence + 1) & FAULT_LOG_SEQUENCE_MASK;
+
+        /* Count only the records that sit where their sequence number puts them */
+        for(usAge = 0; usAge < FAULT_LOG_CAPACITY; usAge++)
+        {
+            if(FaultLog_ReadAge(usAge, &ulWord0, &ulWord1) == TRUE)
+            {
+                usRecordCount++;
+            }
+        }
+    }
+    bMounted = TRUE;
+}
+
+boolean FaultLog_IsMounted(void)
+{
+    return bMounted;
+}
+
+boolean FaultLog_Append(const FaultRecord_t *pxRecord)
+{
+    uint16 usWordAddress = usNextSlot * FAULT_LOG_WORDS_PER_RECORD;
+    uint32 ulWord0 = pxRecord->ulTimeStamp;
+    uint32 ulWord1 = ((uint32)usNextSequence << 20) | ((uint32)(pxRecord->ucCode & 0x0F) << 16);
+    uint32 ulOldWord0, ulOldWord1;
+    boolean bReplacesOldest;
+
+    if(bMounted == FALSE)
+    {
+        return FALSE;
+    }
+
+    if(pxRecord->ucCode == FAULT_DEADLINE_MISS)
+    {
+        /* Task tags use the whole byte of the seat and the level */
+        ulWord1 |= (uint32)pxRecord->ucSeat << 8;
+    }
+    else if((pxRecord->ucCode > 0x0F) || (pxRecord->ucSeat > 0x0F) || (pxRecord->ucLevel > 0x0F))
+    {
+        return FALSE;
+    }
+    else
+    {
+        ulWord1 |= ((uint32)pxRecord->ucSeat << 12) | ((uint32)pxRecord->ucLevel << 8);
+    }
+
+    ulWord1 |= FaultLog_Crc8(ulWord0, ulWord1);
+
+    /* The next slot holds the oldest record once the ring has wrapped */
+    bReplacesOldest = FaultLog_ReadAge(FAULT_LOG_CAPACITY - 1, &ulOldWord0, &ulOldWord1);
+    usCursorIndex = 0;
+
+    /* Program the time stamp first, the CRC word commits the record */
+    if((EEPROM_WriteWord(usWordAddress, ulWord0) == FALSE) ||
+       (EEPROM_WriteWord(usWordAddress + 1, ulWord1) == FALSE))
+    {
+        /* A torn write may have destroyed the oldest record */
+        if((bReplacesOldest == TRUE) &&
+           (FaultLog_ReadAge(FAULT_LOG_CAPACITY - 1, &ulOldWord0, &ulOldWord1) == FALSE))
+        {
+            usRecordCount--;
+        }
+        return FALSE;
+    }
+
+    usNextSlot = (usNextSlot + 1) % FAULT_LOG_CAPACITY;
+    usNextSequence = (usNextSequence + 1) & FAULT_LOG_SEQUENCE_MASK;
+    if(bReplacesOldest == FALSE)
+    {
+        usRecordCount++;
+    }
+    return TRUE;
+}
+
+uint16 FaultLog_GetCount(void)
+{
+    return usRecordCount;
+}
+
+boolean FaultLog_Read(uint16 usIndex, FaultRecord_t *pxRecord)
+{
+    uint16 usAge, usFound;
+    uint32 ulWord0, ulWord1;
+
+    if(usIndex >= usRecordCount)
+    {
+        return FALSE;
+    }
+
+    /* Walk from the oldest possible record towards the newest one, skipping the gaps */
+    if((usCursorIndex != 0) && (usIndex >= usCursorIndex))
+    {
+        usFound = usCursorIndex;
+        usAge = usCursorAge;
+    }
+    else
+    {
+        usFound = 0;
+        usAge = FAULT_LOG_CAPACITY;
+    }
+
+    for(;;)
+    {
+        if(usAge == 0)
+        {
+            return FALSE;
+        }
+        usAge--;
+        if(FaultLog_ReadAge(usAge, &ulWord0, &ulWord1) == FALSE)
+        {
+            continue;
+        }
+        if(usFound == usIndex)
+        {
+            break;
+        }
+        usFound++;
+    }
+    usCursorIndex = usIndex + 1;
+    usCursorAge = usAge;
+
+    pxRecord->ulTimeStamp = ulWord0;
+    pxRecord->ucCode  = (uint8)((ulWord1 >> 16) & 0x0F);
+    if(pxRecord->ucCode == FAULT_DEADLINE_MISS)
+    {
+        pxRecord->ucSeat  = (uint8)(ulWord1 >> 8);
+        pxRecord->ucLevel = 0;
+    }
+    else
+    {
+        pxRecord->ucSeat  = (uint8)((ulWord1 >> 12) & 0x0F);
+        pxRecord->ucLevel = (uint8)((ulWord1 >> 8) & 0x0F);
+    }
+    return TRUE;
+}
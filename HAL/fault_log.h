@@ -0,0 +1,75 @@
+/**********************************************************************************************
+ *
+ * HAL DRIVER: Fault Log
+ *
+ * File Name: fault_log.h
+ *
+ * Description: Header file for the persistent fault log stored in the on-chip EEPROM
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef FAULT_LOG_H_
+#define FAULT_LOG_H_
+
+#include "std_types.h"
+#include "eeprom.h"
+
+/*
+ * The log is a ring of 2-word records that covers the whole EEPROM, so every
+ * word is programmed once per pass over the ring (wear leveling):
+ *
+ *   word 0 : failure time stamp (WTimer0 ticks)
+ *   word 1 : [31:20] sequence number  [19:16] fault code
+ *            [15:12] seat             [11:8]  heating level   [7:0] CRC-8
+ *
+ * A deadline miss has no heating level, its [15:8] byte holds the tag of the
+ * late task instead. A record whose seat or level doesn't fit its field is
+ * rejected rather than stored truncated.
+ *
+ * Word 1 is written last so a record interrupted by a reset fails its CRC and
+ * is ignored when the log is mounted. Records are written to consecutive slots
+ * with consecutive sequence numbers, so a record is found by its sequence
+ * number and the gaps left by torn or corrupted records are skipped.
+ */
+#define FAULT_LOG_WORDS_PER_RECORD   2
+#define FAULT_LOG_CAPACITY           (EEPROM_TOTAL_WORDS / FAULT_LOG_WORDS_PER_RECORD)
+
+#define FAULT_LOG_SEQUENCE_MASK      0xFFF
+
+/* Fault codes stored with each record */
+typedef enum
+{
+    FAULT_SENSOR_LOW,
+    FAULT_SENSOR_HIGH,
+    FAULT_DEADLINE_MISS,    /* The seat field holds the tag of the late task, the level is OFF */
+    FAULT_SENSOR_RECOVERED  /* A faulted sensor stayed in its recovery band long enough */
+} FaultCode_t;
+
+typedef struct
+{
+    uint32 ulTimeStamp;
+    uint8 ucCode;
+    uint8 ucSeat;
+    uint8 ucLevel;
+} FaultRecord_t;
+
+/* Scan the EEPROM to locate the newest record and mount the log, must be called
+ * only after EEPROM_Init succeeded */
+void FaultLog_Init(void);
+
+/* TRUE once FaultLog_Init ran, until then the log is empty and appends fail */
+boolean FaultLog_IsMounted(void);
+
+/* Append a record after the newest one, overwriting the oldest one when the log is full.
+ * FALSE if the log isn't mounted, a field doesn't fit the record or the EEPROM write failed. */
+boolean FaultLog_Append(const FaultRecord_t *pxRecord);
+
+/* Number of valid records found at mount time plus the ones appended since */
+uint16 FaultLog_GetCount(void);
+
+/* Read a record by age, index 0 is the oldest one. Reading the indexes in
+ * ascending order resumes the scan where the previous call stopped. */
+boolean FaultLog_Read(uint16 usIndex, FaultRecord_t *pxRecord);
+
+#endif /* FAULT_LOG_H_ */
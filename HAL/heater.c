@@ -0,0 +1,48 @@
+/**********************************************************************************************
+ *
+ * HAL DRIVER: Heater
+ *
+ * File Name: heater.c
+ *
+ * Description: source file for the seat heating element driver
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "heater.h"
+#include "gpio.h"
+
+void Heater_Init(PWM_ChannelType xHeater)
+{
+#if (HEATER_USE_PWM == TRUE)
+    PWM_ChannelInit(xHeater);
+#else
+    (void)xHeater;
+#endif
+}
+
+void Heater_SetPower(PWM_ChannelType xHeater, uint8 ucPercent)
+{
+#if (HEATER_USE_PWM == TRUE)
+    PWM_SetDuty(xHeater, ucPercent);
+#else
+    (void)xHeater;
+    /* Only one set of LEDs, show the intensity of the last updated seat in one atomic write */
+    if (ucPercent == 0)
+    {
+        GPIO_LedsSetPattern(0);
+    }
+    else if (ucPercent <= 33)
+    {
+        GPIO_LedsSetPattern(GPIO_GREEN_LED);
+    }
+    else if (ucPercent <= 66)
+    {
+        GPIO_LedsSetPattern(GPIO_GREEN_LED | GPIO_BLUE_LED);
+    }
+    else
+    {
+        GPIO_LedsSetPattern(GPIO_GREEN_LED | GPIO_RED_LED);
+    }
+#endif
+}
@@ -0,0 +1,28 @@
+/**********************************************************************************************
+ *
+ * HAL DRIVER: Heater
+ *
+ * File Name: heater.h
+ *
+ * Description: Header file for the seat heating element driver
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef HEATER_H_
+#define HEATER_H_
+
+#include "std_types.h"
+#include "pwm.h"
+
+/* TRUE: heating power is modulated by the PWM channel of each seat heater.
+ * FALSE: the legacy LED pattern is used to show the heating intensity. */
+#define HEATER_USE_PWM        TRUE
+
+/* Init a heater output, must be called after GPIO_BuiltinButtonsLedsInit */
+void Heater_Init(PWM_ChannelType xHeater);
+
+/* Set the heating power of a heater in percent (0 .. 100) */
+void Heater_SetPower(PWM_ChannelType xHeater, uint8 ucPercent);
+
+#endif /* HEATER_H_ */
@@ -12,18 +12,20 @@
 #include"potentiometer.h"
 #include"adc.h"
 
-// Function to convert ADC value to temperature
-uint16 ADC_to_Temperature(void) {
+// Function to convert the ADC value of a channel to temperature, in tenths of a degree
+uint16 ADC_to_Temperature(uint8 ucChannel) {
 
-    uint16 adc_value = ADC_Read();
-    // Calculate voltage per ADC count
-    float32 voltage_per_count = (float32)REF_VOLTAGE / ADC_RANGE;
+    uint32 adc_value = ADC_ReadOversampled(ucChannel, POT_OVERSAMPLE_BITS);
 
-    // Calculate temperature change per voltage
-    float32 temp_change_per_voltage = (float32)TEMP_RANGE / REF_VOLTAGE;
+    // Scale the full range to TEMP_RANGE_TENTHS, rounded, integer only
+    return (uint16)((adc_value * TEMP_RANGE_TENTHS + (POT_FULL_SCALE / 2)) / POT_FULL_SCALE);
+}
+
+// Every oversampled conversion returning the same code sums to code << POT_OVERSAMPLE_BITS
+uint16 Temperature_to_ADC(uint16 usTenths) {
 
-    // Calculate temperature
-    uint16 temperature =  (float32)(adc_value * voltage_per_count * temp_change_per_voltage);
+    uint32 divisor = (uint32)TEMP_RANGE_TENTHS << POT_OVERSAMPLE_BITS;
+    uint32 code = ((uint32)usTenths * POT_FULL_SCALE + (divisor / 2)) / divisor;
 
-    return temperature;
+    return (uint16)((code > ADC_RANGE) ? ADC_RANGE : code);
 }
@@ -19,9 +19,17 @@
 #define REF_VOLTAGE 3.3        // Reference voltage (in volts)
 #define ADC_RANGE 4095         // ADC range
 #define TEMP_RANGE 45.0        // Temperature range (in Celsius)
+#define TEMP_RANGE_TENTHS 450  // Temperature range (in tenths of a degree)
 
-// Function to convert ADC value to temperature
-uint16 ADC_to_Temperature(void);
+// Extra bits gained by software oversampling, 4^n conversions per reading
+#define POT_OVERSAMPLE_BITS 1
+#define POT_FULL_SCALE ((((uint32)ADC_RANGE + 1) << POT_OVERSAMPLE_BITS) - 1)
+
+// Function to convert the ADC value of a channel to temperature, in tenths of a degree
+uint16 ADC_to_Temperature(uint8 ucChannel);
+
+// Inverse of ADC_to_Temperature: the single conversion code that reads back as the given temperature
+uint16 Temperature_to_ADC(uint16 usTenths);
 
 
 
@@ -14,60 +14,174 @@
 #include "tm4c123gh6pm_registers.h"
 
 #define ADC1ACTSS_REG       (*((volatile uint32 *)0x40039000))
+#define ADC1RIS_REG         (*((volatile uint32 *)0x40039004))
+#define ADC1ISC_REG         (*((volatile uint32 *)0x4003900C))
+#define ADC1PSSI_REG        (*((volatile uint32 *)0x40039028))
+#define ADC1SAC_REG         (*((volatile uint32 *)0x40039030))
 #define ADC1EMUX_REG        (*((volatile uint32 *)0x40039014))
 #define ADC1SSMUX3_REG      (*((volatile uint32 *)0x400390A0))
 #define ADC1SSCTL3_REG      (*((volatile uint32 *)0x400390A4))
 #define ADC1SSFSTAT3_REG    (*((volatile uint32 *)0x400390AC))
-#define ADC1SSFIFO3_REG     (*((volatile uint32 *)0x40039048))
+#define ADC1SSFIFO3_REG     (*((volatile uint32 *)0x400390A8))
+
+#define ADC_SSFSTAT_EMPTY   (1 << 8)
+
+static ADC_InputSourceType pfInputSource = NULL_PTR;
+static uint32 ulReadErrors = 0;
 
 void ADC_Init(void)
 {
     // Enable ADC clock
     SYSCTL_RCGCADC_REG |= 0x02;
 
-    // Enable clock for GPIO Port E
-    SYSCTL_RCGCGPIO_REG |= 0x10;
-    while(!(SYSCTL_PRGPIO_REG & 0x10));
-
-    // Enable alternative function on PE1 (ADC input pin)
-    GPIO_PORTE_AFSEL_REG |= (1 << 1);
-
-    // Disable digital I/O on PE1
-    GPIO_PORTE_DEN_REG &= ~(1 << 1);
-
-    // Enable analog function on PE1
-    GPIO_PORTE_AMSEL_REG |= (1 << 1);
-
-    // Configure PE1 as input pin
-    GPIO_PORTE_DIR_REG &= ~(1 << 1);
+    // Analog input of the default channel
+    ADC_ChannelInit(ADC_DEFAULT_CHANNEL);
 
     // Disable sample sequencer 3
     ADC1ACTSS_REG &= ~(1 << 3);
 
-    // Configure trigger event for sequencer 3 (always sample)
-    ADC1EMUX_REG |= (0xF << 12);
+    // Configure trigger event for sequencer 3 (processor, started by ADC_ReadChannel)
+    ADC1EMUX_REG &= ~(0xF << 12);
 
     // Configure input source for sequencer 3 (PE1/Ain2)
-    ADC1SSMUX3_REG = 2;
+    ADC1SSMUX3_REG = ADC_DEFAULT_CHANNEL;
 
-    // Configure sample control bits for sequencer 3
-    ADC1SSCTL3_REG |= (1 << 1);
+    // Configure sample control bits for sequencer 3 (end of sequence, raw interrupt flag)
+    ADC1SSCTL3_REG |= (1 << 1) | (1 << 2);
 
     // Enable sample sequencer 3
     ADC1ACTSS_REG |= (1 << 3);
 }
 
-uint16 ADC_Read(void)
+void ADC_ChannelInit(uint8 ucChannel)
 {
-    // Wait until the FIFO is not empty
-    while((ADC1SSFSTAT3_REG & (1 << 8))); // Check FIFO Empty flag
+    static const uint8 aucChannelPin[12] = {3, 2, 1, 0, 3, 2, 1, 0, 5, 4, 4, 5};
+    uint8 ucPin;
+
+    if (ucChannel > ADC_CHANNEL_AIN11)
+    {
+        return;
+    }
+    ucPin = aucChannelPin[ucChannel];
+
+    if (ucChannel >= ADC_CHANNEL_AIN10)
+    {
+        // Port B: enable clock, then switch the pin to its analog function
+        SYSCTL_RCGCGPIO_REG |= 0x02;
+        while(!(SYSCTL_PRGPIO_REG & 0x02));
+        GPIO_PORTB_DIR_REG &= ~(1 << ucPin);
+        GPIO_PORTB_AFSEL_REG |= (1 << ucPin);
+        GPIO_PORTB_DEN_REG &= ~(1 << ucPin);
+        GPIO_PORTB_AMSEL_REG |= (1 << ucPin);
+    }
+    else if (ucChannel >= ADC_CHANNEL_AIN4 && ucChannel <= ADC_CHANNEL_AIN7)
+    {
+        // Port D
+        SYSCTL_RCGCGPIO_REG |= 0x08;
+        while(!(SYSCTL_PRGPIO_REG & 0x08));
+        GPIO_PORTD_DIR_REG &= ~(1 << ucPin);
+        GPIO_PORTD_AFSEL_REG |= (1 << ucPin);
+        GPIO_PORTD_DEN_REG &= ~(1 << ucPin);
+        GPIO_PORTD_AMSEL_REG |= (1 << ucPin);
+    }
+    else
+    {
+        // Port E
+        SYSCTL_RCGCGPIO_REG |= 0x10;
+        while(!(SYSCTL_PRGPIO_REG & 0x10));
+        GPIO_PORTE_DIR_REG &= ~(1 << ucPin);
+        GPIO_PORTE_AFSEL_REG |= (1 << ucPin);
+        GPIO_PORTE_DEN_REG &= ~(1 << ucPin);
+        GPIO_PORTE_AMSEL_REG |= (1 << ucPin);
+    }
+}
 
-    // Read the ADC value from the FIFO
-    uint16 adcValue = (uint16)(ADC1SSFIFO3_REG & 0xFFF); // Mask off lower 12 bits
+uint16 ADC_Read(void)
+{
+    return ADC_ReadChannel(ADC_DEFAULT_CHANNEL);
+}
 
-    // Optionally, clear the FIFO
-     ADC1SSFSTAT3_REG |= (1 << 8); // Set the corresponding bit to clear FIFO
+uint16 ADC_ReadChannel(uint8 ucChannel)
+{
+    if (pfInputSource != NULL_PTR)
+    {
+        return pfInputSource(ucChannel);
+    }
+    return ADC_ConvertChannel(ucChannel);
+}
 
+uint16 ADC_ConvertChannel(uint8 ucChannel)
+{
+    uint16 adcValue;
+
+    // Drop any sample left behind, the FIFO must hold only this conversion
+    while(!(ADC1SSFSTAT3_REG & ADC_SSFSTAT_EMPTY))
+    {
+        (void)ADC1SSFIFO3_REG;
+    }
+
+    // Select the input and start one conversion
+    ADC1SSMUX3_REG = ucChannel;
+    ADC1PSSI_REG = (1 << 3);
+
+    // Wait for the end of the conversion
+    while(!(ADC1RIS_REG & (1 << 3)));
+
+    if (ADC1SSFSTAT3_REG & ADC_SSFSTAT_EMPTY)
+    {
+        // Finished without a sample: read as 0, below every sensor fault threshold
+        ulReadErrors++;
+        adcValue = 0;
+    }
+    else
+    {
+        // Read the ADC value from the FIFO
+        adcValue = (uint16)(ADC1SSFIFO3_REG & 0xFFF); // Mask off lower 12 bits
+    }
+
+    // Clear the completion flag
+    ADC1ISC_REG = (1 << 3);
 
     return adcValue;
 }
+
+uint32 ADC_GetReadErrors(void)
+{
+    return ulReadErrors;
+}
+
+void ADC_SetInputSource(ADC_InputSourceType pfSource)
+{
+    pfInputSource = pfSource;
+}
+
+void ADC_SetHardwareAveraging(uint8 ucLog2Samples)
+{
+    if (ucLog2Samples > ADC_MAX_HW_AVERAGING)
+    {
+        ucLog2Samples = ADC_MAX_HW_AVERAGING;
+    }
+
+    // The averaging circuit must not change in the middle of a conversion
+    ADC1ACTSS_REG &= ~(1 << 3);
+    ADC1SAC_REG = ucLog2Samples;
+    ADC1ACTSS_REG |= (1 << 3);
+}
+
+uint16 ADC_ReadOversampled(uint8 ucChannel, uint8 ucExtraBits)
+{
+    uint32 ulSum = 0;
+    uint16 usCount;
+
+    if (ucExtraBits > ADC_MAX_OVERSAMPLE_BITS)
+    {
+        ucExtraBits = ADC_MAX_OVERSAMPLE_BITS;
+    }
+
+    // Each extra bit costs four times the conversions, the noise dithers the lower bits
+    for (usCount = 0; usCount < (1U << (2 * ucExtraBits)); usCount++)
+    {
+        ulSum += ADC_ReadChannel(ucChannel);
+    }
+    return (uint16)(ulSum >> ucExtraBits);
+}
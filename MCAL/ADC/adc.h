@@ -14,8 +14,50 @@
 
 #include "std_types.h"
 
+// Analog input channels (AINx --> pin)
+#define ADC_CHANNEL_AIN0    0   // PE3
+#define ADC_CHANNEL_AIN1    1   // PE2
+#define ADC_CHANNEL_AIN2    2   // PE1
+#define ADC_CHANNEL_AIN3    3   // PE0
+#define ADC_CHANNEL_AIN4    4   // PD3
+#define ADC_CHANNEL_AIN5    5   // PD2
+#define ADC_CHANNEL_AIN6    6   // PD1
+#define ADC_CHANNEL_AIN7    7   // PD0
+#define ADC_CHANNEL_AIN8    8   // PE5
+#define ADC_CHANNEL_AIN9    9   // PE4
+#define ADC_CHANNEL_AIN10   10  // PB4
+#define ADC_CHANNEL_AIN11   11  // PB5
+
+#define ADC_DEFAULT_CHANNEL ADC_CHANNEL_AIN2
+
+#define ADC_RESOLUTION_BITS 12
+#define ADC_MAX_HW_AVERAGING 6      // ADCSAC: 2^6 = 64 samples averaged per conversion
+#define ADC_MAX_OVERSAMPLE_BITS 4   // 4^4 = 256 conversions for 16 bits
+
+// Replacement of the converter, returns a 12-bit code for the channel
+typedef uint16 (*ADC_InputSourceType)(uint8 ucChannel);
+
 // Function prototypes
 void ADC_Init(void);
+void ADC_ChannelInit(uint8 ucChannel);
 uint16 ADC_Read(void);
 
+// One conversion on the given channel, callers sharing the sequencer must not preempt each other
+uint16 ADC_ReadChannel(uint8 ucChannel);
+
+// Average 2^ucLog2Samples samples in hardware for every conversion (0 = off)
+void ADC_SetHardwareAveraging(uint8 ucLog2Samples);
+
+// One conversion on the pin even while an input source is set, lets a source record the real input
+uint16 ADC_ConvertChannel(uint8 ucChannel);
+
+// Conversions that completed with an empty sequencer 3 FIFO, each one read as 0
+uint32 ADC_GetReadErrors(void);
+
+// Feed every conversion from a model or a recorded trace instead of the pin, NULL_PTR restores the converter
+void ADC_SetInputSource(ADC_InputSourceType pfSource);
+
+// Oversample and decimate: 4^ucExtraBits conversions summed, result has ADC_RESOLUTION_BITS + ucExtraBits bits
+uint16 ADC_ReadOversampled(uint8 ucChannel, uint8 ucExtraBits);
+
 #endif /* ADC_H_ */
@@ -0,0 +1,90 @@
+ /******************************************************************************
+ *
+ * Module: EEPROM
+ *
+ * File Name: eeprom.c
+ *
+ * Description: Source file for the TM4C123GH6PM on-chip EEPROM driver
+ *
+ * Author: Youssef Khaled
+ *
+ *******************************************************************************/
+
+#include "eeprom.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                         Private Functions Definitions                       *
+ *******************************************************************************/
+
+static void EEPROM_WaitDone(void)
+{
+    while(EEPROM_EEDONE_REG & EEPROM_EEDONE_WORKING_MASK); /* Wait until the EEPROM is not busy */
+}
+
+static boolean EEPROM_CheckRetry(void)
+{
+    /* PRETRY or ERETRY means that the previous program/erase did not complete */
+    return ((EEPROM_EESUPP_REG & (EEPROM_EESUPP_PRETRY_MASK | EEPROM_EESUPP_ERETRY_MASK)) == 0) ? TRUE : FALSE;
+}
+
+/*******************************************************************************
+ *                         Public Functions Definitions                        *
+ *******************************************************************************/
+
+boolean EEPROM_Init(void)
+{
+    volatile uint8 ucDelay;
+
+    SYSCTL_RCGCEEPROM_REG |= 0x01;            /* Enable clock for the EEPROM module */
+    while(!(SYSCTL_PREEPROM_REG & 0x01));     /* Wait until the EEPROM module is ready for access */
+    for(ucDelay = 0; ucDelay < 6; ucDelay++); /* The datasheet requires at least 6 cycles before accessing the module */
+
+    EEPROM_WaitDone();
+    if(EEPROM_CheckRetry() == FALSE)
+    {
+        return FALSE;
+    }
+
+    /* Reset the module so that the internal copy buffers are reloaded */
+    SYSCTL_SREEPROM_REG |= 0x01;
+    for(ucDelay = 0; ucDelay < 6; ucDelay++);
+    SYSCTL_SREEPROM_REG &= ~0x01;
+    for(ucDelay = 0; ucDelay < 6; ucDelay++);
+
+    EEPROM_WaitDone();
+    return EEPROM_CheckRetry();
+}
+
+uint32 EEPROM_ReadWord(uint16 usWordAddress)
+{
+    EEPROM_EEBLOCK_REG  = usWordAddress / EEPROM_WORDS_PER_BLOCK;
+    EEPROM_EEOFFSET_REG = usWordAddress % EEPROM_WORDS_PER_BLOCK;
+    return EEPROM_EERDWR_REG;
+}
+
+void EEPROM_ReadWords(uint16 usWordAddress, uint32 *pulData, uint16 usCount)
+{
+    while(usCount > 0)
+    {
+        /* Select the block once, then let EERDWRINC step the offset inside it */
+        EEPROM_EEBLOCK_REG  = usWordAddress / EEPROM_WORDS_PER_BLOCK;
+        EEPROM_EEOFFSET_REG = usWordAddress % EEPROM_WORDS_PER_BLOCK;
+        do
+        {
+            *pulData++ = EEPROM_EERDWRINC_REG;
+            usWordAddress++;
+            usCount--;
+        }
+        while((usCount > 0) && ((usWordAddress % EEPROM_WORDS_PER_BLOCK) != 0));
+    }
+}
+
+boolean EEPROM_WriteWord(uint16 usWordAddress, uint32 ulData)
+{
+    EEPROM_EEBLOCK_REG  = usWordAddress / EEPROM_WORDS_PER_BLOCK;
+    EEPROM_EEOFFSET_REG = usWordAddress % EEPROM_WORDS_PER_BLOCK;
+    EEPROM_EERDWR_REG   = ulData;
+    EEPROM_WaitDone();
+    return ((EEPROM_EEDONE_REG & EEPROM_EEDONE_ERROR_MASK) == 0) ? TRUE : FALSE;
+}
@@ -0,0 +1,49 @@
+ /******************************************************************************
+ *
+ * Module: EEPROM
+ *
+ * File Name: eeprom.h
+ *
+ * Description: Header file for the TM4C123GH6PM on-chip EEPROM driver
+ *
+ * Author: Youssef Khaled
+ *
+ *******************************************************************************/
+
+#ifndef EEPROM_H_
+#define EEPROM_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                             Preprocessor Macros                             *
+ *******************************************************************************/
+#define EEPROM_WORDS_PER_BLOCK       16          /* Each EEPROM block is 16 x 32-bit words */
+#define EEPROM_TOTAL_BLOCKS          32          /* 2KB EEPROM = 32 blocks */
+#define EEPROM_TOTAL_WORDS           (EEPROM_WORDS_PER_BLOCK * EEPROM_TOTAL_BLOCKS)
+
+#define EEPROM_EEDONE_WORKING_MASK   0x00000001
+#define EEPROM_EESUPP_ERETRY_MASK    0x00000004
+#define EEPROM_EESUPP_PRETRY_MASK    0x00000008
+#define EEPROM_EEDONE_ERROR_MASK     0x0000003C  /* INVPL, WRBUSY, NOPERM and WKCOPY flags */
+
+#define EEPROM_ERASED_WORD           0xFFFFFFFFUL
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/* Power up the EEPROM module and recover it from any interrupted operation.
+ * Returns FALSE if the module reports an unrecoverable error. */
+extern boolean EEPROM_Init(void);
+
+/* Read a single word from the EEPROM using a linear word address (0 .. EEPROM_TOTAL_WORDS-1) */
+extern uint32 EEPROM_ReadWord(uint16 usWordAddress);
+
+/* Read consecutive words from the EEPROM, the block is selected once per 16 words */
+extern void EEPROM_ReadWords(uint16 usWordAddress, uint32 *pulData, uint16 usCount);
+
+/* Program a single word, blocks until the EEPROM controller finishes the write */
+extern boolean EEPROM_WriteWord(uint16 usWordAddress, uint32 ulData);
+
+#endif /* EEPROM_H_ */
@@ -12,6 +12,9 @@
 #include "gpio.h"
 #include "tm4c123gh6pm_registers.h"
 
+static GPIO_PinCallbackType apfPortFCallback[GPIO_PORTF_PINS];
+static uint8 aucPortFCallbackArg[GPIO_PORTF_PINS];
+
 void GPIO_BuiltinButtonsLedsInit(void)
 {
     /*
@@ -40,79 +43,141 @@ void GPIO_BuiltinButtonsLedsInit(void)
 
 void GPIO_RedLedOn(void)
 {
-    GPIO_PORTF_DATA_REG |= (1<<1);  /* Red LED ON */
+    GPIO_PORTF_DATA_BITS_REG(1<<1) = (1<<1);  /* Red LED ON */
 }
 
 void GPIO_BlueLedOn(void)
 {
-    GPIO_PORTF_DATA_REG |= (1<<2);  /* Blue LED ON */
+    GPIO_PORTF_DATA_BITS_REG(1<<2) = (1<<2);  /* Blue LED ON */
 }
 
 void GPIO_GreenLedOn(void)
 {
-    GPIO_PORTF_DATA_REG |= (1<<3);  /* Green LED ON */
+    GPIO_PORTF_DATA_BITS_REG(1<<3) = (1<<3);  /* Green LED ON */
 }
 
 void GPIO_RedLedOff(void)
 {
-    GPIO_PORTF_DATA_REG &= ~(1<<1);  /* Red LED OFF */
+    GPIO_PORTF_DATA_BITS_REG(1<<1) = 0;  /* Red LED OFF */
 }
 
 void GPIO_BlueLedOff(void)
 {
-    GPIO_PORTF_DATA_REG &= ~(1<<2);  /* Blue LED OFF */
+    GPIO_PORTF_DATA_BITS_REG(1<<2) = 0;  /* Blue LED OFF */
 }
 
 void GPIO_GreenLedOff(void)
 {
-    GPIO_PORTF_DATA_REG &= ~(1<<3);  /* Green LED OFF */
+    GPIO_PORTF_DATA_BITS_REG(1<<3) = 0;  /* Green LED OFF */
 }
 
 void GPIO_RedLedToggle(void)
 {
-    GPIO_PORTF_DATA_REG ^= (1<<1);  /* Red LED is toggled */
+    GPIO_PORTF_DATA_BITS_REG(1<<1) ^= (1<<1);  /* Red LED is toggled */
 }
 
 void GPIO_BlueLedToggle(void)
 {
-    GPIO_PORTF_DATA_REG ^= (1<<2);  /* Blue LED is toggled */
+    GPIO_PORTF_DATA_BITS_REG(1<<2) ^= (1<<2);  /* Blue LED is toggled */
 }
 
 void GPIO_GreenLedToggle(void)
 {
-    GPIO_PORTF_DATA_REG ^= (1<<3);  /* Green LED is toggled */
+    GPIO_PORTF_DATA_BITS_REG(1<<3) ^= (1<<3);  /* Green LED is toggled */
 }
 
 uint8 GPIO_SW1GetState(void)
 {
-    return ((GPIO_PORTF_DATA_REG >> 4) & 0x01);
+    return (uint8)GPIO_PORTF_DATA_BITBAND_REG(4);
 }
 
 uint8 GPIO_SW2GetState(void)
 {
-    return ((GPIO_PORTF_DATA_REG >> 0) & 0x01);
+    return (uint8)GPIO_PORTF_DATA_BITBAND_REG(0);
+}
+
+void GPIO_PortFWritePins(uint8 ucMask, uint8 ucValue)
+{
+    GPIO_PORTF_DATA_BITS_REG(ucMask) = ucValue;  /* Single store, no read-modify-write */
+}
+
+void GPIO_LedsSetPattern(uint8 ucPattern)
+{
+    GPIO_PORTF_DATA_BITS_REG(GPIO_ALL_LEDS) = ucPattern;
 }
 
 void GPIO_SW1EdgeTriggeredInterruptInit(void)
 {
-    GPIO_PORTF_IS_REG    &= ~(1<<4);      /* PF4 detect edges */
-    GPIO_PORTF_IBE_REG   &= ~(1<<4);      /* PF4 will detect a certain edge */
-    GPIO_PORTF_IEV_REG   &= ~(1<<4);      /* PF4 will detect a falling edge */
-    GPIO_PORTF_ICR_REG   |= (1<<4);       /* Clear Trigger flag for PF4 (Interrupt Flag) */
-    GPIO_PORTF_IM_REG    |= (1<<4);       /* Enable Interrupt on PF4 pin */
-    /* Set GPIO PORTF priority as 5 by set Bit number 21, 22 and 23 with value 2 */
-    NVIC_PRI7_REG = (NVIC_PRI7_REG & GPIO_PORTF_PRIORITY_MASK) | (GPIO_PORTF_INTERRUPT_PRIORITY<<GPIO_PORTF_PRIORITY_BITS_POS);
-    NVIC_EN0_REG         |= 0x40000000;   /* Enable NVIC Interrupt for GPIO PORTF by set bit number 30 in EN0 Register */
+    GPIO_PortFEdgeTriggeredInterruptInit(4);
 }
 
 void GPIO_SW2EdgeTriggeredInterruptInit(void)
 {
-    GPIO_PORTF_IS_REG    &= ~(1<<0);      /* PF0 detect edges */
-    GPIO_PORTF_IBE_REG   &= ~(1<<0);      /* PF0 will detect a certain edge */
-    GPIO_PORTF_IEV_REG   &= ~(1<<0);      /* PF0 will detect a falling edge */
-    GPIO_PORTF_ICR_REG   |= (1<<0);       /* Clear Trigger flag for PF0 (Interrupt Flag) */
-    GPIO_PORTF_IM_REG    |= (1<<0);       /* Enable Interrupt on PF0 pin */
+    GPIO_PortFEdgeTriggeredInterruptInit(0);
+}
+
+void GPIO_PortFEdgeTriggeredInterruptInit(uint8 ucPin)
+{
+    GPIO_PORTF_IS_REG    &= ~(1<<ucPin);      /* Pin detect edges */
+    GPIO_PORTF_IBE_REG   &= ~(1<<ucPin);      /* Pin will detect a certain edge */
+    GPIO_PORTF_IEV_REG   &= ~(1<<ucPin);      /* Pin will detect a falling edge */
+    GPIO_PORTF_ICR_REG   |= (1<<ucPin);       /* Clear Trigger flag for the pin (Interrupt Flag) */
+    GPIO_PORTF_IM_REG    |= (1<<ucPin);       /* Enable Interrupt on the pin */
     /* Set GPIO PORTF priority as 5 by set Bit number 21, 22 and 23 with value 2 */
     NVIC_PRI7_REG = (NVIC_PRI7_REG & GPIO_PORTF_PRIORITY_MASK) | (GPIO_PORTF_INTERRUPT_PRIORITY<<GPIO_PORTF_PRIORITY_BITS_POS);
     NVIC_EN0_REG         |= 0x40000000;   /* Enable NVIC Interrupt for GPIO PORTF by set bit number 30 in EN0 Register */
 }
+
+void GPIO_PortFBothEdgesInterruptInit(uint8 ucPin)
+{
+    GPIO_PortFEdgeTriggeredInterruptInit(ucPin);
+    GPIO_PORTF_IBE_REG   |= (1<<ucPin);       /* Pin will detect both edges */
+    GPIO_PORTF_ICR_REG    = (1<<ucPin);       /* Clear an edge caught while switching */
+}
+
+void GPIO_PortFInterruptMask(uint8 ucPin)
+{
+    GPIO_PORTF_IM_BITBAND_REG(ucPin) = 0;
+}
+
+void GPIO_PortFInterruptUnmask(uint8 ucPin)
+{
+    GPIO_PORTF_ICR_REG = (1<<ucPin);          /* ICR is write 1 to clear, other pins are not affected */
+    GPIO_PORTF_IM_BITBAND_REG(ucPin) = 1;
+}
+
+uint8 GPIO_PortFReadPin(uint8 ucPin)
+{
+    return (uint8)GPIO_PORTF_DATA_BITBAND_REG(ucPin);
+}
+
+void GPIO_PortFSetCallback(uint8 ucPin, GPIO_PinCallbackType pfCallback, uint8 ucArg)
+{
+    if (ucPin < GPIO_PORTF_PINS)
+    {
+        aucPortFCallbackArg[ucPin] = ucArg;
+        apfPortFCallback[ucPin] = pfCallback;
+    }
+}
+
+boolean GPIO_PortFDispatch(void)
+{
+    uint32 ulPending = GPIO_PORTF_MIS_REG;
+    boolean bWoken = FALSE;
+    uint8 ucPin;
+
+    /* Clear before servicing, an edge arriving during a callback is kept pending */
+    GPIO_PORTF_ICR_REG = ulPending;
+
+    for (ucPin = 0; ulPending != 0 && ucPin < GPIO_PORTF_PINS; ucPin++, ulPending >>= 1)
+    {
+        if ((ulPending & 0x01) && apfPortFCallback[ucPin] != NULL_PTR)
+        {
+            if (apfPortFCallback[ucPin](aucPortFCallbackArg[ucPin]) == TRUE)
+            {
+                bWoken = TRUE;
+            }
+        }
+    }
+    return bWoken;
+}
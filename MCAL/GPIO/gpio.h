@@ -19,9 +19,16 @@
 #define GPIO_PORTF_PRIORITY_BITS_POS  21
 #define GPIO_PORTF_INTERRUPT_PRIORITY 5
 
+#define GPIO_PORTF_PINS        5
+
 #define PRESSED                ((uint8)0x00)
 #define RELEASED               ((uint8)0x01)
 
+#define GPIO_RED_LED           (1<<1)
+#define GPIO_BLUE_LED          (1<<2)
+#define GPIO_GREEN_LED         (1<<3)
+#define GPIO_ALL_LEDS          (GPIO_RED_LED | GPIO_BLUE_LED | GPIO_GREEN_LED)
+
 void GPIO_BuiltinButtonsLedsInit(void);
 
 void GPIO_RedLedOn(void);
@@ -36,10 +43,38 @@ void GPIO_RedLedToggle(void);
 void GPIO_BlueLedToggle(void);
 void GPIO_GreenLedToggle(void);
 
+/* Drive the pins in ucMask to the matching bits of ucValue with one store to the
+ * address-masked DATA register, the other Port F pins are not touched */
+void GPIO_PortFWritePins(uint8 ucMask, uint8 ucValue);
+
+/* Show a GPIO_xxx_LED combination, the LEDs not in the pattern are turned off */
+void GPIO_LedsSetPattern(uint8 ucPattern);
+
 uint8 GPIO_SW1GetState(void);
 uint8 GPIO_SW2GetState(void);
 
 void GPIO_SW1EdgeTriggeredInterruptInit(void);
 void GPIO_SW2EdgeTriggeredInterruptInit(void);
 
+/* Falling edge interrupt on any Port F input pin */
+void GPIO_PortFEdgeTriggeredInterruptInit(uint8 ucPin);
+
+/* Interrupt on both edges of a Port F input pin */
+void GPIO_PortFBothEdgesInterruptInit(uint8 ucPin);
+
+/* Mask / unmask the interrupt of one pin, unmasking drops the edges seen while masked */
+void GPIO_PortFInterruptMask(uint8 ucPin);
+void GPIO_PortFInterruptUnmask(uint8 ucPin);
+
+uint8 GPIO_PortFReadPin(uint8 ucPin);
+
+/* Interrupt callback of a pin, runs in the Port F ISR and returns TRUE when it woke a higher priority task */
+typedef boolean (*GPIO_PinCallbackType)(uint8 ucArg);
+
+void GPIO_PortFSetCallback(uint8 ucPin, GPIO_PinCallbackType pfCallback, uint8 ucArg);
+
+/* Service every pending pin: one MIS read, one ICR write, then the callback of each pin.
+ * Returns TRUE when a callback woke a higher priority task. */
+boolean GPIO_PortFDispatch(void);
+
 #endif /* GPIO_H_ */
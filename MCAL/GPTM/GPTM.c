@@ -12,6 +12,35 @@
 #include "GPTM.h"
 #include "tm4c123gh6pm_registers.h"
 
+/* Timers 1 .. 5 share one register layout, 0x1000 apart */
+#define GPTM_TIMER_BASE(timer)          (0x40031000UL + ((uint32)(timer) * 0x1000UL))
+#define GPTM_TIMER_REG(timer, offset)   (*((volatile uint32 *)(GPTM_TIMER_BASE(timer) + (offset))))
+#define GPTM_CFG_OFFSET                 0x000
+#define GPTM_TAMR_OFFSET                0x004
+#define GPTM_CTL_OFFSET                 0x00C
+#define GPTM_IMR_OFFSET                 0x018
+#define GPTM_ICR_OFFSET                 0x024
+#define GPTM_TAILR_OFFSET               0x028
+
+/* NVIC priority bytes and enable words addressed by interrupt number */
+#define GPTM_NVIC_PRI_BYTE(irq)         (*((volatile uint8 *)(0xE000E400UL + (irq))))
+#define GPTM_NVIC_EN_REG(irq)           (*((volatile uint32 *)(0xE000E100UL + (((irq) / 32) * 4))))
+
+/* Interrupt numbers of Timer1A .. Timer5A */
+static const uint8 aucOneShotIrq[GPTM_ONESHOT_TIMERS] = {21, 23, 35, 70, 92};
+
+static GPTM_CallbackType apfOneShotCallback[GPTM_ONESHOT_TIMERS];
+static uint8 aucOneShotArg[GPTM_ONESHOT_TIMERS];
+
+static void GPTM_OneShotHandler(GPTM_TimerType eTimer)
+{
+    GPTM_TIMER_REG(eTimer, GPTM_ICR_OFFSET) = 0x01;   /* Clear the time-out flag */
+    if (apfOneShotCallback[eTimer] != NULL_PTR)
+    {
+        apfOneShotCallback[eTimer](aucOneShotArg[eTimer]);
+    }
+}
+
 void GPTM_WTimer0Init(void)
 {
     /* Configure one shot down 32bit timer with tick time = 0.1msec */
@@ -28,3 +57,97 @@ uint32 GPTM_WTimer0Read(void)
     return (uint32) (0xFFFFFFFFUL - WTIMER0_TAR_REG);
 }
 
+void GPTM_Timer0Init(void)
+{
+    /* Configure one shot down 32bit timer clocked by the system clock, used to wake up from sleep */
+    SYSCTL_RCGCTIMER_REG |= (1<<0);   /* Enable clock Timer0 in run mode */
+    while(!(SYSCTL_PRTIMER_REG & (1<<0)));
+    SYSCTL_SCGCTIMER_REG |= (1<<0);   /* Keep Timer0 clocked in sleep mode */
+    SYSCTL_SCGCWTIMER_REG |= (1<<0);  /* Keep WTimer0 counting in sleep mode so time stamps stay valid */
+    TIMER0_CTL_REG = 0;               /* Disable Timer0A */
+    TIMER0_CFG_REG = 0x00;            /* Select 32-bit configuration option */
+    TIMER0_TAMR_REG = 0x01;           /* Select one-shot down counter mode of Timer0A */
+    TIMER0_ICR_REG = 0x01;            /* Clear the time-out flag */
+    TIMER0_IMR_REG = 0x01;            /* Enable the time-out interrupt */
+    /* Set Timer0A priority and enable its NVIC interrupt */
+    NVIC_PRI4_REG = (NVIC_PRI4_REG & GPTM_TIMER0A_PRIORITY_MASK) | ((uint32)GPTM_TIMER0A_INTERRUPT_PRIORITY << GPTM_TIMER0A_PRIORITY_BITS_POS);
+    NVIC_EN0_REG |= GPTM_TIMER0A_NVIC_EN0_MASK;
+}
+
+void GPTM_Timer0StartOneShot(uint32 ulClockCycles)
+{
+    TIMER0_CTL_REG &= ~(0x01);        /* Disable Timer0A before reloading it */
+    TIMER0_TAILR_REG = ulClockCycles - 1;
+    TIMER0_ICR_REG = 0x01;
+    TIMER0_CTL_REG |= (0x01);         /* Enable Timer0A, it stops by itself at the time-out */
+}
+
+void GPTM_Timer0Stop(void)
+{
+    TIMER0_CTL_REG &= ~(0x01);
+    TIMER0_ICR_REG = 0x01;
+}
+
+void Timer0A_Handler(void)
+{
+    TIMER0_ICR_REG = 0x01;            /* The wake-up itself is all that is needed */
+}
+
+void GPTM_OneShotInit(GPTM_TimerType eTimer, GPTM_CallbackType pfCallback, uint8 ucArg)
+{
+    uint8 ucIrq = aucOneShotIrq[eTimer];
+
+    apfOneShotCallback[eTimer] = pfCallback;
+    aucOneShotArg[eTimer] = ucArg;
+
+    SYSCTL_RCGCTIMER_REG |= (1 << (eTimer + 1));     /* Enable clock of the timer in run mode */
+    while(!(SYSCTL_PRTIMER_REG & (1 << (eTimer + 1))));
+    SYSCTL_SCGCTIMER_REG |= (1 << (eTimer + 1));     /* Keep it counting in sleep mode (tickless idle) */
+    GPTM_TIMER_REG(eTimer, GPTM_CTL_OFFSET) = 0;      /* Disable TimerA */
+    GPTM_TIMER_REG(eTimer, GPTM_CFG_OFFSET) = 0x00;   /* Select 32-bit configuration option */
+    GPTM_TIMER_REG(eTimer, GPTM_TAMR_OFFSET) = 0x01;  /* Select one-shot down counter mode */
+    GPTM_TIMER_REG(eTimer, GPTM_ICR_OFFSET) = 0x01;   /* Clear the time-out flag */
+    GPTM_TIMER_REG(eTimer, GPTM_IMR_OFFSET) = 0x01;   /* Enable the time-out interrupt */
+    GPTM_NVIC_PRI_BYTE(ucIrq) = (uint8)(GPTM_ONESHOT_INTERRUPT_PRIORITY << 5);
+    GPTM_NVIC_EN_REG(ucIrq) = (1UL << (ucIrq % 32));  /* Write 1 to enable, 0 bits have no effect */
+}
+
+void GPTM_OneShotStart(GPTM_TimerType eTimer, uint32 ulClockCycles)
+{
+    GPTM_TIMER_REG(eTimer, GPTM_CTL_OFFSET) = 0;      /* Disable before reloading, this restarts a running timer */
+    GPTM_TIMER_REG(eTimer, GPTM_TAILR_OFFSET) = ulClockCycles - 1;
+    GPTM_TIMER_REG(eTimer, GPTM_ICR_OFFSET) = 0x01;
+    GPTM_TIMER_REG(eTimer, GPTM_CTL_OFFSET) = 0x01;
+}
+
+void GPTM_OneShotStop(GPTM_TimerType eTimer)
+{
+    GPTM_TIMER_REG(eTimer, GPTM_CTL_OFFSET) = 0;
+    GPTM_TIMER_REG(eTimer, GPTM_ICR_OFFSET) = 0x01;
+}
+
+void Timer1A_Handler(void)
+{
+    GPTM_OneShotHandler(GPTM_TIMER1);
+}
+
+void Timer2A_Handler(void)
+{
+    GPTM_OneShotHandler(GPTM_TIMER2);
+}
+
+void Timer3A_Handler(void)
+{
+    GPTM_OneShotHandler(GPTM_TIMER3);
+}
+
+void Timer4A_Handler(void)
+{
+    GPTM_OneShotHandler(GPTM_TIMER4);
+}
+
+void Timer5A_Handler(void)
+{
+    GPTM_OneShotHandler(GPTM_TIMER5);
+}
+
@@ -15,8 +15,39 @@
 
 #include "std_types.h"
 
+#define GPTM_TIMER0A_INTERRUPT_PRIORITY  5
+#define GPTM_TIMER0A_PRIORITY_MASK       0x1FFFFFFF
+#define GPTM_TIMER0A_PRIORITY_BITS_POS   29
+#define GPTM_TIMER0A_NVIC_EN0_MASK       (1UL << 19)   /* Timer0A is interrupt number 19 */
+
+#define GPTM_ONESHOT_INTERRUPT_PRIORITY  5
+
+/* Timers 1 .. 5 (A halves) as 32-bit one-shot timers calling back on time-out */
+typedef enum
+{
+    GPTM_TIMER1,
+    GPTM_TIMER2,
+    GPTM_TIMER3,
+    GPTM_TIMER4,
+    GPTM_TIMER5,
+    GPTM_ONESHOT_TIMERS
+} GPTM_TimerType;
+
+/* The callback runs in the timer ISR, ucArg is the value given at init */
+typedef void (*GPTM_CallbackType)(uint8 ucArg);
+
 void GPTM_WTimer0Init(void);
 uint32 GPTM_WTimer0Read(void);
 
+/* Timer0A is a 32-bit one-shot wake-up timer clocked by the system clock */
+void GPTM_Timer0Init(void);
+void GPTM_Timer0StartOneShot(uint32 ulClockCycles);
+void GPTM_Timer0Stop(void);
+
+/* System clock one-shot timers, kept clocked in sleep mode */
+void GPTM_OneShotInit(GPTM_TimerType eTimer, GPTM_CallbackType pfCallback, uint8 ucArg);
+void GPTM_OneShotStart(GPTM_TimerType eTimer, uint32 ulClockCycles);
+void GPTM_OneShotStop(GPTM_TimerType eTimer);
+
 
 #endif /* GPTM_H_ */
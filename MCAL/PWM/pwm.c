@@ -0,0 +1,105 @@
+ /******************************************************************************
+ *
+ * Module: PWM
+ *
+ * File Name: pwm.c
+ *
+ * Description: Source file for the TM4C123GH6PM PWM driver (PWM1 module on PF1, PF2 and PF3)
+ *
+ * Author: Youssef Khaled
+ *
+ *******************************************************************************/
+
+#include "pwm.h"
+#include "tm4c123gh6pm_registers.h"
+
+/* Comparator register and pin of every channel */
+static volatile uint32 * const pulPwmCompare[] =
+{
+    &PWM1_2_CMPB_REG,    /* PWM_CHANNEL_PF1 */
+    &PWM1_3_CMPA_REG,    /* PWM_CHANNEL_PF2 */
+    &PWM1_3_CMPB_REG     /* PWM_CHANNEL_PF3 */
+};
+
+/* Generator action register of every channel and its actions for a duty between 0% and 100% */
+static volatile uint32 * const pulPwmActions[] =
+{
+    &PWM1_2_GENB_REG,    /* PWM_CHANNEL_PF1 */
+    &PWM1_3_GENA_REG,    /* PWM_CHANNEL_PF2 */
+    &PWM1_3_GENB_REG     /* PWM_CHANNEL_PF3 */
+};
+
+static const uint32 ulPwmActions[] = { PWM_GENB_ACTIONS, PWM_GENA_ACTIONS, PWM_GENB_ACTIONS };
+
+static const uint8 ucPwmPin[] = { 1, 2, 3 };
+static const uint8 ucPwmOutput[] = { 5, 6, 7 };
+
+/*******************************************************************************
+ *                         Private Functions Definitions                       *
+ *******************************************************************************/
+
+static uint32 PWM_DutyToCompare(uint8 ucDutyPercent)
+{
+    /* Only for 1% .. 99%: compare = LOAD or 0 would coincide with the LOAD or zero event,
+     * which win over the comparator, so 0% and 100% use PWM_GEN_FORCE_LOW / HIGH instead */
+    return PWM_LOAD_VALUE - ((PWM_LOAD_VALUE * ucDutyPercent) / 100);
+}
+
+/*******************************************************************************
+ *                         Public Functions Definitions                        *
+ *******************************************************************************/
+
+void PWM_ChannelInit(PWM_ChannelType eChannel)
+{
+    uint8 ucPin = ucPwmPin[eChannel];
+
+    SYSCTL_RCGCPWM_REG |= 0x02;               /* Enable clock for PWM1 */
+    while(!(SYSCTL_PRPWM_REG & 0x02));        /* Wait until PWM1 is ready for access */
+
+    /* PWM clock = System clock / 64 */
+    SYSCTL_RCC_REG = (SYSCTL_RCC_REG & ~PWM_RCC_PWMDIV_MASK) | PWM_RCC_USEPWMDIV_MASK | PWM_RCC_PWMDIV_64;
+
+    GPIO_PORTF_AFSEL_REG |= (1 << ucPin);     /* Enable alternative function on the pin */
+    GPIO_PORTF_PCTL_REG  = (GPIO_PORTF_PCTL_REG & ~(0xF << (ucPin * 4))) | (PWM_PF_PCTL_VALUE << (ucPin * 4));
+
+    /* Held low from the start, the actions are written while the generator is stopped
+     * and the updates are still immediate */
+    if(eChannel == PWM_CHANNEL_PF1)
+    {
+        PWM1_2_CTL_REG  = 0;                  /* Count-down mode, immediate action updates */
+        PWM1_2_LOAD_REG = PWM_LOAD_VALUE;
+        PWM1_2_GENB_REG = PWM_GEN_FORCE_LOW;
+        PWM1_2_CTL_REG  = PWM_CTL_GEN_SYNC_MASK | PWM_CTL_ENABLE_MASK;
+    }
+    else
+    {
+        /* Generator 3 is shared by PF2 and PF3, configure it only once */
+        if(!(PWM1_3_CTL_REG & PWM_CTL_ENABLE_MASK))
+        {
+            PWM1_3_CTL_REG  = 0;
+            PWM1_3_LOAD_REG = PWM_LOAD_VALUE;
+            PWM1_3_GENA_REG = PWM_GEN_FORCE_LOW;
+            PWM1_3_GENB_REG = PWM_GEN_FORCE_LOW;
+            PWM1_3_CTL_REG  = PWM_CTL_GEN_SYNC_MASK | PWM_CTL_ENABLE_MASK;
+        }
+    }
+
+    PWM1_ENABLE_REG |= (1 << ucPwmOutput[eChannel]);
+}
+
+void PWM_SetDuty(PWM_ChannelType eChannel, uint8 ucDutyPercent)
+{
+    if(ucDutyPercent == 0)
+    {
+        *pulPwmActions[eChannel] = PWM_GEN_FORCE_LOW;
+    }
+    else if(ucDutyPercent >= 100)
+    {
+        *pulPwmActions[eChannel] = PWM_GEN_FORCE_HIGH;
+    }
+    else
+    {
+        *pulPwmCompare[eChannel] = PWM_DutyToCompare(ucDutyPercent);
+        *pulPwmActions[eChannel] = ulPwmActions[eChannel];
+    }
+}
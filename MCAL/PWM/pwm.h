@@ -0,0 +1,68 @@
+ /******************************************************************************
+ *
+ * Module: PWM
+ *
+ * File Name: pwm.h
+ *
+ * Description: Header file for the TM4C123GH6PM PWM driver (PWM1 module on PF1, PF2 and PF3)
+ *
+ * Author: Youssef Khaled
+ *
+ *******************************************************************************/
+
+#ifndef PWM_H_
+#define PWM_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                             Preprocessor Macros                             *
+ *******************************************************************************/
+#define PWM_SYSTEM_CLOCK_HZ      16000000UL
+#define PWM_CLOCK_DIVIDER        64
+#define PWM_CLOCK_HZ             (PWM_SYSTEM_CLOCK_HZ / PWM_CLOCK_DIVIDER)
+#define PWM_FREQUENCY_HZ         1000UL
+#define PWM_LOAD_VALUE           ((PWM_CLOCK_HZ / PWM_FREQUENCY_HZ) - 1)
+
+#define PWM_RCC_USEPWMDIV_MASK   0x00100000
+#define PWM_RCC_PWMDIV_MASK      0x000E0000
+#define PWM_RCC_PWMDIV_64        0x000A0000   /* PWMDIV = 0x5 --> /64 */
+
+#define PWM_CTL_ENABLE_MASK      0x00000001
+#define PWM_CTL_GEN_SYNC_MASK    0x00000280   /* GENAUPD = GENBUPD = 0x2: action changes latched at zero */
+
+/* Count-down generator actions: drive high on LOAD, drive low on the comparator match */
+#define PWM_GENA_ACTIONS         0x0000008C
+#define PWM_GENB_ACTIONS         0x0000080C
+
+/* 0% and 100% duty: the same level on zero and on LOAD, no comparator action */
+#define PWM_GEN_FORCE_LOW        0x0000000A
+#define PWM_GEN_FORCE_HIGH       0x0000000F
+
+#define PWM_PF_PCTL_VALUE        0x5          /* PMCx value that routes M1PWMn to PF1, PF2 and PF3 */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef enum
+{
+    PWM_CHANNEL_PF1,     /* M1PWM5 - Generator 2 B - Red LED   */
+    PWM_CHANNEL_PF2,     /* M1PWM6 - Generator 3 A - Blue LED  */
+    PWM_CHANNEL_PF3      /* M1PWM7 - Generator 3 B - Green LED */
+} PWM_ChannelType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/* Route the channel pin to the PWM module and start its generator with 0% duty,
+ * must be called after the Port F pins were initialized */
+extern void PWM_ChannelInit(PWM_ChannelType eChannel);
+
+/* Set the duty cycle in percent (0 .. 100). 0% and 100% hold the pin low or high
+ * through the generator actions, any other duty drives it from the comparator.
+ * The generator latches both registers when its counter reaches zero, so the
+ * output never sees a partial period. */
+extern void PWM_SetDuty(PWM_ChannelType eChannel, uint8 ucDutyPercent);
+
+#endif /* PWM_H_ */
@@ -13,6 +13,13 @@
 #include "uart0.h"
 #include "tm4c123gh6pm_registers.h"
 
+/* Receive ring: the interrupt writes the head, the reader owns the tail */
+static volatile uint8 aucRxBuffer[UART0_RX_BUFFER_SIZE];
+static volatile uint8 ucRxHead = 0;
+static volatile uint8 ucRxTail = 0;
+static volatile uint32 ulRxOverruns = 0;
+static UART0_RxCallbackType pfRxCallback = NULL_PTR;
+
 /*******************************************************************************
  *                         Private Functions Definitions                       *
  *******************************************************************************/
@@ -121,3 +128,64 @@ void UART0_SendInteger(sint64 sNumber)
         UART0_SendByte(uDigits[uCounter]);
     }
 }
+
+void UART0_RxInterruptInit(UART0_RxCallbackType pfCallback)
+{
+    pfRxCallback = pfCallback;
+
+    /* The FIFO keeps the bytes that arrive while a critical section masks the interrupt */
+    UART0_CTL_REG &= ~UART_CTL_UARTEN_MASK;
+    UART0_LCRH_REG |= UART_LCRH_FEN_MASK;
+    UART0_IFLS_REG = UART_IFLS_RX1_8;
+    UART0_ICR_REG = UART_IM_RXIM_MASK | UART_IM_RTIM_MASK;
+    UART0_IM_REG |= UART_IM_RXIM_MASK | UART_IM_RTIM_MASK;
+    UART0_CTL_REG |= UART_CTL_UARTEN_MASK;
+
+    UART0_NVIC_PRI_BYTE = (uint8)(UART0_INTERRUPT_PRIORITY << 5);
+    NVIC_EN0_REG = UART0_NVIC_EN0_MASK;
+}
+
+boolean UART0_ReadByte(uint8 *pucByte)
+{
+    if(ucRxTail == ucRxHead)
+    {
+        return FALSE;
+    }
+    *pucByte = aucRxBuffer[ucRxTail];
+    ucRxTail = (ucRxTail + 1) & (UART0_RX_BUFFER_SIZE - 1);
+    return TRUE;
+}
+
+uint32 UART0_GetRxOverruns(void)
+{
+    return ulRxOverruns;
+}
+
+void UART0_Handler(void)
+{
+    uint32 ulData;
+    uint8 ucNext;
+
+    UART0_ICR_REG = UART_IM_RXIM_MASK | UART_IM_RTIM_MASK;
+
+    /* Drain the FIFO, the data register carries the error flags of each byte */
+    while(!(UART0_FR_REG & UART_FR_RXFE_MASK))
+    {
+        ulData = UART0_DR_REG;
+        ucNext = (ucRxHead + 1) & (UART0_RX_BUFFER_SIZE - 1);
+        if((ulData & UART_DR_OE_MASK) || (ucNext == ucRxTail))
+        {
+            ulRxOverruns++;
+        }
+        if(ucNext != ucRxTail)
+        {
+            aucRxBuffer[ucRxHead] = (uint8)ulData;
+            ucRxHead = ucNext;
+        }
+    }
+
+    if(pfRxCallback != NULL_PTR)
+    {
+        pfRxCallback();
+    }
+}
@@ -29,6 +29,20 @@
 #define UART_FR_TXFE_MASK        0x00000080
 #define UART_FR_RXFE_MASK        0x00000010
 
+#define UART_LCRH_FEN_MASK       0x00000010
+#define UART_IFLS_RX1_8          0x00000000  /* RX interrupt at 2 of the 16 FIFO entries */
+#define UART_IM_RXIM_MASK        0x00000010
+#define UART_IM_RTIM_MASK        0x00000040  /* Receive time-out, fires for the bytes below the level */
+#define UART_DR_OE_MASK          0x00000800
+
+#define UART0_INTERRUPT_PRIORITY 5           /* May call the FreeRTOS FromISR API */
+#define UART0_NVIC_PRI_BYTE      (*((volatile uint8 *)0xE000E405))  /* UART0 is interrupt number 5 */
+#define UART0_NVIC_EN0_MASK      (1UL << 5)
+#define UART0_RX_BUFFER_SIZE     64          /* Power of two */
+
+#define UART0_BAUD_RATE          9600
+#define UART0_BITS_PER_FRAME     10          /* Start bit, 8 data bits and a stop bit */
+
 /*******************************************************************************
  *                            Functions Prototypes                             *
  *******************************************************************************/
@@ -39,6 +53,18 @@ extern void UART0_SendByte(uint8 data);
 
 extern uint8 UART0_ReceiveByte(void);
 
+/* Runs in the UART0 interrupt after new bytes were stored in the receive ring */
+typedef void (*UART0_RxCallbackType)(void);
+
+/* Receive by interrupt into a ring buffer instead of polling with UART0_ReceiveByte */
+extern void UART0_RxInterruptInit(UART0_RxCallbackType pfCallback);
+
+/* Non-blocking, FALSE if the receive ring is empty */
+extern boolean UART0_ReadByte(uint8 *pucByte);
+
+/* Bytes lost in the hardware FIFO or because the ring was full */
+extern uint32 UART0_GetRxOverruns(void);
+
 extern void UART0_SendString(const uint8 *pData);
 
 extern void UART0_SendInteger(sint64 sNumber);
@@ -0,0 +1,66 @@
+ /******************************************************************************
+ *
+ * Module: WDT
+ *
+ * File Name: wdt.c
+ *
+ * Description: Source file for the TM4C123GH6PM watchdog timer 0 driver
+ *
+ * Author: Youssef Khaled
+ *
+ *******************************************************************************/
+
+#include "wdt.h"
+#include "tm4c123gh6pm_registers.h"
+
+static WDT_CallbackType pfTimeoutCallback = NULL_PTR;
+
+/*******************************************************************************
+ *                         Public Functions Definitions                        *
+ *******************************************************************************/
+
+void WDT_Init(uint32 ulTimeoutCycles, WDT_CallbackType pfCallback)
+{
+    pfTimeoutCallback = pfCallback;
+
+    SYSCTL_RCGCWD_REG |= 0x01;                /* Enable clock for watchdog 0 */
+    while(!(SYSCTL_PRWD_REG & 0x01));         /* Wait until watchdog 0 is ready for access */
+    SYSCTL_SCGCWD_REG |= 0x01;                /* Keep it counting in sleep mode (tickless idle) */
+
+    WDT0_LOCK_REG = WDT_UNLOCK_KEY;
+    WDT0_LOAD_REG = ulTimeoutCycles;
+    WDT0_TEST_REG |= WDT_TEST_STALL_MASK;
+    WDT0_CTL_REG = WDT_CTL_RESEN_MASK | WDT_CTL_INTEN_MASK;  /* Starts counting, INTEN is cleared by reset only */
+    WDT0_LOCK_REG = 0;                        /* Any other value locks the registers */
+
+    WDT_NVIC_PRI_BYTE = (uint8)(WDT_INTERRUPT_PRIORITY << 5);
+    NVIC_EN0_REG = WDT_NVIC_EN0_MASK;
+}
+
+void WDT_Feed(void)
+{
+    /* Writing LOAD reloads the counter but leaves a pending time-out, unlike a write to ICR */
+    WDT0_LOCK_REG = WDT_UNLOCK_KEY;
+    WDT0_LOAD_REG = WDT0_LOAD_REG;
+    WDT0_LOCK_REG = 0;
+}
+
+boolean WDT_CausedReset(void)
+{
+    if(SYSCTL_RESC_REG & WDT_RESC_WDT0_MASK)
+    {
+        SYSCTL_RESC_REG &= ~WDT_RESC_WDT0_MASK;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+void WatchdogTimer_Handler(void)
+{
+    /* The time-out stays uncleared so the second one resets the MCU, mask it meanwhile */
+    NVIC_DIS0_REG = WDT_NVIC_EN0_MASK;
+    if(pfTimeoutCallback != NULL_PTR)
+    {
+        pfTimeoutCallback();
+    }
+}
@@ -0,0 +1,50 @@
+ /******************************************************************************
+ *
+ * Module: WDT
+ *
+ * File Name: wdt.h
+ *
+ * Description: Header file for the TM4C123GH6PM watchdog timer 0 driver
+ *
+ * Author: Youssef Khaled
+ *
+ *******************************************************************************/
+
+#ifndef WDT_H_
+#define WDT_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                             Preprocessor Macros                             *
+ *******************************************************************************/
+#define WDT_CLOCK_HZ                 16000000UL  /* WDT0 runs from the system clock */
+#define WDT_UNLOCK_KEY               0x1ACCE551
+#define WDT_CTL_INTEN_MASK           0x00000001  /* Interrupt on the first time-out */
+#define WDT_CTL_RESEN_MASK           0x00000002  /* Reset on the second time-out */
+#define WDT_TEST_STALL_MASK          0x00000100  /* Stop counting while the debugger halts the core */
+#define WDT_RESC_WDT0_MASK           0x00000008
+
+/* Above configMAX_SYSCALL_INTERRUPT_PRIORITY: a critical section can't hold off the time-out,
+ * so the callback must not use the FreeRTOS API */
+#define WDT_INTERRUPT_PRIORITY       1
+#define WDT_NVIC_PRI_BYTE            (*((volatile uint8 *)0xE000E412))  /* Watchdog is interrupt number 18 */
+#define WDT_NVIC_EN0_MASK            (1UL << 18)
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/* Runs in the watchdog interrupt after the first time-out, the reset follows one time-out later */
+typedef void (*WDT_CallbackType)(void);
+
+/* Arm watchdog 0, it can't be stopped until the next reset */
+extern void WDT_Init(uint32 ulTimeoutCycles, WDT_CallbackType pfCallback);
+
+/* Reload the counter. Once the first time-out fired the reset can't be cancelled anymore. */
+extern void WDT_Feed(void);
+
+/* TRUE if watchdog 0 caused the last reset, the cause is cleared by the read */
+extern boolean WDT_CausedReset(void);
+
+#endif /* WDT_H_ */
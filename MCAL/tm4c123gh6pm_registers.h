@@ -117,6 +117,12 @@ GPIO registers (PORTE)
 GPIO registers (PORTF)
 *****************************************************************************/
 #define GPIO_PORTF_DATA_REG       (*((volatile uint32 *)0x400253FC))
+/* Address-masked DATA access: only the pins in the mask (address bits 9:2) are read or written */
+#define GPIO_PORTF_DATA_BITS_REG(mask)  (*((volatile uint32 *)(0x40025000 + ((uint32)(mask) << 2))))
+/* Bit-band alias of one DATA bit (through the all-pins DATA address) */
+#define GPIO_PORTF_DATA_BITBAND_REG(pin) (*((volatile uint32 *)(0x42000000 + (0x000253FC * 32) + ((uint32)(pin) * 4))))
+/* Bit-band alias of one interrupt mask bit, masks a pin without touching the others */
+#define GPIO_PORTF_IM_BITBAND_REG(pin)   (*((volatile uint32 *)(0x42000000 + (0x00025410 * 32) + ((uint32)(pin) * 4))))
 #define GPIO_PORTF_DIR_REG        (*((volatile uint32 *)0x40025400))
 #define GPIO_PORTF_AFSEL_REG      (*((volatile uint32 *)0x40025420))
 #define GPIO_PORTF_PUR_REG        (*((volatile uint32 *)0x40025510))
@@ -133,6 +139,7 @@ GPIO registers (PORTF)
 #define GPIO_PORTF_IEV_REG        (*((volatile uint32 *)0x4002540C))
 #define GPIO_PORTF_IM_REG         (*((volatile uint32 *)0x40025410))
 #define GPIO_PORTF_RIS_REG        (*((volatile uint32 *)0x40025414))
+#define GPIO_PORTF_MIS_REG        (*((volatile uint32 *)0x40025418))
 #define GPIO_PORTF_ICR_REG        (*((volatile uint32 *)0x4002541C))
 
 /*****************************************************************************
@@ -191,6 +198,11 @@ NVIC Registers
 #define NVIC_DIS2_REG             (*((volatile uint32 *)0xE000E188))
 #define NVIC_DIS3_REG             (*((volatile uint32 *)0xE000E18C))
 #define NVIC_DIS4_REG             (*((volatile uint32 *)0xE000E190))
+#define NVIC_PEND0_REG            (*((volatile uint32 *)0xE000E200))
+#define NVIC_PEND1_REG            (*((volatile uint32 *)0xE000E204))
+#define NVIC_PEND2_REG            (*((volatile uint32 *)0xE000E208))
+#define NVIC_PEND3_REG            (*((volatile uint32 *)0xE000E20C))
+#define NVIC_PEND4_REG            (*((volatile uint32 *)0xE000E210))
 
 /*****************************************************************************
 System Control Block Registers
@@ -202,6 +214,13 @@ System Control Block Registers
 #define NVIC_SYSTEM_INTCTRL       (*((volatile uint32 *)0xE000ED04))
 #define NVIC_SYSTEM_CFGCTRL       (*((volatile uint32 *)0xE000ED14))
 
+/*****************************************************************************
+DWT Registers
+*****************************************************************************/
+#define CORE_DEMCR_REG            (*((volatile uint32 *)0xE000EDFC))
+#define DWT_CTRL_REG              (*((volatile uint32 *)0xE0001000))
+#define DWT_CYCCNT_REG            (*((volatile uint32 *)0xE0001004))
+
 /*****************************************************************************
 MPU Registers
 *****************************************************************************/
@@ -217,6 +236,18 @@ MPU Registers
 #define MPU_BASE3_REG             (*((volatile uint32 *)0xE000EDB4))
 #define MPU_ATTR3_REG             (*((volatile uint32 *)0xE000EDB8))
 
+/*****************************************************************************
+Watchdog Timer 0 Registers
+*****************************************************************************/
+#define WDT0_LOAD_REG             (*((volatile uint32 *)0x40000000))
+#define WDT0_VALUE_REG            (*((volatile uint32 *)0x40000004))
+#define WDT0_CTL_REG              (*((volatile uint32 *)0x40000008))
+#define WDT0_ICR_REG              (*((volatile uint32 *)0x4000000C))
+#define WDT0_RIS_REG              (*((volatile uint32 *)0x40000010))
+#define WDT0_MIS_REG              (*((volatile uint32 *)0x40000014))
+#define WDT0_TEST_REG             (*((volatile uint32 *)0x40000418))
+#define WDT0_LOCK_REG             (*((volatile uint32 *)0x40000C00))
+
 /*****************************************************************************
 System Control Registers
 *****************************************************************************/
@@ -438,6 +469,21 @@ Flash Registers
 #define FLASH_FMPPE2_REG          (*((volatile uint32 *)0x400FE408))
 #define FLASH_FMPPE3_REG          (*((volatile uint32 *)0x400FE40C))
 
+/*****************************************************************************
+Timer Registers (TIMER0)
+*****************************************************************************/
+#define TIMER0_CFG_REG            (*((volatile uint32 *)0x40030000))
+#define TIMER0_TAMR_REG           (*((volatile uint32 *)0x40030004))
+#define TIMER0_CTL_REG            (*((volatile uint32 *)0x4003000C))
+#define TIMER0_IMR_REG            (*((volatile uint32 *)0x40030018))
+#define TIMER0_RIS_REG            (*((volatile uint32 *)0x4003001C))
+#define TIMER0_MIS_REG            (*((volatile uint32 *)0x40030020))
+#define TIMER0_ICR_REG            (*((volatile uint32 *)0x40030024))
+#define TIMER0_TAILR_REG          (*((volatile uint32 *)0x40030028))
+#define TIMER0_TAPR_REG           (*((volatile uint32 *)0x40030038))
+#define TIMER0_TAR_REG            (*((volatile uint32 *)0x40030048))
+#define TIMER0_TAV_REG            (*((volatile uint32 *)0x40030050))
+
 /*****************************************************************************
 Timer Registers (WTIMER0)
 *****************************************************************************/
@@ -452,4 +498,44 @@ Timer Registers (WTIMER0)
 #define WTIMER0_TAR_REG           (*((volatile uint32 *)0x40036048))
 #define WTIMER0_TBR_REG           (*((volatile uint32 *)0x4003604C))
 
+/*****************************************************************************
+EEPROM Registers
+*****************************************************************************/
+#define EEPROM_EESIZE_REG         (*((volatile uint32 *)0x400AF000))
+#define EEPROM_EEBLOCK_REG        (*((volatile uint32 *)0x400AF004))
+#define EEPROM_EEOFFSET_REG       (*((volatile uint32 *)0x400AF008))
+#define EEPROM_EERDWR_REG         (*((volatile uint32 *)0x400AF010))
+#define EEPROM_EERDWRINC_REG      (*((volatile uint32 *)0x400AF014))
+#define EEPROM_EEDONE_REG         (*((volatile uint32 *)0x400AF018))
+#define EEPROM_EESUPP_REG         (*((volatile uint32 *)0x400AF01C))
+#define EEPROM_EEUNLOCK_REG       (*((volatile uint32 *)0x400AF020))
+#define EEPROM_EEPROT_REG         (*((volatile uint32 *)0x400AF030))
+#define EEPROM_EEINT_REG          (*((volatile uint32 *)0x400AF040))
+
+/*****************************************************************************
+PWM Registers (PWM1)
+*****************************************************************************/
+#define PWM1_CTL_REG              (*((volatile uint32 *)0x40029000))
+#define PWM1_SYNC_REG             (*((volatile uint32 *)0x40029004))
+#define PWM1_ENABLE_REG           (*((volatile uint32 *)0x40029008))
+#define PWM1_INVERT_REG           (*((volatile uint32 *)0x4002900C))
+
+/* PWM1 Generator 2 (M1PWM4 & M1PWM5) */
+#define PWM1_2_CTL_REG            (*((volatile uint32 *)0x40029100))
+#define PWM1_2_LOAD_REG           (*((volatile uint32 *)0x40029110))
+#define PWM1_2_COUNT_REG          (*((volatile uint32 *)0x40029114))
+#define PWM1_2_CMPA_REG           (*((volatile uint32 *)0x40029118))
+#define PWM1_2_CMPB_REG           (*((volatile uint32 *)0x4002911C))
+#define PWM1_2_GENA_REG           (*((volatile uint32 *)0x40029120))
+#define PWM1_2_GENB_REG           (*((volatile uint32 *)0x40029124))
+
+/* PWM1 Generator 3 (M1PWM6 & M1PWM7) */
+#define PWM1_3_CTL_REG            (*((volatile uint32 *)0x40029140))
+#define PWM1_3_LOAD_REG           (*((volatile uint32 *)0x40029150))
+#define PWM1_3_COUNT_REG          (*((volatile uint32 *)0x40029154))
+#define PWM1_3_CMPA_REG           (*((volatile uint32 *)0x40029158))
+#define PWM1_3_CMPB_REG           (*((volatile uint32 *)0x4002915C))
+#define PWM1_3_GENA_REG           (*((volatile uint32 *)0x40029160))
+#define PWM1_3_GENB_REG           (*((volatile uint32 *)0x40029164))
+
 #endif
@@ -10,36 +10,195 @@
 #include "gpio.h"
 #include "GPTM.h"
 #include "adc.h"
+#include "eeprom.h"
 #include "tm4c123gh6pm_registers.h"
 
 /* HAL includes */
 #include "potentiometer.h"
-
-
-/* Definitions for the  Event Flags bits in the event group  */
-#define mainDRIVER_INTERRUPT_BIT (1UL << 0UL)    /* Event bit 0, which is set by a SW1 Interrupt. */
-#define mainPASSENGER_INTERRUPT_BIT (1UL << 1UL) /* Event bit 1, which is set by a SW2 Interrupt. */
-
-#define mainDISABLED_INTENSITY_BIT (1UL << 0UL) /* Event bit 0 */
-#define mainLOW_INTENSITY_BIT (1UL << 1UL)      /* Event bit 0 */
-#define mainMEDIUM_INTENSITY_BIT (1UL << 2UL)   /* Event bit 1 */
-#define mainHIGH_INTENSITY_BIT (1UL << 3UL)     /* Event bit 2 */
+#include "fault_log.h"
+#include "heater.h"
+#include "button.h"
+
+/* APP includes */
+#include "pid.h"
+#include "low_power.h"
+#include "rta.h"
+#include "seat_config.h"
+#include "latency.h"
+#include "periodic.h"
+#include "supervisor.h"
+#include "wdt.h"
+#include "display.h"
+#include "console.h"
+#include "filter.h"
+#include "sensor_fault.h"
+#include "plant.h"
+#include "trace.h"
+#include "bench.h"
+
+
+/* Debounced button gestures waiting for the level setting task */
+#define mainBUTTON_QUEUE_LENGTH 8
+
+/* Task notification bit of a seat, used by the sensor --> control --> heater signalling */
+#define mainSEAT_NOTIFY_BIT(seat) (1UL << (seat))
+#define mainALL_NOTIFY_BITS 0xFFFFFFFFUL
 
 
 #define ENABLE_RUNTIME_MEASUREMENT TRUE
 #define ENABLE_DIAGONSTICS TRUE
+#define ENABLE_RESPONSE_TIME_ANALYSIS TRUE
+#define ENABLE_ISR_LATENCY_BENCHMARK TRUE
+#define ENABLE_WATCHDOG TRUE
+#define ENABLE_ADC_BENCHMARK TRUE
+#define ENABLE_MICRO_BENCHMARK FALSE
+#define ENABLE_PLANT_SIMULATION FALSE
+#define ENABLE_TRACE_CAPTURE FALSE
+#define ENABLE_TRACE_REPLAY FALSE
+
+/* Simulation: the seat sensors read a thermal model of each seat that the heater commands drive.
+ * Every msec of real time advances the model by mainPLANT_TIME_SCALE msec. */
+#define mainPLANT_TIME_SCALE 60
+
+/* Capture records every sensor reading and button gesture in RAM, the "trace" console command
+ * prints them as C initializers for APP/trace_replay.c. Replay feeds that table back in. */
+#define mainTRACE_DUMP_CHUNK 16     /* Records per console command, the UART is handed over after each */
+
+/* The simulation and the trace replace the ADC input, only one of them at a time */
+#define mainADC_INPUT_HOOKED ((ENABLE_PLANT_SIMULATION == TRUE) || (ENABLE_TRACE_CAPTURE == TRUE) || (ENABLE_TRACE_REPLAY == TRUE))
+#define mainTRACE_ENABLED ((ENABLE_TRACE_CAPTURE == TRUE) || (ENABLE_TRACE_REPLAY == TRUE))
+
+/* ADCSAC setting, every conversion averages 2^n samples in hardware. The software
+ * oversampling on top of it is POT_OVERSAMPLE_BITS in potentiometer.h. */
+#define mainADC_HW_AVERAGING 3
+#define mainADC_BENCHMARK_READS 8
+#define mainADC_NOISE_SAMPLES 64      /* Raw conversions per setting for the peak-to-peak noise */
+
+/* Micro-benchmarks run once when the scheduler starts, at the timer service task priority so above
+ * every application task. The peer task shares it, each blocking take hands the CPU to the other. */
+#define mainBENCHMARK_PRIORITY (configMAX_PRIORITIES - 1)
+#define mainBENCHMARK_RUNS 32
+#define mainBENCHMARK_UART_RUNS 4   /* Each call waits for the wire, about 1 msec per digit */
+
+/* Watchdog 0 interrupts after one time-out and resets after the second. The run time task
+ * feeds it when every periodic task beat within mainSUPERVISOR_MISSED_PERIODS of its period. */
+#define mainWATCHDOG_TIMEOUT_MS 1000
+#define mainSUPERVISOR_MISSED_PERIODS 4
+#define mainWATCHDOG_SERVICE_MS 100 /* Feed attempts while the run time task waits for the UART */
+
+/* The run time report goes out a few lines per period and no UART user holds the mutex for longer
+ * than mainUART_MAX_HOLD_BYTES: the console help or a report page of mainREPORT_LINES_PER_PERIOD lines.
+ * UART time in msec = bytes * bits per frame * 1000 / baud rate, about 400 msec at 9600 baud. */
+#define mainRUNTIME_PERIOD_MS 450
+#define mainREPORT_LINES_PER_PERIOD 3
+#define mainUART_MAX_HOLD_BYTES 384
+#define mainUART_MAX_HOLD_MS ((mainUART_MAX_HOLD_BYTES * UART0_BITS_PER_FRAME * 1000) / UART0_BAUD_RATE)
+
+/* DISPLAY_MODE_LINES scrolls the changed fields, DISPLAY_MODE_DASHBOARD redraws cells in place on a VT100 terminal */
+#define mainDISPLAY_MODE DISPLAY_MODE_LINES
+
+/* Port F is interrupt number 30, pended by software for the latency benchmark */
+#define mainPORTF_PEND_MASK (1UL << 30)
+
+/* Latency probe sources */
+#define mainLATENCY_PORTF_ENTRY 0   /* Software pend --> Port F handler entry */
+#define mainLATENCY_BUTTON 1        /* Gesture interrupt --> level applied by the level setting task */
+#define mainLATENCY_ACTUATION 2     /* Sensor sample --> heater output */
+#define mainLATENCY_FILTER 3        /* Cost of one sensor filter update */
+#define mainLATENCY_SOURCES 4
+
+#define mainDIAGONSTICS_QUEUE_LENGTH 8     /* Entries waiting for the diagnostics task */
+
+/* Set point of a heating level in tenths of a degree */
+#define mainSET_POINT(level) (200 + ((level) * 50))
+
+/* Sensor fault detection in tenths of a degree. A fault is confirmed after mainSENSOR_CONFIRM_SAMPLES
+ * bad readings in a row and cleared after mainSENSOR_RECOVER_SAMPLES readings inside the narrower
+ * recovery band, so a reading hovering on a limit does not toggle the heater. */
+#define mainSENSOR_FAULT_LOW 50
+#define mainSENSOR_FAULT_HIGH 400
+#define mainSENSOR_RECOVER_LOW 60
+#define mainSENSOR_RECOVER_HIGH 390
+#define mainSENSOR_CONFIRM_SAMPLES 3
+#define mainSENSOR_RECOVER_SAMPLES 10
+
+#define mainNUM_SEATS SEAT_NUM
+
+/* TRUE: the control task runs once per fresh sample, no faster than the minimum interval.
+ * FALSE: the control task polls every seat each mainCONTROL_PERIOD_MS. */
+#define mainCONTROL_EVENT_DRIVEN FALSE
+#define mainCONTROL_PERIOD_MS 50
+#define mainCONTROL_MIN_INTERVAL_MS 10
+
+/* Task priorities, shared by the task creation and the response time analysis */
+#define mainLEVEL_SETTING_PRIORITY 3
+#define mainCONTROL_PRIORITY 2
+#define mainTEMP_READING_PRIORITY 2
+#define mainHEATING_ELEMENT_PRIORITY 3
+#define mainDISPLAY_PRIORITY 1
+#define mainRUNTIME_PRIORITY 1
+#define mainDIAGONSTICS_PRIORITY 1
+#define mainCONSOLE_PRIORITY 1
+
+/* Task tags, index the run time measurements (tag 0 is the idle task), one sensor task per seat */
+#define mainLEVEL_SETTING_TAG 1
+#define mainCONTROL_TAG 2
+#define mainHEATING_ELEMENT_TAG 3
+#define mainDISPLAY_TAG 4
+#define mainRUNTIME_TAG 5
+#define mainDIAGONSTICS_TAG 6
+#define mainCONSOLE_TAG 7
+#define mainTEMP_READING_TAG(seat) (8 + (seat))
+#define mainNUM_TAGS (8 + mainNUM_SEATS)
+
+#if (ENABLE_WATCHDOG == TRUE) && (ENABLE_RUNTIME_MEASUREMENT == FALSE)
+#error "The run time measurements task feeds the watchdog"
+#endif
+#if ((ENABLE_PLANT_SIMULATION == TRUE) + (ENABLE_TRACE_CAPTURE == TRUE) + (ENABLE_TRACE_REPLAY == TRUE)) > 1
+#error "Only one ADC input source at a time: simulation, trace capture or trace replay"
+#endif
+#if mainTRACE_ENABLED && (mainNUM_SEATS > TRACE_MAX_SOURCES)
+#error "The trace replay keeps one cursor per seat"
+#endif
+#if (mainLATENCY_SOURCES > LATENCY_MAX_SOURCES)
+#error "Too many latency probes"
+#endif
+#if (mainNUM_SEATS > DISPLAY_MAX_SEATS)
+#error "Too many seats for the display engine"
+#endif
+#if (mainNUM_TAGS > SUPERVISOR_MAX_CLIENTS)
+#error "The supervisor clients are indexed by the task tag"
+#endif
+#if (mainWATCHDOG_TIMEOUT_MS <= (mainRUNTIME_PERIOD_MS + mainUART_MAX_HOLD_MS))
+#error "The watchdog must outlast a run time period plus the longest UART mutex hold"
+#endif
+
+/* Response time analysis: tasks are indexed by their tag - 1 */
+#define mainNUM_TASKS (mainNUM_TAGS - 1)
+#define mainCYCLES_TO_WTIMER(c) (((c) + (LATENCY_CLOCK_HZ / 10000) - 1) / (LATENCY_CLOCK_HZ / 10000))   /* Rounded up to 0.1 msec */
+
+/* Lines of the run time report in the order they go out: one per task, the system lines,
+ * one per latency probe, one per periodic task, the response time table and the simulation */
+#define mainREPORT_SYSTEM_LINES 10
+#define mainREPORT_RTA_LINES ((ENABLE_RESPONSE_TIME_ANALYSIS == TRUE) ? (mainNUM_TASKS + 1) : 0)
+#define mainREPORT_PLANT_LINES ((ENABLE_PLANT_SIMULATION == TRUE) ? (mainNUM_SEATS + 1) : 0)
+#define mainREPORT_LINES ((mainNUM_TAGS - 1) + mainREPORT_SYSTEM_LINES + mainLATENCY_SOURCES + \
+                          (mainNUM_TAGS - 1) + mainREPORT_RTA_LINES + mainREPORT_PLANT_LINES)
+#define mainBUTTON_MIN_INTERARRIVAL_MS 200  /* Assumed fastest button presses */
+#define mainDIAGONSTICS_MIN_INTERARRIVAL_MS 40  /* One failure per sample of the fastest sensor */
+#define mainCONSOLE_MIN_INTERARRIVAL_MS 100  /* Assumed fastest typed command lines */
 
-#define BUFFER_SIZE 256
+/* Level request of a button event coming from the console instead of a gesture */
+#define mainLEVEL_FROM_GESTURE 0xFF
 
 
 
 
-/* Definitions for TaskIds*/
+/* Definitions for TaskIds, one per entry of the seat table */
+#define mainSEAT_ID(id, name, adc, button, heater, period, median, alpha) id,
 typedef enum
 {
-    DriverTask,
-    PassengerTask
-
+    SEAT_TABLE(mainSEAT_ID)
 } TaskID;
 
 /* Definitions for Level of Heating */
@@ -59,24 +218,247 @@ typedef struct
     uint8 ucTaskActive;
     uint8 *pcCurrentSeat;
     uint8 *pcHeatIntensity;
+    uint8 ucHeaterDuty;
+    uint32 ulLastControlTime;
+    uint32 ulMaxControlInterval;
+    uint32 ulSampleTime;
+    TickType_t xSampleRelease;  /* Release of the sensor job of the last sample, 0 before the first one */
+    uint32 ulIntensityChanges;  /* Heater intensity steps applied, a noisy sensor makes it flip */
+    boolean bSensorValid;       /* FALSE until the first good sample and while the sensor is faulted */
 } SeatTyeInfo;
 
-SeatTyeInfo SeatInfo[2];
+SeatTyeInfo SeatInfo[mainNUM_SEATS];
+
+/* Per seat temperature controller */
+PID_Controller_t xSeatPID[mainNUM_SEATS];
+
+/* Per seat sensor filter, owned by the sensor task of the seat */
+Filter_t xSeatFilter[mainNUM_SEATS];
+
+/* Per seat sensor fault state, owned by the sensor task of the seat */
+SensorFault_t xSeatSensor[mainNUM_SEATS];
+
+const SensorFault_Config_t xSensorFaultConfig =
+{
+    mainSENSOR_FAULT_LOW,
+    mainSENSOR_FAULT_HIGH,
+    mainSENSOR_RECOVER_LOW,
+    mainSENSOR_RECOVER_HIGH,
+    mainSENSOR_CONFIRM_SAMPLES,
+    mainSENSOR_RECOVER_SAMPLES
+};
+
+const uint8 *pcSensorStateNames[] = {"ok", "suspect", "faulted", "recovering"};
+
+/* Header printed by the diagnostics task, indexed by the fault code */
+const uint8 *pcFaultNames[] =
+{
+    "Temperature Sensor Low",
+    "Temperature Sensor High",
+    "Deadline Missed",
+    "Temperature Sensor Recovered"
+};
+
+/* Seats whose sensor is faulted, the red LED is on while any bit is set */
+uint32 ulFaultedSeats = 0;
+
+#if (ENABLE_PLANT_SIMULATION == TRUE)
+/* Occupied seat in a 15 degree cabin: 120 W heater, 3 kJ/K, time constant C / (Ga + Go) = 375 sec */
+const Plant_Config_t xPlantConfig =
+{
+    120000,     /* mW at 100 % duty */
+    3000,       /* J/K */
+    5000,       /* mW/K to the cabin */
+    3000,       /* mW/K to the occupant */
+    15000,      /* Cabin, milli-degrees */
+    34000,      /* Skin, milli-degrees */
+    4           /* Sensor noise, ADC codes */
+};
+
+Plant_t xSeatPlant[mainNUM_SEATS];
+TickType_t xPlantTick[mainNUM_SEATS];   /* Real time the model of a seat was last advanced to */
+#endif
+
+#if (ENABLE_MICRO_BENCHMARK == TRUE)
+/* State of the benchmark bodies, the results are volatile so the measured work stays in */
+TaskHandle_t xBenchmarkTaskHandle;
+TaskHandle_t xBenchmarkPeerHandle;
+SemaphoreHandle_t xBenchSemaphore;
+EventGroupHandle_t xBenchEvents;
+PID_Controller_t xBenchPID;
+uint16 usBenchTemp = 0;
+volatile uint32 ulBenchResult;
+#endif
+
+#if mainADC_INPUT_HOOKED
+TaskID xAdcSeat = DriverTask;           /* Seat being converted, the seats may share an ADC channel */
+#endif
+
+#if mainTRACE_ENABLED
+/* Fingerprint of the heater decisions of each seat, a replay prints the same ones as its capture */
+uint32 aulDecisionDigest[mainNUM_SEATS];
+#endif
+#if (ENABLE_TRACE_CAPTURE == TRUE)
+uint32 ulTraceSum = 0;                  /* Conversions of the reading in progress */
+#endif
+#if (ENABLE_TRACE_REPLAY == TRUE)
+uint32 aulTraceReplaySum[mainNUM_SEATS];    /* Captured conversion sum of the seat, held at the end of the trace */
+uint32 ulTraceRemaining;
+uint8 ucTraceConversion = 0;
+#endif
+
+/* Controller gains for each heating level (OFF entry is unused), per tenth of a degree and
+ * per mainCONTROL_PERIOD_MS */
+const PID_Gains_t xHeatingGains[4] =
+{
+    /*  Kp                Ki                 Kd           */
+    { PID_Q15(0.0),   PID_KI(0.0),      PID_Q15(0.0)   },   /* OFF    */
+    { PID_Q15(0.008), PID_KI(0.0004),   PID_Q15(0.005) },   /* LOW    */
+    { PID_Q15(0.010), PID_KI(0.0005),   PID_Q15(0.005) },   /* MEDIUM */
+    { PID_Q15(0.012), PID_KI(0.0006),   PID_Q15(0.005) }    /* HIGH   */
+};
 
 typedef struct
 {
     uint32 FailureTimeStamp;
     uint8 *pcCurrentSeat;
     HeatingLevel_t xCurrentLevel;
+    uint8 ucSource;         /* Seat ID, or the task tag for a deadline miss */
+    FaultCode_t xFaultCode;
 } DiagonsticsType;
 
-DiagonsticsType Diagonstics[BUFFER_SIZE];
-uint16_t usCounter = 0;
+/* Confirmed button gesture of a seat */
+typedef struct
+{
+    TaskID xSeat;
+    Button_GestureType eGesture;
+    uint32 ulTimeStamp;
+    uint32 ulIsrCycles;         /* Latency probe start, taken in the interrupt */
+    uint8 ucSetLevel;           /* Console command: the level to apply, mainLEVEL_FROM_GESTURE for a button */
+} ButtonEvent_t;
+
+/* Messages passed between the pipeline stages, every message carries its seat */
+typedef struct
+{
+    TaskID xSeat;
+    uint16 usTemp;
+    uint32 ulTimeStamp;
+    TickType_t xRelease;    /* Ideal release of the sensor job, the time base of the PID */
+    boolean bValid;         /* FALSE while the sensor is faulted, the heater must stay off */
+} TempSample_t;
+
+typedef struct
+{
+    TaskID xSeat;
+    HeatingLevel_t xLevel;
+    uint16 usTemp;
+    uint8 ucDuty;
+    uint32 ulSampleTime;
+} HeaterCommand_t;
+
+typedef struct
+{
+    TaskID xSeat;
+    HeatingLevel_t xLevel;
+    uint16 usTemp;
+    uint8 ucDuty;
+    uint8 *pcHeatIntensity;
+} DisplayUpdate_t;
+
+uint16_t usCounter = 0;             /* Diagnostics reported */
+uint32 ulDiagonsticsLost = 0;       /* Diagnostics dropped on a full queue */
 
 
 /* The HW setup function */
 static void prvSetupHardware(void);
 
+/* Button gesture callback, runs in the debounce timer interrupt */
+static void prvButtonGesture(uint8 ucButton, Button_GestureType eGesture, uint32 ulTimeStamp);
+
+/* Print the percentiles of one latency probe, the UART mutex must be held */
+static void prvSendLatency(uint8 ucSource);
+
+/* Cost of a temperature reading for every hardware averaging setting, printed before the scheduler starts */
+static void prvAdcThroughput(void);
+
+/* Print the deadline statistics of a periodic task, FALSE if it has no jobs yet. The UART mutex must be held. */
+static boolean prvSendDeadlines(uint8 ucTag);
+
+/* Print line usLine of the run time report, FALSE if it has nothing to say. The UART mutex must be held. */
+static boolean prvSendReportLine(uint16 usLine, uint32 ulBusyTicks, uint8 ucCPU_Load);
+
+/* Give the UART mutex to a waiting task between two lines and take it back */
+static void prvUartHandOver(void);
+
+/* Feed the watchdog if every supervised task is beating */
+static void prvWatchdogService(void);
+
+/* Release the UART mutex taken by task ucTag, its hold time feeds the response time analysis */
+static void prvUartGive(uint8 ucTag);
+
+/* Interrupts-disabled section of the calling task, the exit keeps the longest one per task tag */
+static uint32 prvCriticalEnter(void);
+static void prvCriticalExit(uint32 ulStart);
+
+/* Queue one entry for the diagnostics task without blocking, from any task but not from an interrupt */
+static void prvRaiseDiagnostic(uint32 ulTimeStamp, uint8 *pcName, HeatingLevel_t xLevel, uint8 ucSource, FaultCode_t xCode);
+
+#if (ENABLE_PLANT_SIMULATION == TRUE)
+/* Bring the model of a seat up to the current time, must be called inside a critical section */
+static void prvPlantAdvance(TaskID xSeat);
+
+/* ADC input source of the simulation, runs in the sensor task of xAdcSeat */
+static uint16 prvPlantAdcInput(uint8 ucChannel);
+
+/* Print line ucLine of the simulated step responses: the totals, then one per seat. The UART mutex must be held. */
+static void prvSendPlant(uint8 ucLine, uint32 ulBusyTicks);
+#endif
+
+#if (ENABLE_TRACE_CAPTURE == TRUE)
+/* ADC input source of the capture, converts on the pin and sums the conversions of a reading */
+static uint16 prvTraceCaptureInput(uint8 ucChannel);
+#endif
+#if (ENABLE_TRACE_REPLAY == TRUE)
+/* ADC input source of the replay, runs in the sensor task of xAdcSeat */
+static uint16 prvTraceReplayInput(uint8 ucChannel);
+/* Post the captured gestures due by the last reading to the level task, from the sensor task */
+static void prvTraceReplayGestures(void);
+#endif
+#if mainTRACE_ENABLED
+static void prvCommandTrace(uint8 ucArgc, uint8 *apcArgv[]);
+#endif
+
+#if (ENABLE_MICRO_BENCHMARK == TRUE)
+/* Benchmark bodies, one call is one measured run */
+static void prvBenchAdc(void);
+static void prvBenchUartInteger(void);
+static void prvBenchControl(void);
+static void prvBenchEventGroup(void);
+static void prvBenchSemaphore(void);
+static void prvBenchContextSwitch(void);
+
+/* Print one result line, the UART mutex must be held */
+static void prvSendBench(const Bench_Result_t *pxResult);
+
+void vBenchmarkTask(void *pvParameters);
+void vBenchmarkPeerTask(void *pvParameters);
+#endif
+
+/* Deadline miss hook of the periodic tasks, runs in the late task */
+static void prvDeadlineMiss(Periodic_Task_t *pxTask, TickType_t xLateness);
+
+/* Watchdog time-out callback, runs in the watchdog interrupt */
+static void prvWatchdogTimeout(void);
+
+/* UART0 receive callback, runs in the UART0 interrupt */
+static void prvConsoleReceived(void);
+
+/* Console command handlers, run in the console task with the UART mutex held */
+static void prvCommandLevel(uint8 ucArgc, uint8 *apcArgv[]);
+static void prvCommandGet(uint8 ucArgc, uint8 *apcArgv[]);
+static void prvCommandStats(uint8 ucArgc, uint8 *apcArgv[]);
+static void prvCommandMode(uint8 ucArgc, uint8 *apcArgv[]);
+
 /* FreeRTOS tasks */
 void vLevelSettingTempTask(void *pvParameters);
 void vTempReadingTask(void *pvParameters);
@@ -85,94 +467,217 @@ void vHeatingElementTask(void *pvParameters);
 void vDisplaytask(void *pvParameters);
 void vRunTimeMeasurementsTask(void *pvParameters);
 void vDiagonsticsTask(void *pvParameters);
+void vConsoleTask(void *pvParameters);
+
+
+/* Task RunTimeMeasurements, indexed by the task tag */
+uint32 ullTasksOutTime[mainNUM_TAGS];
+uint32 ullTasksInTime[mainNUM_TAGS];
+uint32 ullTasksExecutionTime[mainNUM_TAGS];
+uint32 ullTasksTotalTime[mainNUM_TAGS];
+uint32 ullTasksMaxExecutionTime[mainNUM_TAGS];
+uint32 ullResourceLockimeIn[mainNUM_TAGS]={0};
+uint32 ullResourceLockimeOut[mainNUM_TAGS]={0};
+uint32 ullResourceLockMax[mainNUM_TAGS]={0};        /* Longest single hold of the UART mutex */
+
+/* Per job execution time, the trace hooks close a job when its task blocks on anything but a mutex */
+uint32 ullTasksJobTime[mainNUM_TAGS];
+uint32 ulTaskJobDone = 0;
 
+/* Longest interrupts-disabled section of every task, in CPU cycles */
+uint32 aulCriticalSectionCycles[mainNUM_TAGS];
 
-/* Task RunTimeMeasurements */
-uint32 ullTasksOutTime[9];
-uint32 ullTasksInTime[9];
-uint32 ullTasksExecutionTime[9];
-uint32 ullTasksTotalTime[9];
-uint32 ullResourceLockimeIn[5]={0};
-uint32 ullResourceLockimeOut[5]={0};
+/* Release, response and deadline statistics of the periodic tasks, indexed by the task tag */
+Periodic_Task_t xPeriodic[mainNUM_TAGS];
+
+#define mainSEAT_TASK_NAME(id, name, adc, button, heater, period, median, alpha) name "TempReadingTask",
+const uint8 *pcTaskNames[mainNUM_TAGS] =
+{
+    "Idle",
+    "LevelSettingTempTask",
+    "ControlTask",
+    "HeatingElementTask",
+    "Displaytask",
+    "RunTimeMeasurementsTask",
+    "DiagnosticsTask",
+    "ConsoleTask",
+    SEAT_TABLE(mainSEAT_TASK_NAME)
+};
 
 /* Used to hold the handle of tasks */
 TaskHandle_t xLevelSettingTempTaskHandle;
 TaskHandle_t xControlTaskHandle;
-TaskHandle_t xDriverTempReadingTaskHandle;
-TaskHandle_t xPassengerTempReadingTaskHandle;
+TaskHandle_t xTempReadingTaskHandle[mainNUM_SEATS];
 TaskHandle_t xHeatingElementTaskHandle;
 TaskHandle_t xDisplaytaskHandle;
 TaskHandle_t xRunTimeMeasurementsTaskHandle;
 TaskHandle_t xDiagnosticsTaskHandle;
+TaskHandle_t xConsoleTaskHandle = NULL;
+
+/* Console commands, an unknown command prints the usage lines */
+const Console_CommandType xConsoleCommands[] =
+{
+    {"level", "level <seat> <0-3>  set the heating level of a seat", prvCommandLevel},
+    {"get",   "get                 state of every seat", prvCommandGet},
+    {"stats", "stats               latency and deadline statistics", prvCommandStats},
+    {"mode",  "mode <lines|dash>   telemetry display mode", prvCommandMode},
+#if mainTRACE_ENABLED
+    {"trace", "trace [first]       captured records, decision digests", prvCommandTrace},
+#endif
+};
 
 
 
-/* EventGroup Handle */
-EventGroupHandle_t xButtonEvent;
-EventGroupHandle_t xHeatingEvent;
+/* Queue of the debounced button gestures */
+QueueHandle_t xButtonQueue;
 
-/* CountingSemaphore Handle */
-SemaphoreHandle_t xTempToControlTaskSync;
-SemaphoreHandle_t xDisplayToTempTaskSync;
-SemaphoreHandle_t xTempToDiagonsticsTaskSync;
+/* Queue of the diagnostics entries, any task may raise one */
+QueueHandle_t xDiagonsticsQueue;
 
 /* Mutex Handle*/
 SemaphoreHandle_t xMutex;
 
-/*Share Resource*/
-TaskID xCurrentTaskID;
+/* Queue Handles: sample --> control decision --> heater command --> display update */
+QueueHandle_t xSampleQueue[mainNUM_SEATS];      /* Mailbox per seat, holds the newest sample */
+QueueHandle_t xDisplayQueue[mainNUM_SEATS];     /* Mailbox per seat, holds the newest applied state */
+
+/* Heater command slot per seat, written by the control task before it notifies the heater task */
+HeaterCommand_t xHeaterCommand[mainNUM_SEATS];
+
+/* Signalling statistics reported by the run time measurements task */
+uint32 ulContextSwitchCount = 0;
+uint32 ulControlPassCount = 0;
+
+/* Sample to actuation latency (WTimer0 ticks), counted once per sample */
+uint32 ulActuationLatencyMax = 0;
+uint32 ulActuationLatencyTotal = 0;
+uint32 ulActuationCount = 0;
+uint32 ulStaleDecisionCount = 0;
+
+/* Set by the first watchdog time-out, the heaters stay off until the reset */
+volatile boolean bHeatersInhibited = FALSE;
+
+/* Port F ISR timing in CPU cycles: software pend time stamp, and the longest handler run */
+volatile uint32 ulPortFPendCycle = 0;
+uint32 ulPortFIsrCyclesMax = 0;
+
+const uint8 *pcLatencyNames[mainLATENCY_SOURCES] =
+{
+    "Port F ISR entry",
+    "Button to level",
+    "Sample to heater",
+    "Sensor filter"
+};
+
+#if(ENABLE_RESPONSE_TIME_ANALYSIS == TRUE)
+/* Task set, times in WTimer0 ticks (0.1 msec). Sporadic tasks use their minimum inter-arrival time:
+ * the heater task is released once per control pass and the diagnostics once per sensor sample */
+#define mainSEAT_RTA_TASK(id, name, adc, button, heater, period, median, alpha) {name "Temp", (period) * 10, mainTEMP_READING_PRIORITY, 0},
+RTA_Task_t xTaskSet[mainNUM_TASKS] =
+{
+    {"LevelSetting", mainBUTTON_MIN_INTERARRIVAL_MS * 10, mainLEVEL_SETTING_PRIORITY, 0},
+    {"Control", ((mainCONTROL_EVENT_DRIVEN == TRUE) ? mainCONTROL_MIN_INTERVAL_MS : mainCONTROL_PERIOD_MS) * 10, mainCONTROL_PRIORITY, 0},
+    {"HeatingElement", ((mainCONTROL_EVENT_DRIVEN == TRUE) ? mainCONTROL_MIN_INTERVAL_MS : mainCONTROL_PERIOD_MS) * 10, mainHEATING_ELEMENT_PRIORITY, 0},
+    {"Display", 80 * 10, mainDISPLAY_PRIORITY, RTA_RESOURCE_UART_MUTEX},
+    {"RunTime", mainRUNTIME_PERIOD_MS * 10, mainRUNTIME_PRIORITY, RTA_RESOURCE_UART_MUTEX},
+    {"Diagnostics", mainDIAGONSTICS_MIN_INTERARRIVAL_MS * 10, mainDIAGONSTICS_PRIORITY, RTA_RESOURCE_UART_MUTEX},
+    {"Console", mainCONSOLE_MIN_INTERARRIVAL_MS * 10, mainCONSOLE_PRIORITY, RTA_RESOURCE_UART_MUTEX},
+    SEAT_TABLE(mainSEAT_RTA_TASK)
+};
+#endif
 
 int main()
 {
+    TaskID xSeat;
+#if (ENABLE_WATCHDOG == TRUE) && (mainCONTROL_EVENT_DRIVEN == TRUE)
+    uint16 usSlowestSensorMs = 0;
+#endif
 
     /* Setup the hardware for use with the Tiva C board. */
     prvSetupHardware();
 
-    /* Create EventGroup */
-    xButtonEvent = xEventGroupCreate();
-    xHeatingEvent = xEventGroupCreate();
+    /* Create the button gesture queue */
+    xButtonQueue = xQueueCreate(mainBUTTON_QUEUE_LENGTH, sizeof(ButtonEvent_t));
 
-    /* Create Semaphores */
-    xTempToControlTaskSync = xSemaphoreCreateBinary();
-    xDisplayToTempTaskSync = xSemaphoreCreateCounting(1, 1);
-    xTempToDiagonsticsTaskSync = xSemaphoreCreateBinary();
+    /* Create the diagnostics queue */
+    xDiagonsticsQueue = xQueueCreate(mainDIAGONSTICS_QUEUE_LENGTH, sizeof(DiagonsticsType));
 
 
     /* Create Mutex */
     xMutex = xSemaphoreCreateMutex();
 
+    /* Create Queues */
+    for (xSeat = DriverTask; xSeat < mainNUM_SEATS; xSeat++)
+    {
+        xSampleQueue[xSeat] = xQueueCreate(1, sizeof(TempSample_t));
+        xDisplayQueue[xSeat] = xQueueCreate(1, sizeof(DisplayUpdate_t));
+        PID_Init(&xSeatPID[xSeat], &xHeatingGains[OFF]);
+        Filter_Init(&xSeatFilter[xSeat], xSeatConfig[xSeat].ucMedianLength, xSeatConfig[xSeat].sFilterAlpha);
+    }
+
     /* Create Tasks here */
     xTaskCreate(vLevelSettingTempTask,
                 "Driver Seat Buttons",
                 configMINIMAL_STACK_SIZE,
                 NULL,
-                3,
+                mainLEVEL_SETTING_PRIORITY,
                 &xLevelSettingTempTaskHandle);
 
-    xTaskCreate(vControlTask, "Control Task", configMINIMAL_STACK_SIZE, NULL, 2, &xControlTaskHandle);
+    xTaskCreate(vControlTask, "Control Task", configMINIMAL_STACK_SIZE, NULL, mainCONTROL_PRIORITY, &xControlTaskHandle);
 
-    xTaskCreate(vTempReadingTask, "Driver Seat Temp Sensor", configMINIMAL_STACK_SIZE, (void *)DriverTask, 2, &xDriverTempReadingTaskHandle);
-    xTaskCreate(vTempReadingTask, "Passenger Seat Temp Sensor", configMINIMAL_STACK_SIZE, (void *)PassengerTask, 2, &xPassengerTempReadingTaskHandle);
+    for (xSeat = DriverTask; xSeat < mainNUM_SEATS; xSeat++)
+    {
+        xTaskCreate(vTempReadingTask, (const char *)xSeatConfig[xSeat].pcName, configMINIMAL_STACK_SIZE, (void *)xSeat, mainTEMP_READING_PRIORITY, &xTempReadingTaskHandle[xSeat]);
+        vTaskSetApplicationTaskTag( xTempReadingTaskHandle[xSeat], ( void * ) ( uint32 ) mainTEMP_READING_TAG(xSeat) );
+    }
 
-    xTaskCreate(vHeatingElementTask, "Heating Element Task", configMINIMAL_STACK_SIZE, NULL, 3, &xHeatingElementTaskHandle);
+    xTaskCreate(vHeatingElementTask, "Heating Element Task", configMINIMAL_STACK_SIZE, NULL, mainHEATING_ELEMENT_PRIORITY, &xHeatingElementTaskHandle);
 
-    xTaskCreate(vDisplaytask, "Display Task", configMINIMAL_STACK_SIZE, NULL, 1, &xDisplaytaskHandle);
+    xTaskCreate(vDisplaytask, "Display Task", configMINIMAL_STACK_SIZE, NULL, mainDISPLAY_PRIORITY, &xDisplaytaskHandle);
 
 #if(ENABLE_RUNTIME_MEASUREMENT == TRUE)
-    xTaskCreate(vRunTimeMeasurementsTask, "Run time",configMINIMAL_STACK_SIZE, NULL, 1, &xRunTimeMeasurementsTaskHandle);
+    xTaskCreate(vRunTimeMeasurementsTask, "Run time",configMINIMAL_STACK_SIZE, NULL, mainRUNTIME_PRIORITY, &xRunTimeMeasurementsTaskHandle);
+#endif
+
+    xTaskCreate(vDiagonsticsTask, "Diagnostics Task", configMINIMAL_STACK_SIZE, NULL, mainDIAGONSTICS_PRIORITY, &xDiagnosticsTaskHandle);
+
+    xTaskCreate(vConsoleTask, "Console Task", configMINIMAL_STACK_SIZE, NULL, mainCONSOLE_PRIORITY, &xConsoleTaskHandle);
+
+#if (ENABLE_MICRO_BENCHMARK == TRUE)
+    xTaskCreate(vBenchmarkTask, "Benchmark", configMINIMAL_STACK_SIZE, NULL, mainBENCHMARK_PRIORITY, &xBenchmarkTaskHandle);
 #endif
 
-    xTaskCreate(vDiagonsticsTask, "Diagnostics Task", configMINIMAL_STACK_SIZE, NULL, 1, &xDiagnosticsTaskHandle);
 
+    vTaskSetApplicationTaskTag( xLevelSettingTempTaskHandle, ( void * ) mainLEVEL_SETTING_TAG );
+    vTaskSetApplicationTaskTag( xControlTaskHandle, ( void * ) mainCONTROL_TAG );
+    vTaskSetApplicationTaskTag( xHeatingElementTaskHandle, ( void * ) mainHEATING_ELEMENT_TAG );
+    vTaskSetApplicationTaskTag( xDisplaytaskHandle, ( void * ) mainDISPLAY_TAG );
+    vTaskSetApplicationTaskTag( xRunTimeMeasurementsTaskHandle, ( void * ) mainRUNTIME_TAG );
+    vTaskSetApplicationTaskTag( xDiagnosticsTaskHandle, ( void * ) mainDIAGONSTICS_TAG );
+    vTaskSetApplicationTaskTag( xConsoleTaskHandle, ( void * ) mainCONSOLE_TAG );
 
-    vTaskSetApplicationTaskTag( xLevelSettingTempTaskHandle, ( void * ) 1 );
-    vTaskSetApplicationTaskTag( xControlTaskHandle, ( void * ) 2 );
-    vTaskSetApplicationTaskTag( xDriverTempReadingTaskHandle, ( void * ) 3 );
-    vTaskSetApplicationTaskTag( xPassengerTempReadingTaskHandle, ( void * ) 4 );
-    vTaskSetApplicationTaskTag( xHeatingElementTaskHandle, ( void * ) 5 );
-    vTaskSetApplicationTaskTag( xDisplaytaskHandle, ( void * ) 6 );
-    vTaskSetApplicationTaskTag( xRunTimeMeasurementsTaskHandle, ( void * ) 7 );
-    vTaskSetApplicationTaskTag( xDiagnosticsTaskHandle, ( void * ) 8 );
+#if (ENABLE_WATCHDOG == TRUE)
+    /* Supervise the tasks that beat at a known rate by tag. The button, diagnostics and console
+     * tasks wait for events that may never come and are not supervised. */
+    for (xSeat = DriverTask; xSeat < mainNUM_SEATS; xSeat++)
+    {
+        Supervisor_Monitor(mainTEMP_READING_TAG(xSeat), pdMS_TO_TICKS(xSeatConfig[xSeat].usPeriodMs * mainSUPERVISOR_MISSED_PERIODS), 0);
+#if (mainCONTROL_EVENT_DRIVEN == TRUE)
+        if (xSeatConfig[xSeat].usPeriodMs > usSlowestSensorMs)
+        {
+            usSlowestSensorMs = xSeatConfig[xSeat].usPeriodMs;
+        }
+#endif
+    }
+#if (mainCONTROL_EVENT_DRIVEN == TRUE)
+    /* Every sample wakes the event driven control task, at most mainCONTROL_MIN_INTERVAL_MS later */
+    Supervisor_Monitor(mainCONTROL_TAG, pdMS_TO_TICKS((usSlowestSensorMs + mainCONTROL_MIN_INTERVAL_MS) * mainSUPERVISOR_MISSED_PERIODS), 0);
+#else
+    Supervisor_Monitor(mainCONTROL_TAG, pdMS_TO_TICKS(mainCONTROL_PERIOD_MS * mainSUPERVISOR_MISSED_PERIODS), 0);
+#endif
+    /* The display also waits for the UART behind the other users */
+    Supervisor_Monitor(mainDISPLAY_TAG, pdMS_TO_TICKS(80 * mainSUPERVISOR_MISSED_PERIODS + mainUART_MAX_HOLD_MS), 0);
+#endif
 
 
     /* Now all the tasks have been started - start the scheduler.
@@ -192,78 +697,227 @@ int main()
 
 static void prvSetupHardware(void)
 {
+    TaskID xSeat;
+
     /* Place here any needed HW initialization such as GPIO, UART, etc.  */
     UART0_Init();
     GPIO_BuiltinButtonsLedsInit();
     GPTM_WTimer0Init();
     ADC_Init();
+    LowPower_Init();
+
+    /* Start the DWT cycle counter for the cycle accurate measurements */
+    Latency_Init();
+
+    /* Sensor input, heater output and button of every seat in the table */
+    for (xSeat = DriverTask; xSeat < mainNUM_SEATS; xSeat++)
+    {
+        ADC_ChannelInit(xSeatConfig[xSeat].ucAdcChannel);
+        Heater_Init(xSeatConfig[xSeat].xHeater);
+        if (xSeatConfig[xSeat].ucButtonPin != SEAT_NO_BUTTON)
+        {
+            Button_Init(xSeat, xSeatConfig[xSeat].ucButtonPin, prvButtonGesture);
+        }
+    }
+
+#if (ENABLE_ADC_BENCHMARK == TRUE)
+    prvAdcThroughput();
+#endif
+    ADC_SetHardwareAveraging(mainADC_HW_AVERAGING);
+
+#if (ENABLE_PLANT_SIMULATION == TRUE)
+    /* From here on the sensors read the seat models */
+    for (xSeat = DriverTask; xSeat < mainNUM_SEATS; xSeat++)
+    {
+        Plant_Init(&xSeatPlant[xSeat], &xPlantConfig, xSeat + 1);
+        xPlantTick[xSeat] = 0;
+    }
+    ADC_SetInputSource(prvPlantAdcInput);
+#endif
+#if (ENABLE_TRACE_CAPTURE == TRUE)
+    ADC_SetInputSource(prvTraceCaptureInput);
+#endif
+#if (ENABLE_TRACE_REPLAY == TRUE)
+    Trace_StartReplay(xTraceReplay, usTraceReplayCount);
+    ADC_SetInputSource(prvTraceReplayInput);
+#endif
+
+    /* Mount the persistent fault log, it stays empty if the EEPROM can't be recovered */
+    if (EEPROM_Init() == TRUE)
+    {
+        FaultLog_Init();
+    }
+
+    Display_SetMode(mainDISPLAY_MODE);
+
+    /* Commands arrive by interrupt, the console task parses them */
+    Console_Init(xConsoleCommands, sizeof(xConsoleCommands) / sizeof(xConsoleCommands[0]));
+    UART0_RxInterruptInit(prvConsoleReceived);
+
+#if (ENABLE_WATCHDOG == TRUE)
+    /* Armed last, the first feed is due within a time-out of the scheduler start */
+    WDT_Init((WDT_CLOCK_HZ / 1000) * mainWATCHDOG_TIMEOUT_MS, prvWatchdogTimeout);
+#endif
+}
+
+static void prvButtonGesture(uint8 ucButton, Button_GestureType eGesture, uint32 ulTimeStamp)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    ButtonEvent_t xEvent;
+
+    if (xButtonQueue == NULL)
+    {
+        return;
+    }
+#if (ENABLE_TRACE_REPLAY == TRUE)
+    /* The board buttons are ignored during a replay, the trace holds the gestures */
+    return;
+#endif
+#if (ENABLE_TRACE_CAPTURE == TRUE)
+    Trace_Capture(TRACE_EVENT_BUTTON, ucButton, (uint16)eGesture, ulTimeStamp);
+#endif
+    xEvent.xSeat = (TaskID)ucButton;
+    xEvent.eGesture = eGesture;
+    xEvent.ulTimeStamp = ulTimeStamp;
+    xEvent.ulIsrCycles = Latency_Timestamp();
+    xEvent.ucSetLevel = mainLEVEL_FROM_GESTURE;
+    xQueueSendFromISR(xButtonQueue, &xEvent, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
-/* Task to handle button presses and adjust heating levels */
+/* Task to handle button gestures and adjust heating levels:
+ * short press --> next level, long press --> OFF, double press --> HIGH */
 void vLevelSettingTempTask(void *pvParameters)
 {
-    EventBits_t xBitsToWaitFor = (mainDRIVER_INTERRUPT_BIT | mainPASSENGER_INTERRUPT_BIT);
-    EventBits_t xEventGroupValue;
-    HeatingLevel_t xDriverPrevLevel = OFF;
-    HeatingLevel_t xPassengerPrevLevel = OFF;
+    ButtonEvent_t xEvent;
+    HeatingLevel_t xLevel;
+
     for (;;)
     {
-        /* Block to wait for event bits to become set within the event group. */
-        xEventGroupValue = xEventGroupWaitBits(xButtonEvent,   /* The event group to read. */
-                                               xBitsToWaitFor, /* Bits to test. */
-                                               pdTRUE,         /* Clear bits on exit if the unblock condition is met. */
-                                               pdFALSE,        /* Don't wait for all bits. */
-                                               portMAX_DELAY); /* Don't time out. */
+        xQueueReceive(xButtonQueue, &xEvent, portMAX_DELAY);
 
-        if ((xEventGroupValue & mainDRIVER_INTERRUPT_BIT) != 0)
+        xLevel = SeatInfo[xEvent.xSeat].xCurrentLevel;
+        if (xEvent.ucSetLevel != mainLEVEL_FROM_GESTURE)
         {
-            xDriverPrevLevel = (xDriverPrevLevel == HIGH) ? OFF : ++xDriverPrevLevel;
-            SeatInfo[DriverTask].xCurrentLevel = xDriverPrevLevel;
-            SeatInfo[DriverTask].ucTaskActive = (SeatInfo[DriverTask].xCurrentLevel == OFF) ? FALSE : TRUE;
+            SeatInfo[xEvent.xSeat].xCurrentLevel = (HeatingLevel_t)xEvent.ucSetLevel;
+            SeatInfo[xEvent.xSeat].ucTaskActive = (xEvent.ucSetLevel == OFF) ? FALSE : TRUE;
+            continue;
         }
-        else if ((xEventGroupValue & mainPASSENGER_INTERRUPT_BIT) != 0)
+        switch (xEvent.eGesture)
         {
-            xPassengerPrevLevel = (xPassengerPrevLevel == HIGH) ? OFF : ++xPassengerPrevLevel;
-            SeatInfo[PassengerTask].xCurrentLevel = xPassengerPrevLevel;
-            SeatInfo[PassengerTask].ucTaskActive = (SeatInfo[PassengerTask].xCurrentLevel == OFF) ? FALSE : TRUE;
+        case BUTTON_LONG_PRESS:
+            xLevel = OFF;
+            break;
+        case BUTTON_DOUBLE_PRESS:
+            xLevel = HIGH;
+            break;
+        default:
+            xLevel = (xLevel == HIGH) ? OFF : (HeatingLevel_t)(xLevel + 1);
+            break;
         }
+        SeatInfo[xEvent.xSeat].xCurrentLevel = xLevel;
+        SeatInfo[xEvent.xSeat].ucTaskActive = (xLevel == OFF) ? FALSE : TRUE;
+        Latency_Record(mainLATENCY_BUTTON, xEvent.ulIsrCycles);
     }
 }
 
 void vTempReadingTask(void *pvParameters)
 {
     TaskID xxGetTaskID = (TaskID)pvParameters;
-    TickType_t xPreviousWakeTime = xTaskGetTickCount();
-    TickType_t xPeriodicity = pdMS_TO_TICKS(40 + (xxGetTaskID * 20));
+    Periodic_Task_t *pxPeriodic = &xPeriodic[mainTEMP_READING_TAG(xxGetTaskID)];
+    TempSample_t xSample;
+    uint32 ulFilterStart;
+    uint32 ulCriticalStart;
+    SensorFault_StateType eState;
+    SensorFault_StateType ePreviousState = SENSOR_OK;
+
+    Periodic_Init(pxPeriodic, pcTaskNames[mainTEMP_READING_TAG(xxGetTaskID)], mainTEMP_READING_TAG(xxGetTaskID),
+                  pdMS_TO_TICKS(xSeatConfig[xxGetTaskID].usPeriodMs), pdMS_TO_TICKS(xSeatConfig[xxGetTaskID].usPeriodMs),
+                  prvDeadlineMiss);
+
+    SeatInfo[xxGetTaskID].pcCurrentSeat = (uint8 *)xSeatConfig[xxGetTaskID].pcName;
+    xSample.xSeat = xxGetTaskID;
+    SensorFault_Init(&xSeatSensor[xxGetTaskID], &xSensorFaultConfig);
 
     for (;;)
     {
-        vTaskDelayUntil(&xPreviousWakeTime, xPeriodicity);
-        ullResourceLockimeIn[0] = GPTM_WTimer0Read();
-        if (xSemaphoreTake(xDisplayToTempTaskSync, portMAX_DELAY) == pdTRUE)
-        {
-            xCurrentTaskID = xxGetTaskID;
-            SeatInfo[xxGetTaskID].pcCurrentSeat = (xxGetTaskID == DriverTask) ? "Driver" : "Passenger";
+        Periodic_WaitNextJob(pxPeriodic);
+        Supervisor_Heartbeat(mainTEMP_READING_TAG(xxGetTaskID), xTaskGetTickCount());
+        ullResourceLockimeIn[mainTEMP_READING_TAG(xxGetTaskID)] = GPTM_WTimer0Read();
+        xSample.xRelease = pxPeriodic->xRelease;
+
+        /* The sensor tasks share one ADC sequencer, a conversion must not be interleaved */
+        ulCriticalStart = prvCriticalEnter();
+#if mainADC_INPUT_HOOKED
+        xAdcSeat = xxGetTaskID;
+#endif
+        xSample.usTemp = ADC_to_Temperature(xSeatConfig[xxGetTaskID].ucAdcChannel);
+#if (ENABLE_TRACE_CAPTURE == TRUE)
+        Trace_Capture(TRACE_EVENT_ADC, xxGetTaskID, (uint16)(ulTraceSum >> POT_OVERSAMPLE_BITS), GPTM_WTimer0Read());
+        ulTraceSum = 0;
+#endif
+        prvCriticalExit(ulCriticalStart);
+#if (ENABLE_TRACE_REPLAY == TRUE)
+        prvTraceReplayGestures();
+#endif
+        xSample.ulTimeStamp = GPTM_WTimer0Read();
 
+        eState = SensorFault_Update(&xSeatSensor[xxGetTaskID], xSample.usTemp);
+        if (eState == SENSOR_FAULTED && ePreviousState <= SENSOR_SUSPECT)
+        {
+            /* New fault confirmed, the task keeps sampling to detect the recovery */
+            ulCriticalStart = prvCriticalEnter();
+            ulFaultedSeats |= mainSEAT_NOTIFY_BIT(xxGetTaskID);
+            prvCriticalExit(ulCriticalStart);
+            GPIO_RedLedOn();
 #if (ENABLE_DIAGONSTICS == TRUE)
-            if (ADC_to_Temperature() < 5 || ADC_to_Temperature() >= 40)
-            {
-                GPIO_RedLedOn();
-                Diagonstics[usCounter].FailureTimeStamp = GPTM_WTimer0Read();
-                Diagonstics[usCounter].pcCurrentSeat = SeatInfo[xxGetTaskID].pcCurrentSeat;
-                Diagonstics[usCounter].xCurrentLevel = SeatInfo[xxGetTaskID].xCurrentLevel;
-                ullResourceLockimeOut[xxGetTaskID] = GPTM_WTimer0Read();
-                xSemaphoreGive(xTempToDiagonsticsTaskSync);
-                vTaskSuspend(NULL);
-            }
-            else
+            prvRaiseDiagnostic(xSample.ulTimeStamp, SeatInfo[xxGetTaskID].pcCurrentSeat, SeatInfo[xxGetTaskID].xCurrentLevel,
+                               xxGetTaskID, (xSample.usTemp < mainSENSOR_FAULT_LOW) ? FAULT_SENSOR_LOW : FAULT_SENSOR_HIGH);
 #endif
+        }
+        else if (eState == SENSOR_OK && ePreviousState >= SENSOR_FAULTED)
+        {
+            /* The filter history predates the fault, start it over */
+            Filter_Init(&xSeatFilter[xxGetTaskID], xSeatConfig[xxGetTaskID].ucMedianLength, xSeatConfig[xxGetTaskID].sFilterAlpha);
+            ulCriticalStart = prvCriticalEnter();
+            ulFaultedSeats &= ~mainSEAT_NOTIFY_BIT(xxGetTaskID);
+            if (ulFaultedSeats == 0)
             {
-                SeatInfo[xxGetTaskID].usCurrentTemp = ADC_to_Temperature(); // ADC_to_temp()
-                ullResourceLockimeOut[xxGetTaskID] = GPTM_WTimer0Read();
-                xSemaphoreGive(xTempToControlTaskSync);
+                GPIO_RedLedOff();
             }
+            prvCriticalExit(ulCriticalStart);
+#if (ENABLE_DIAGONSTICS == TRUE)
+            prvRaiseDiagnostic(xSample.ulTimeStamp, SeatInfo[xxGetTaskID].pcCurrentSeat, SeatInfo[xxGetTaskID].xCurrentLevel,
+                               xxGetTaskID, FAULT_SENSOR_RECOVERED);
+#endif
+        }
+        ePreviousState = eState;
+
+        if (eState == SENSOR_SUSPECT)
+        {
+            /* Not confirmed yet, drop the reading and let the last good sample stand */
+            ullResourceLockimeOut[mainTEMP_READING_TAG(xxGetTaskID)] = GPTM_WTimer0Read();
+            continue;
+        }
+
+        if (eState == SENSOR_OK)
+        {
+            /* Spike rejection and smoothing, the fault detection above sees the raw reading */
+            ulFilterStart = Latency_Timestamp();
+            xSample.usTemp = Filter_Update(&xSeatFilter[xxGetTaskID], xSample.usTemp);
+            Latency_Record(mainLATENCY_FILTER, ulFilterStart);
+            xSample.bValid = TRUE;
         }
+        else
+        {
+            /* Faulted or recovering: keep the control task informed so the heater stays off */
+            xSample.bValid = FALSE;
+        }
+
+        /* Only the newest sample matters to the control task */
+        xQueueOverwrite(xSampleQueue[xxGetTaskID], &xSample);
+        ullResourceLockimeOut[mainTEMP_READING_TAG(xxGetTaskID)] = GPTM_WTimer0Read();
+        xTaskNotify(xControlTaskHandle, mainSEAT_NOTIFY_BIT(xxGetTaskID), eSetBits);
     }
 }
 
@@ -271,36 +925,113 @@ void vTempReadingTask(void *pvParameters)
 /* Task to control heating elements based on desired temperature */
 void vControlTask(void *pvParameters)
 {
-    TaskID xxGetTaskID;
+    TaskID xSeat;
+#if (mainCONTROL_EVENT_DRIVEN == TRUE)
     TickType_t xPreviousWakeTime = xTaskGetTickCount();
-    TickType_t xPeriodicity = pdMS_TO_TICKS(50);
+    TickType_t xMinInterval = pdMS_TO_TICKS(mainCONTROL_MIN_INTERVAL_MS);
+    TickType_t xElapsed;
+    uint32_t ulLateSeats;
+#endif
     uint16 usDesired_Temp;
-    sint16 sTemp_Diff;
+    uint16 usDuty;
+    uint16 usDt;
+    uint32 ulNow;
+    uint32_t ulFreshSeats;
+    uint32 ulCommandedSeats;
+    TempSample_t xSample;
+
+#if (mainCONTROL_EVENT_DRIVEN == FALSE)
+    Periodic_Init(&xPeriodic[mainCONTROL_TAG], pcTaskNames[mainCONTROL_TAG], mainCONTROL_TAG,
+                  pdMS_TO_TICKS(mainCONTROL_PERIOD_MS), pdMS_TO_TICKS(mainCONTROL_PERIOD_MS), prvDeadlineMiss);
+#endif
     for (;;)
     {
-        vTaskDelayUntil(&xPreviousWakeTime, xPeriodicity);
-        xxGetTaskID = xCurrentTaskID;
-        usDesired_Temp = 20 + (SeatInfo[xxGetTaskID].xCurrentLevel * 5);
-        sTemp_Diff = usDesired_Temp - SeatInfo[xxGetTaskID].usCurrentTemp;
+#if (mainCONTROL_EVENT_DRIVEN == TRUE)
+        /* Sleep until a sensor delivers a sample */
+        xTaskNotifyWait(0, mainALL_NOTIFY_BITS, &ulFreshSeats, portMAX_DELAY);
 
-        if (SeatInfo[xxGetTaskID].usCurrentTemp >= usDesired_Temp || SeatInfo[xxGetTaskID].xCurrentLevel == OFF)
+        /* Rate limit the decisions, samples arriving meanwhile join this pass */
+        xElapsed = xTaskGetTickCount() - xPreviousWakeTime;
+        if (xElapsed < xMinInterval)
         {
-            xEventGroupSetBits(xHeatingEvent, mainDISABLED_INTENSITY_BIT);
+            vTaskDelay(xMinInterval - xElapsed);
+            xTaskNotifyWait(0, mainALL_NOTIFY_BITS, &ulLateSeats, 0);
+            ulFreshSeats |= ulLateSeats;
         }
-        else
+        xPreviousWakeTime = xTaskGetTickCount();
+#else
+        Periodic_WaitNextJob(&xPeriodic[mainCONTROL_TAG]);
+
+        /* Collect the seats that delivered a sample since the last pass */
+        xTaskNotifyWait(0, mainALL_NOTIFY_BITS, &ulFreshSeats, 0);
+#endif
+        Supervisor_Heartbeat(mainCONTROL_TAG, xTaskGetTickCount());
+        ulCommandedSeats = 0;
+
+        /* One batched pass over the seats */
+        for (xSeat = DriverTask; xSeat < mainNUM_SEATS; xSeat++)
         {
-            if (sTemp_Diff >= 10)
+            if ((ulFreshSeats & mainSEAT_NOTIFY_BIT(xSeat)) != 0 &&
+                xQueueReceive(xSampleQueue[xSeat], &xSample, 0) == pdTRUE)
+            {
+                /* The PID integrates over the sensor periods since the previous sample, a
+                 * dropped or overwritten sample or a rate limited pass makes it longer */
+                usDt = (SeatInfo[xSeat].xSampleRelease == 0) ? PID_DT_ONE :
+                       PID_DT(xSample.xRelease - SeatInfo[xSeat].xSampleRelease, pdMS_TO_TICKS(mainCONTROL_PERIOD_MS));
+                SeatInfo[xSeat].usCurrentTemp = xSample.usTemp;
+                SeatInfo[xSeat].ulSampleTime = xSample.ulTimeStamp;
+                SeatInfo[xSeat].xSampleRelease = xSample.xRelease;
+                SeatInfo[xSeat].bSensorValid = xSample.bValid;
+            }
+            else
+            {
+                /* Nothing new for this seat, keep its last command rather than run the PID on old data */
+#if (mainCONTROL_EVENT_DRIVEN == FALSE)
+                ulStaleDecisionCount++;
+#endif
+                continue;
+            }
+
+            usDesired_Temp = mainSET_POINT(SeatInfo[xSeat].xCurrentLevel);
+
+            if (SeatInfo[xSeat].xCurrentLevel == OFF || SeatInfo[xSeat].bSensorValid == FALSE)
             {
-                xEventGroupSetBits(xHeatingEvent, mainHIGH_INTENSITY_BIT);
+                /* Heater forced off without a trusted temperature, the controller restarts clean */
+                PID_Reset(&xSeatPID[xSeat]);
+                usDuty = 0;
             }
-            else if (sTemp_Diff >= 5 && sTemp_Diff < 10)
+            else
             {
-                xEventGroupSetBits(xHeatingEvent, mainMEDIUM_INTENSITY_BIT);
+                PID_SetGains(&xSeatPID[xSeat], &xHeatingGains[SeatInfo[xSeat].xCurrentLevel]);
+                usDuty = PID_Update(&xSeatPID[xSeat], usDesired_Temp, SeatInfo[xSeat].usCurrentTemp, usDt);
             }
-            else if (sTemp_Diff >= 1 && sTemp_Diff < 5)
+
+            /* Continuous duty in percent */
+            SeatInfo[xSeat].ucHeaterDuty = (uint8)((usDuty * 100UL + (PID_Q15_ONE / 2)) / PID_Q15_ONE);
+
+            /* The heater task has the higher priority, it never sees a half written slot */
+            xHeaterCommand[xSeat].xSeat = xSeat;
+            xHeaterCommand[xSeat].xLevel = SeatInfo[xSeat].xCurrentLevel;
+            xHeaterCommand[xSeat].usTemp = SeatInfo[xSeat].usCurrentTemp;
+            xHeaterCommand[xSeat].ucDuty = SeatInfo[xSeat].ucHeaterDuty;
+            xHeaterCommand[xSeat].ulSampleTime = SeatInfo[xSeat].ulSampleTime;
+            ulCommandedSeats |= mainSEAT_NOTIFY_BIT(xSeat);
+
+            /* Track the worst time between two decisions of the same seat */
+            ulNow = GPTM_WTimer0Read();
+            if (SeatInfo[xSeat].ulLastControlTime != 0 &&
+                (ulNow - SeatInfo[xSeat].ulLastControlTime) > SeatInfo[xSeat].ulMaxControlInterval)
             {
-                xEventGroupSetBits(xHeatingEvent, mainLOW_INTENSITY_BIT);
+                SeatInfo[xSeat].ulMaxControlInterval = ulNow - SeatInfo[xSeat].ulLastControlTime;
             }
+            SeatInfo[xSeat].ulLastControlTime = ulNow;
+        }
+
+        /* A single notification releases the heater task for the whole pass */
+        ulControlPassCount++;
+        if (ulCommandedSeats != 0)
+        {
+            xTaskNotify(xHeatingElementTaskHandle, ulCommandedSeats, eSetBits);
         }
     }
 }
@@ -308,210 +1039,1102 @@ void vControlTask(void *pvParameters)
 /* Task to adjust heating intensity based on temperature difference */
 void vHeatingElementTask(void *pvParameters)
 {
-    TaskID xxGetTaskID;
-    EventBits_t xBitsToWaitFor = (mainDISABLED_INTENSITY_BIT | mainLOW_INTENSITY_BIT | mainMEDIUM_INTENSITY_BIT | mainHIGH_INTENSITY_BIT);
-    EventBits_t xEventGroupValue;
+    TaskID xSeat;
+    uint32_t ulSeats;
+    uint32 ulLatency;
+    uint32 ulLastSampleTime[mainNUM_SEATS] = {0};
+    HeaterCommand_t *pxCommand;
+    DisplayUpdate_t xUpdate;
+#if (ENABLE_PLANT_SIMULATION == TRUE)
+    uint32 ulCriticalStart;
+#endif
     for (;;)
     {
-        /* Block to wait for event bits to become set within the event group. */
-        xEventGroupValue = xEventGroupWaitBits(xHeatingEvent,  /* The event group to read. */
-                                               xBitsToWaitFor, /* Bits to test. */
-                                               pdTRUE,         /* Clear bits on exit if the unblock condition is met. */
-                                               pdFALSE,        /* Don't wait for all bits. */
-                                               portMAX_DELAY); /* Don't time out. */
-        xxGetTaskID = xCurrentTaskID;
-        if ((xEventGroupValue & mainDISABLED_INTENSITY_BIT) != 0)
-        {
-            SeatInfo[xxGetTaskID].pcHeatIntensity = "DISABLED";
-            GPIO_GreenLedOff();
-            GPIO_BlueLedOff();
-            GPIO_RedLedOff();
-        }
-        else if ((xEventGroupValue & mainLOW_INTENSITY_BIT) != 0)
-        {
-            SeatInfo[xxGetTaskID].pcHeatIntensity = "LOW";
-            GPIO_GreenLedOn();
-            GPIO_BlueLedOff();
-            GPIO_RedLedOff();
-        }
-        else if ((xEventGroupValue & mainMEDIUM_INTENSITY_BIT) != 0)
-        {
-            SeatInfo[xxGetTaskID].pcHeatIntensity = "MEDIUM";
-            GPIO_GreenLedOn();
-            GPIO_BlueLedOn();
-            GPIO_RedLedOff();
-        }
+        /* Block until the control task commands any seat, the value holds one bit per seat */
+        xTaskNotifyWait(0, mainALL_NOTIFY_BITS, &ulSeats, portMAX_DELAY);
 
-        else if ((xEventGroupValue & mainHIGH_INTENSITY_BIT) != 0)
+        for (xSeat = DriverTask; xSeat < mainNUM_SEATS; xSeat++)
         {
-            SeatInfo[xxGetTaskID].pcHeatIntensity = "HIGH";
-            GPIO_GreenLedOn();
-            GPIO_BlueLedOff();
-            GPIO_RedLedOn();
+            if ((ulSeats & mainSEAT_NOTIFY_BIT(xSeat)) == 0)
+            {
+                continue;
+            }
+            pxCommand = &xHeaterCommand[xSeat];
+
+            if (pxCommand->ucDuty == 0)
+            {
+                xUpdate.pcHeatIntensity = "DISABLED";
+            }
+            else if (pxCommand->ucDuty <= 33)
+            {
+                xUpdate.pcHeatIntensity = "LOW";
+            }
+            else if (pxCommand->ucDuty <= 66)
+            {
+                xUpdate.pcHeatIntensity = "MEDIUM";
+            }
+            else
+            {
+                xUpdate.pcHeatIntensity = "HIGH";
+            }
+
+            /* The PWM generator latches the new duty at its next period boundary */
+            Heater_SetPower(xSeatConfig[xSeat].xHeater, (bHeatersInhibited == TRUE) ? 0 : pxCommand->ucDuty);
+#if (ENABLE_PLANT_SIMULATION == TRUE)
+            /* The old duty heated the model until now, the new one applies from here */
+            ulCriticalStart = prvCriticalEnter();
+            prvPlantAdvance(xSeat);
+            Plant_SetDuty(&xSeatPlant[xSeat], (bHeatersInhibited == TRUE) ? 0 : pxCommand->ucDuty);
+            Plant_SetTarget(&xSeatPlant[xSeat], (pxCommand->xLevel == OFF) ? 0 : mainSET_POINT(pxCommand->xLevel));
+            prvCriticalExit(ulCriticalStart);
+#endif
+            if (xUpdate.pcHeatIntensity != SeatInfo[xSeat].pcHeatIntensity)
+            {
+                SeatInfo[xSeat].pcHeatIntensity = xUpdate.pcHeatIntensity;
+                SeatInfo[xSeat].ulIntensityChanges++;
+            }
+
+            /* Latency from sampling to the first actuation based on that sample */
+            if (pxCommand->ulSampleTime != ulLastSampleTime[xSeat])
+            {
+                ulLastSampleTime[xSeat] = pxCommand->ulSampleTime;
+                ulLatency = GPTM_WTimer0Read() - pxCommand->ulSampleTime;
+                ulActuationLatencyTotal += ulLatency;
+                ulActuationCount++;
+                Latency_RecordCycles(mainLATENCY_ACTUATION, ulLatency * (LATENCY_CLOCK_HZ / 10000UL));
+                if (ulLatency > ulActuationLatencyMax)
+                {
+                    ulActuationLatencyMax = ulLatency;
+                }
+#if mainTRACE_ENABLED
+                aulDecisionDigest[xSeat] = (aulDecisionDigest[xSeat] * 31) + ((uint32)pxCommand->xLevel << 8) + pxCommand->ucDuty;
+#endif
+            }
+
+            xUpdate.xSeat = xSeat;
+            xUpdate.xLevel = pxCommand->xLevel;
+            xUpdate.usTemp = pxCommand->usTemp;
+            xUpdate.ucDuty = pxCommand->ucDuty;
+            xQueueOverwrite(xDisplayQueue[xSeat], &xUpdate);
         }
     }
 }
 
 void vDisplaytask(void *pvParameters)
 {
-    TaskID xGetTaskID;
-    TickType_t xPreviousWakeTime = xTaskGetTickCount();
-    TickType_t xPeriodicity = pdMS_TO_TICKS(80);
+    TaskID xSeat;
+    DisplayUpdate_t xUpdate;
+
+    Periodic_Init(&xPeriodic[mainDISPLAY_TAG], pcTaskNames[mainDISPLAY_TAG], mainDISPLAY_TAG,
+                  pdMS_TO_TICKS(80), pdMS_TO_TICKS(80), prvDeadlineMiss);
     for (;;)
     {
-        vTaskDelayUntil(&xPreviousWakeTime, xPeriodicity);
-        xGetTaskID = xCurrentTaskID;
-        if (SeatInfo[xGetTaskID].ucTaskActive == TRUE) //|| SeatInfo[xGetTaskID].usCurrentTemp != 0)
+        Periodic_WaitNextJob(&xPeriodic[mainDISPLAY_TAG]);
+        Supervisor_Heartbeat(mainDISPLAY_TAG, xTaskGetTickCount());
+        for (xSeat = DriverTask; xSeat < mainNUM_SEATS; xSeat++)
         {
-            ullResourceLockimeIn[2] = GPTM_WTimer0Read();
-            if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE)
+            if (xQueueReceive(xDisplayQueue[xSeat], &xUpdate, 0) == pdTRUE)
             {
-                UART0_SendString("\r\nSeat:\tCurrent Temp:\tHeating level:\tHeating Intensity:\r\n");
-                UART0_SendString("--------------------------------------------------\r\n");
-                UART0_SendString(SeatInfo[xGetTaskID].pcCurrentSeat);
-                UART0_SendString("\t\t");
-                UART0_SendInteger(SeatInfo[xGetTaskID].usCurrentTemp);
-                UART0_SendString("\t\t");
-                UART0_SendInteger(SeatInfo[xGetTaskID].xCurrentLevel);
-                UART0_SendString("\t\t");
-                UART0_SendString(SeatInfo[xGetTaskID].pcHeatIntensity);
-                UART0_SendString("\r\n");
-                ullResourceLockimeOut[2] = GPTM_WTimer0Read();
-                xSemaphoreGive(xMutex);
+                Display_SetSeat(xSeat, SeatInfo[xSeat].pcCurrentSeat, xUpdate.usTemp, xUpdate.xLevel, xUpdate.pcHeatIntensity);
             }
         }
-        xSemaphoreGive(xDisplayToTempTaskSync);
+
+        /* Nothing changed and no keyframe due: the UART stays free */
+        if (Display_BeginRefresh() == FALSE)
+        {
+            continue;
+        }
+
+        if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE)
+        {
+            ullResourceLockimeIn[mainDISPLAY_TAG] = GPTM_WTimer0Read();
+            Display_Flush();
+            prvUartGive(mainDISPLAY_TAG);
+        }
     }
 }
 
 void vRunTimeMeasurementsTask(void *pvParameters)
 {
+    uint16 usReportLine = 0;
 
-    TickType_t xPreviousWakeTime = xTaskGetTickCount();
-    TickType_t xPeriodicity = pdMS_TO_TICKS(450);
+    Periodic_Init(&xPeriodic[mainRUNTIME_TAG], pcTaskNames[mainRUNTIME_TAG], mainRUNTIME_TAG,
+                  pdMS_TO_TICKS(mainRUNTIME_PERIOD_MS), pdMS_TO_TICKS(mainRUNTIME_PERIOD_MS), prvDeadlineMiss);
     for (;;)
     {
-        uint8 ucCounter, ucCPU_Load;
+        uint8 ucCounter, ucCPU_Load, ucSent;
         uint32 ullTotalTasksTime = 0;
-        vTaskDelayUntil(&xPreviousWakeTime, xPeriodicity);
+        uint32 ulDeadlineMisses = 0;
+        Periodic_WaitNextJob(&xPeriodic[mainRUNTIME_TAG]);
+
+        /* A stalled run time task starves the watchdog as well */
+        prvWatchdogService();
+
+#if(ENABLE_ISR_LATENCY_BENCHMARK == TRUE)
+        /* Pend the Port F interrupt by software, its handler measures the entry latency */
+        ulPortFPendCycle = Latency_Timestamp();
+        NVIC_PEND0_REG = mainPORTF_PEND_MASK;
+#endif
+
+#if(ENABLE_RESPONSE_TIME_ANALYSIS == TRUE)
+        /* Longest job from the trace hooks, longest UART mutex hold of its users and longest
+         * interrupts-disabled section of every task */
+        for(ucCounter = 0; ucCounter < mainNUM_TASKS; ucCounter++)
+        {
+            RTA_UpdateMeasurement(&xTaskSet[ucCounter], ullTasksMaxExecutionTime[ucCounter + 1],
+                                  ((xTaskSet[ucCounter].ucResources & RTA_RESOURCE_UART_MUTEX) != 0) ? ullResourceLockMax[ucCounter + 1] : 0,
+                                  mainCYCLES_TO_WTIMER(aulCriticalSectionCycles[ucCounter + 1]));
+        }
+        RTA_Analyse(xTaskSet, mainNUM_TASKS);
+#endif
 
-        for(ucCounter = 1; ucCounter < 9; ucCounter++)
+        for(ucCounter = 1; ucCounter < mainNUM_TAGS; ucCounter++)
         {
             ullTotalTasksTime += ullTasksTotalTime[ucCounter];
         }
         ucCPU_Load = (ullTotalTasksTime * 100) /  GPTM_WTimer0Read();
 
-        ullResourceLockimeIn[3] = GPTM_WTimer0Read();
-        if(xSemaphoreTake(xMutex,portMAX_DELAY) == pdTRUE)
+        /* System cells of the dashboard: CPU load, diagnostics raised and deadlines missed */
+        for(ucCounter = 1; ucCounter < mainNUM_TAGS; ucCounter++)
         {
-            taskENTER_CRITICAL();
-            UART0_SendString("LevelSettingTempTask execution time:\tResource Lock Time: ");
-            UART0_SendString("------------------------------------------------------------\r\n");
-            UART0_SendInteger(ullTasksExecutionTime[1] / 10);
-            UART0_SendString(" msec \r\n");
-
-            UART0_SendString("ControlTask execution time:\tResource Lock Time: ");
-            UART0_SendString("------------------------------------------------------------\r\n");
-            UART0_SendInteger(ullTasksExecutionTime[2] / 10);
-            UART0_SendString(" msec \r\n");
-
-            UART0_SendString("DriverTempReadingTask execution time:\tResource Lock Time: ");
-            UART0_SendString("------------------------------------------------------------\r\n");
-            UART0_SendInteger(ullTasksExecutionTime[3] / 10);
-            UART0_SendString(" msec\t\t");
-            UART0_SendInteger((ullResourceLockimeOut[0] - ullResourceLockimeIn[0]) / 10);
-            UART0_SendString(" msec\r\n");
-
-
-            UART0_SendString("PassengerTempReadingTask execution time:\tResource Lock Time: ");
-            UART0_SendString("------------------------------------------------------------\r\n");
-            UART0_SendInteger(ullTasksExecutionTime[4] / 10);
-            UART0_SendString(" msec\t\t");
-            UART0_SendInteger((ullResourceLockimeOut[1] - ullResourceLockimeIn[1]) / 10);
-            UART0_SendString(" msec\r\n");
-
-            UART0_SendString("HeatingElementTask execution time:\tResource Lock Time: ");
-            UART0_SendString("------------------------------------------------------------\r\n");
-            UART0_SendInteger(ullTasksExecutionTime[5] / 10);
-            UART0_SendString(" msec \r\n");
-
-            UART0_SendString("Displaytask execution time:\tResource Lock Time: ");
-            UART0_SendString("------------------------------------------------------------\r\n");
-            UART0_SendInteger(ullTasksExecutionTime[6] / 10);
-            UART0_SendString(" msec\t\t");
-            UART0_SendInteger((ullResourceLockimeOut[2] - ullResourceLockimeIn[2]) / 10);
-            UART0_SendString(" msec\r\n");
-
-            UART0_SendString("RunTimeMeasurementsTask execution time:\tResource Lock Time: ");
-            UART0_SendString("------------------------------------------------------------\r\n");
-            UART0_SendInteger(ullTasksExecutionTime[7] / 10);
-            UART0_SendString(" msec\t\t");
-            UART0_SendInteger((ullResourceLockimeOut[3] - ullResourceLockimeIn[3]) / 10);
-            UART0_SendString(" msec\r\n");
-
-            UART0_SendString("DiagnosticsTask execution time:\tResource Lock Time: ");
-            UART0_SendString("------------------------------------------------------------\r\n");
-            UART0_SendInteger(ullTasksExecutionTime[8] / 10);
-            UART0_SendString(" msec\t\t");
-            UART0_SendInteger((ullResourceLockimeOut[4] - ullResourceLockimeIn[4]) / 10);
-            UART0_SendString(" msec\r\n");
-
-
-            UART0_SendString("CPU Load is ");
-            UART0_SendInteger(ucCPU_Load);
-            UART0_SendString("% \r\n");
-            ullResourceLockimeOut[3] = GPTM_WTimer0Read();
-            xSemaphoreGive(xMutex);
-            taskEXIT_CRITICAL();
+            ulDeadlineMisses += xPeriodic[ucCounter].ulMisses;
+        }
+        Display_SetSystem(ucCPU_Load, usCounter, ulDeadlineMisses);
 
+        /* No critical section around the report: the ticks, the other tasks and the watchdog keep running,
+         * only the UART users wait, for mainREPORT_LINES_PER_PERIOD lines at most */
+        while (xSemaphoreTake(xMutex, pdMS_TO_TICKS(mainWATCHDOG_SERVICE_MS)) == pdFALSE)
+        {
+            prvWatchdogService();
         }
+        ullResourceLockimeIn[mainRUNTIME_TAG] = GPTM_WTimer0Read();
+        ucSent = 0;
+        do
+        {
+            if (prvSendReportLine(usReportLine, ullTotalTasksTime, ucCPU_Load) == TRUE)
+            {
+                ucSent++;
+            }
+            usReportLine = (usReportLine + 1) % mainREPORT_LINES;
+        } while ((ucSent < mainREPORT_LINES_PER_PERIOD) && (usReportLine != 0));
+        prvUartGive(mainRUNTIME_TAG);
     }
-
-
 }
 
-void vDiagonsticsTask(void *pvParameters)
+static boolean prvSendReportLine(uint16 usLine, uint32 ulBusyTicks, uint8 ucCPU_Load)
 {
-    for (;;)
+    uint8 ucCounter;
+    LowPower_Stats_t xSleepStats;
+    Display_Stats_t xDisplayStats;
+    boolean bSent = TRUE;
+
+    if (usLine < mainNUM_TAGS - 1)
     {
-        ullResourceLockimeIn[4] = GPTM_WTimer0Read();
-        if (xSemaphoreTake(xTempToDiagonsticsTaskSync, portMAX_DELAY))
-        {
-            if (usCounter == BUFFER_SIZE - 1)
-            {
-                usCounter = 0;
-            }
-            else
+        UART0_SendString(pcTaskNames[usLine + 1]);
+        UART0_SendString(" execution time: ");
+        UART0_SendInteger(ullTasksExecutionTime[usLine + 1] / 10);
+        UART0_SendString(" msec, resource lock time: ");
+        UART0_SendInteger((ullResourceLockimeOut[usLine + 1] - ullResourceLockimeIn[usLine + 1]) / 10);
+        UART0_SendString(" msec\r\n");
+        return TRUE;
+    }
+    usLine -= mainNUM_TAGS - 1;
+
+    switch (usLine)
+    {
+    case 0:
+        UART0_SendString("Max control interval:");
+        for(ucCounter = 0; ucCounter < mainNUM_SEATS; ucCounter++)
+        {
+            UART0_SendString(" ");
+            UART0_SendString(SeatInfo[ucCounter].pcCurrentSeat);
+            UART0_SendString(" ");
+            UART0_SendInteger(SeatInfo[ucCounter].ulMaxControlInterval / 10);
+        }
+        UART0_SendString(" msec\r\n");
+        break;
+    case 1:
+        UART0_SendString("Heater intensity changes:");
+        for(ucCounter = 0; ucCounter < mainNUM_SEATS; ucCounter++)
+        {
+            UART0_SendString(" ");
+            UART0_SendString(SeatInfo[ucCounter].pcCurrentSeat);
+            UART0_SendString(" ");
+            UART0_SendInteger(SeatInfo[ucCounter].ulIntensityChanges);
+        }
+        UART0_SendString("\r\n");
+        break;
+    case 2:
+        UART0_SendString("Sensor faults:");
+        for(ucCounter = 0; ucCounter < mainNUM_SEATS; ucCounter++)
+        {
+            UART0_SendString(" ");
+            UART0_SendString(SeatInfo[ucCounter].pcCurrentSeat);
+            UART0_SendString(" ");
+            UART0_SendInteger(xSeatSensor[ucCounter].ulFaults);
+            UART0_SendString(" (");
+            UART0_SendString(pcSensorStateNames[xSeatSensor[ucCounter].eState]);
+            UART0_SendString(")");
+        }
+        UART0_SendString("\r\n");
+        break;
+    case 3:
+        UART0_SendString("Context switches per control pass (x100): ");
+        UART0_SendInteger((ulControlPassCount == 0) ? 0 : (ulContextSwitchCount * 100) / ulControlPassCount);
+        UART0_SendString("\r\n");
+        break;
+    case 4:
+        UART0_SendString((mainCONTROL_EVENT_DRIVEN == TRUE) ? "Event driven" : "Periodic");
+        UART0_SendString(" control, sample to actuation latency avg/max: ");
+        UART0_SendInteger((ulActuationCount == 0) ? 0 : ulActuationLatencyTotal / ulActuationCount / 10);
+        UART0_SendString(" / ");
+        UART0_SendInteger(ulActuationLatencyMax / 10);
+        UART0_SendString(" msec, seat passes without a new sample: ");
+        UART0_SendInteger(ulStaleDecisionCount);
+        UART0_SendString("\r\n");
+        break;
+    case 5:
+        LowPower_GetStats(&xSleepStats);
+        UART0_SendString("Time asleep: ");
+        UART0_SendInteger(xSleepStats.ulTimeAsleep / 10);
+        UART0_SendString(" msec in ");
+        UART0_SendInteger(xSleepStats.ulSleepCount);
+        UART0_SendString(" sleeps\r\n");
+        break;
+    case 6:
+        /* UART time in msec = bytes * bits per frame * 1000 / baud rate */
+        Display_GetStats(&xDisplayStats);
+        UART0_SendString("Display bytes sent / full table: ");
+        UART0_SendInteger(xDisplayStats.ulBytesSent);
+        UART0_SendString(" / ");
+        UART0_SendInteger(xDisplayStats.ulBytesFullTable);
+        UART0_SendString(", UART busy ");
+        UART0_SendInteger(((uint64)xDisplayStats.ulBytesSent * UART0_BITS_PER_FRAME * 1000) / UART0_BAUD_RATE);
+        UART0_SendString(" / ");
+        UART0_SendInteger(((uint64)xDisplayStats.ulBytesFullTable * UART0_BITS_PER_FRAME * 1000) / UART0_BAUD_RATE);
+        UART0_SendString(" msec, keyframes: ");
+        UART0_SendInteger(xDisplayStats.ulKeyframes);
+        UART0_SendString("\r\n");
+        break;
+    case 7:
+#if(ENABLE_WATCHDOG == TRUE)
+        if (Supervisor_GetLate() == SUPERVISOR_NONE)
+        {
+            UART0_SendString("Watchdog fed, all supervised tasks alive\r\n");
+        }
+        else
+        {
+            UART0_SendString("Watchdog starved by ");
+            UART0_SendString(pcTaskNames[Supervisor_GetLate()]);
+            UART0_SendString("\r\n");
+        }
+#else
+        bSent = FALSE;
+#endif
+        break;
+    case 8:
+#if(ENABLE_ISR_LATENCY_BENCHMARK == TRUE)
+        UART0_SendString("Longest Port F handler: ");
+        UART0_SendInteger(ulPortFIsrCyclesMax);
+        UART0_SendString(" cycles\r\n");
+#else
+        bSent = FALSE;
+#endif
+        break;
+    case 9:
+        UART0_SendString("CPU Load is ");
+        UART0_SendInteger(ucCPU_Load);
+        UART0_SendString("% \r\n");
+        break;
+    default:
+        break;
+    }
+    if (usLine < mainREPORT_SYSTEM_LINES)
+    {
+        return bSent;
+    }
+    usLine -= mainREPORT_SYSTEM_LINES;
+
+    if (usLine < mainLATENCY_SOURCES)
+    {
+        prvSendLatency(usLine);
+        return TRUE;
+    }
+    usLine -= mainLATENCY_SOURCES;
+
+    if (usLine < mainNUM_TAGS - 1)
+    {
+        return prvSendDeadlines(usLine + 1);
+    }
+    usLine -= mainNUM_TAGS - 1;
+
+#if(ENABLE_RESPONSE_TIME_ANALYSIS == TRUE)
+    /* One line per task: name, period, priority, WCET, blocking, response, slack, all in 0.1 msec */
+    if (usLine == 0)
+    {
+        UART0_SendString("Response time analysis (0.1 msec): RTA,Task,T,P,C,B,R,S\r\n");
+        return TRUE;
+    }
+    if (usLine <= mainNUM_TASKS)
+    {
+        ucCounter = usLine - 1;
+        UART0_SendString("RTA,");
+        UART0_SendString(xTaskSet[ucCounter].pcName);
+        UART0_SendString(",");
+        UART0_SendInteger(xTaskSet[ucCounter].ulPeriod);
+        UART0_SendString(",");
+        UART0_SendInteger(xTaskSet[ucCounter].ucPriority);
+        UART0_SendString(",");
+        UART0_SendInteger(xTaskSet[ucCounter].ulWcet);
+        UART0_SendString(",");
+        UART0_SendInteger(xTaskSet[ucCounter].ulBlocking);
+        UART0_SendString(",");
+        if (xTaskSet[ucCounter].ulResponse == RTA_UNSCHEDULABLE)
+        {
+            UART0_SendString("MISS,0\r\n");
+        }
+        else
+        {
+            UART0_SendInteger(xTaskSet[ucCounter].ulResponse);
+            UART0_SendString(",");
+            UART0_SendInteger(xTaskSet[ucCounter].ulSlack);
+            UART0_SendString("\r\n");
+        }
+        return TRUE;
+    }
+    usLine -= mainNUM_TASKS + 1;
+#endif
+
+#if (ENABLE_PLANT_SIMULATION == TRUE)
+    if (usLine <= mainNUM_SEATS)
+    {
+        prvSendPlant(usLine, ulBusyTicks);
+        return TRUE;
+    }
+#endif
+    return FALSE;
+}
+
+static void prvUartHandOver(void)
+{
+    uint8 ucTag = (uint8)(uint32)xTaskGetApplicationTaskTag(NULL);
+
+    /* A waiting display or run time task of the same priority runs before the mutex is taken back */
+    prvUartGive(ucTag);
+    taskYIELD();
+    xSemaphoreTake(xMutex, portMAX_DELAY);
+    ullResourceLockimeIn[ucTag] = GPTM_WTimer0Read();
+}
+
+static void prvUartGive(uint8 ucTag)
+{
+    ullResourceLockimeOut[ucTag] = GPTM_WTimer0Read();
+    if (ullResourceLockimeOut[ucTag] - ullResourceLockimeIn[ucTag] > ullResourceLockMax[ucTag])
+    {
+        ullResourceLockMax[ucTag] = ullResourceLockimeOut[ucTag] - ullResourceLockimeIn[ucTag];
+    }
+    xSemaphoreGive(xMutex);
+}
+
+static uint32 prvCriticalEnter(void)
+{
+    taskENTER_CRITICAL();
+    return Latency_Timestamp();
+}
+
+static void prvCriticalExit(uint32 ulStart)
+{
+    uint32 ulCycles = Latency_Timestamp() - ulStart;
+    uint32 ulTag = (uint32)xTaskGetApplicationTaskTag(NULL);
+
+    if (ulCycles > aulCriticalSectionCycles[ulTag])
+    {
+        aulCriticalSectionCycles[ulTag] = ulCycles;
+    }
+    taskEXIT_CRITICAL();
+}
+
+static void prvWatchdogService(void)
+{
+#if(ENABLE_WATCHDOG == TRUE)
+    if (Supervisor_Check(xTaskGetTickCount()) == TRUE)
+    {
+        WDT_Feed();
+    }
+#endif
+}
+
+static void prvSendLatency(uint8 ucSource)
+{
+    UART0_SendString("Latency ");
+    UART0_SendString(pcLatencyNames[ucSource]);
+    UART0_SendString(" p50/p90/p99/max: ");
+    UART0_SendInteger(Latency_Percentile(ucSource, 50));
+    UART0_SendString(" / ");
+    UART0_SendInteger(Latency_Percentile(ucSource, 90));
+    UART0_SendString(" / ");
+    UART0_SendInteger(Latency_Percentile(ucSource, 99));
+    UART0_SendString(" / ");
+    UART0_SendInteger(Latency_GetMax(ucSource));
+    UART0_SendString(" cycles (");
+    UART0_SendInteger(Latency_GetCount(ucSource));
+    UART0_SendString(" samples)\r\n");
+}
+
+/* The heap is sized in FreeRTOSConfig.h for the tasks and queues created here, a failed
+ * allocation means they no longer fit: stop with every heater off */
+void vApplicationMallocFailedHook(void)
+{
+    TaskID xSeat;
+
+    taskDISABLE_INTERRUPTS();
+    for (xSeat = DriverTask; xSeat < mainNUM_SEATS; xSeat++)
+    {
+        Heater_SetPower(xSeatConfig[xSeat].xHeater, 0);
+    }
+    for (;;)
+        ;
+}
+
+static void prvWatchdogTimeout(void)
+{
+    TaskID xSeat;
+
+    /* A task stopped beating, don't leave any heater in its last state until the reset */
+    bHeatersInhibited = TRUE;
+    for (xSeat = DriverTask; xSeat < mainNUM_SEATS; xSeat++)
+    {
+        Heater_SetPower(xSeatConfig[xSeat].xHeater, 0);
+    }
+}
+
+static void prvAdcThroughput(void)
+{
+    uint8 ucAveraging;
+    uint8 ucCount;
+    uint32 ulStart;
+    uint32 ulCycles;
+    uint32 ulErrors;
+    uint16 usCode, usMin, usMax;
+
+    /* One line per setting: ADC,hardware averaging (log2),oversampling bits,cycles per reading,
+     * lowest and highest raw code of a steady input, conversions that returned no sample */
+    UART0_SendString("\r\nADC cost per reading: ADC,SAC,OversampleBits,Cycles,MinCode,MaxCode,Errors\r\n");
+    for (ucAveraging = 0; ucAveraging <= ADC_MAX_HW_AVERAGING; ucAveraging++)
+    {
+        ADC_SetHardwareAveraging(ucAveraging);
+        ulStart = Latency_Timestamp();
+        for (ucCount = 0; ucCount < mainADC_BENCHMARK_READS; ucCount++)
+        {
+            (void)ADC_to_Temperature(xSeatConfig[DriverTask].ucAdcChannel);
+        }
+        ulCycles = (Latency_Timestamp() - ulStart) / mainADC_BENCHMARK_READS;
+
+        /* Peak-to-peak noise of single conversions at this setting */
+        ulErrors = ADC_GetReadErrors();
+        usMin = 0xFFFF;
+        usMax = 0;
+        for (ucCount = 0; ucCount < mainADC_NOISE_SAMPLES; ucCount++)
+        {
+            usCode = ADC_ConvertChannel(xSeatConfig[DriverTask].ucAdcChannel);
+            usMin = (usCode < usMin) ? usCode : usMin;
+            usMax = (usCode > usMax) ? usCode : usMax;
+        }
+        ulErrors = ADC_GetReadErrors() - ulErrors;
+
+        UART0_SendString("ADC,");
+        UART0_SendInteger(ucAveraging);
+        UART0_SendString(",");
+        UART0_SendInteger(POT_OVERSAMPLE_BITS);
+        UART0_SendString(",");
+        UART0_SendInteger(ulCycles);
+        UART0_SendString(",");
+        UART0_SendInteger(usMin);
+        UART0_SendString(",");
+        UART0_SendInteger(usMax);
+        UART0_SendString(",");
+        UART0_SendInteger(ulErrors);
+        UART0_SendString("\r\n");
+    }
+}
+
+#if (ENABLE_MICRO_BENCHMARK == TRUE)
+void vBenchmarkTask(void *pvParameters)
+{
+    Bench_Result_t xResult;
+
+    xBenchSemaphore = xSemaphoreCreateBinary();
+    xBenchEvents = xEventGroupCreate();
+    PID_Init(&xBenchPID, &xHeatingGains[MEDIUM]);
+    xTaskCreate(vBenchmarkPeerTask, "Benchmark peer", configMINIMAL_STACK_SIZE, NULL, mainBENCHMARK_PRIORITY, &xBenchmarkPeerHandle);
+
+    xSemaphoreTake(xMutex, portMAX_DELAY);
+    UART0_SendString("\r\nMicro-benchmarks: BENCH,Name,Runs,MinCycles,AvgCycles,MaxCycles\r\n");
+
+    Bench_Run(&xResult, "ADC_to_Temperature", prvBenchAdc, mainBENCHMARK_RUNS);
+    prvSendBench(&xResult);
+
+    /* The formatted digits land on a comment line of their own */
+    UART0_SendString("# ");
+    Bench_Run(&xResult, "UART0_SendInteger", prvBenchUartInteger, mainBENCHMARK_UART_RUNS);
+    UART0_SendString("\r\n");
+    prvSendBench(&xResult);
+
+    Bench_Run(&xResult, "ControlDecision", prvBenchControl, mainBENCHMARK_RUNS);
+    prvSendBench(&xResult);
+
+    Bench_Run(&xResult, "EventGroupSetWait", prvBenchEventGroup, mainBENCHMARK_RUNS);
+    prvSendBench(&xResult);
+
+    Bench_Run(&xResult, "SemaphoreGiveTake", prvBenchSemaphore, mainBENCHMARK_RUNS);
+    prvSendBench(&xResult);
+
+    /* Two switches and a notification each way, the trace hooks of the run time measurements included.
+     * The peer has the same priority, so every switch happens when one of the two blocks. */
+    Bench_Run(&xResult, "ContextSwitchPair", prvBenchContextSwitch, mainBENCHMARK_RUNS);
+    prvSendBench(&xResult);
+    xSemaphoreGive(xMutex);
+
+    /* heap_1 never frees: the peer stays blocked on its notification and this task
+     * suspends, their stacks and the benchmark objects remain allocated */
+    vTaskSuspend(NULL);
+}
+
+void vBenchmarkPeerTask(void *pvParameters)
+{
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        xTaskNotifyGive(xBenchmarkTaskHandle);
+    }
+}
+
+static void prvBenchAdc(void)
+{
+    ulBenchResult = ADC_to_Temperature(xSeatConfig[DriverTask].ucAdcChannel);
+}
+
+static void prvBenchUartInteger(void)
+{
+    UART0_SendInteger(12345);
+}
+
+/* The per seat work of the control task: gains, PID update and duty in percent */
+static void prvBenchControl(void)
+{
+    uint16 usDuty;
+
+    usBenchTemp = (usBenchTemp + 7) % TEMP_RANGE_TENTHS;
+    PID_SetGains(&xBenchPID, &xHeatingGains[MEDIUM]);
+    usDuty = PID_Update(&xBenchPID, mainSET_POINT(MEDIUM), usBenchTemp, PID_DT_ONE);
+    ulBenchResult = (usDuty * 100UL + (PID_Q15_ONE / 2)) / PID_Q15_ONE;
+}
+
+static void prvBenchEventGroup(void)
+{
+    xEventGroupSetBits(xBenchEvents, 0x01);
+    ulBenchResult = xEventGroupWaitBits(xBenchEvents, 0x01, pdTRUE, pdFALSE, 0);
+}
+
+static void prvBenchSemaphore(void)
+{
+    xSemaphoreGive(xBenchSemaphore);
+    ulBenchResult = xSemaphoreTake(xBenchSemaphore, 0);
+}
+
+static void prvBenchContextSwitch(void)
+{
+    xTaskNotifyGive(xBenchmarkPeerHandle);
+    ulBenchResult = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+static void prvSendBench(const Bench_Result_t *pxResult)
+{
+    UART0_SendString("BENCH,");
+    UART0_SendString(pxResult->pcName);
+    UART0_SendString(",");
+    UART0_SendInteger(pxResult->ulRuns);
+    UART0_SendString(",");
+    UART0_SendInteger(pxResult->ulMin);
+    UART0_SendString(",");
+    UART0_SendInteger(pxResult->ulAverage);
+    UART0_SendString(",");
+    UART0_SendInteger(pxResult->ulMax);
+    UART0_SendString("\r\n");
+#if (ENABLE_WATCHDOG == TRUE)
+    /* The supervised tasks wait for the whole suite, their first beats come after it */
+    WDT_Feed();
+#endif
+}
+#endif
+
+static boolean prvSendDeadlines(uint8 ucTag)
+{
+    if (xPeriodic[ucTag].ulJobs == 0)
+    {
+        return FALSE;
+    }
+    UART0_SendString(xPeriodic[ucTag].pcName);
+    UART0_SendString(" deadline misses: ");
+    UART0_SendInteger(xPeriodic[ucTag].ulMisses);
+    UART0_SendString(" / ");
+    UART0_SendInteger(xPeriodic[ucTag].ulJobs);
+    UART0_SendString(" jobs, max response: ");
+    UART0_SendInteger(xPeriodic[ucTag].xMaxResponse);
+    UART0_SendString(" msec, max lateness: ");
+    UART0_SendInteger(xPeriodic[ucTag].xMaxLateness);
+    UART0_SendString(" msec\r\n");
+    return TRUE;
+}
+
+static void prvDeadlineMiss(Periodic_Task_t *pxTask, TickType_t xLateness)
+{
+    /* Only the first miss of a task reaches the diagnostics, the rest are counted */
+    if (pxTask->ulMisses != 1)
+    {
+        return;
+    }
+
+    prvRaiseDiagnostic(GPTM_WTimer0Read(), (uint8 *)pxTask->pcName, OFF, pxTask->ucId, FAULT_DEADLINE_MISS);
+}
+
+#if (ENABLE_PLANT_SIMULATION == TRUE)
+static void prvPlantAdvance(TaskID xSeat)
+{
+    TickType_t xNow = xTaskGetTickCount();
+
+    Plant_Advance(&xSeatPlant[xSeat], (xNow - xPlantTick[xSeat]) * portTICK_PERIOD_MS * mainPLANT_TIME_SCALE);
+    xPlantTick[xSeat] = xNow;
+}
+
+static uint16 prvPlantAdcInput(uint8 ucChannel)
+{
+    (void)ucChannel;
+    prvPlantAdvance(xAdcSeat);
+    return Plant_ReadSensor(&xSeatPlant[xAdcSeat]);
+}
+
+static void prvSendPlant(uint8 ucLine, uint32 ulBusyTicks)
+{
+    TaskID xSeat = (TaskID)(ucLine - 1);
+    uint32 ulSettling;
+    uint64 ullSimMs = xSeatPlant[DriverTask].ullTimeMs;
+
+    /* Busy time is in WTimer0 ticks of 0.1 msec */
+    if (ucLine == 0)
+    {
+        UART0_SendString("Simulated: ");
+        UART0_SendInteger((sint64)(ullSimMs / 1000));
+        UART0_SendString(" sec, CPU per simulated hour: ");
+        UART0_SendInteger((ullSimMs == 0) ? 0 : (sint64)(((uint64)ulBusyTicks * 360000ULL) / ullSimMs));
+        UART0_SendString(" msec\r\n");
+        return;
+    }
+
+    UART0_SendString(xSeatConfig[xSeat].pcName);
+    UART0_SendString(": temp ");
+    UART0_SendInteger(Plant_GetTemperature(&xSeatPlant[xSeat]) / 10);
+    UART0_SendString(".");
+    UART0_SendInteger(Plant_GetTemperature(&xSeatPlant[xSeat]) % 10);
+    UART0_SendString(", target ");
+    UART0_SendInteger(xSeatPlant[xSeat].usTarget / 10);
+    UART0_SendString(".");
+    UART0_SendInteger(xSeatPlant[xSeat].usTarget % 10);
+    UART0_SendString(", overshoot ");
+    UART0_SendInteger(xSeatPlant[xSeat].sOvershoot / 10);
+    UART0_SendString(".");
+    UART0_SendInteger(xSeatPlant[xSeat].sOvershoot % 10);
+    UART0_SendString(", settling ");
+    ulSettling = Plant_GetSettlingMs(&xSeatPlant[xSeat]);
+    if (ulSettling == PLANT_NOT_SETTLED)
+    {
+        UART0_SendString("-");
+    }
+    else
+    {
+        UART0_SendInteger(ulSettling / 1000);
+    }
+    UART0_SendString(" sec, energy ");
+    UART0_SendInteger((sint64)(xSeatPlant[xSeat].ullEnergyUj / 3600000ULL));
+    UART0_SendString(" mWh\r\n");
+}
+#endif
+
+#if (ENABLE_TRACE_CAPTURE == TRUE)
+static uint16 prvTraceCaptureInput(uint8 ucChannel)
+{
+    uint16 usCode = ADC_ConvertChannel(ucChannel);
+
+    ulTraceSum += usCode;
+    return usCode;
+}
+#endif
+
+#if (ENABLE_TRACE_REPLAY == TRUE)
+static uint16 prvTraceReplayInput(uint8 ucChannel)
+{
+    Trace_Record_t xRecord;
+    uint32 ulConversions = 1UL << (2 * POT_OVERSAMPLE_BITS);
+    uint16 usCode;
+
+    (void)ucChannel;
+    if (ucTraceConversion == 0)
+    {
+        /* First conversion of a reading: the next captured reading of this seat */
+        if (Trace_NextAdc(xAdcSeat, &xRecord) == TRUE)
+        {
+            aulTraceReplaySum[xAdcSeat] = (uint32)xRecord.usValue << POT_OVERSAMPLE_BITS;
+        }
+        ulTraceRemaining = aulTraceReplaySum[xAdcSeat];
+    }
+
+    /* Split the captured sum over the conversions, ADC_ReadOversampled adds it back up exactly */
+    usCode = (uint16)(ulTraceRemaining / (ulConversions - ucTraceConversion));
+    ulTraceRemaining -= usCode;
+    ucTraceConversion = (uint8)((ucTraceConversion + 1) % ulConversions);
+    return usCode;
+}
+
+static void prvTraceReplayGestures(void)
+{
+    Trace_Record_t xRecord;
+    ButtonEvent_t xEvent;
+    uint32 ulCriticalStart;
+    boolean bDue;
+
+    for (;;)
+    {
+        /* The replay cursors are shared with the other sensor tasks */
+        ulCriticalStart = prvCriticalEnter();
+        bDue = Trace_NextButton(&xRecord);
+        prvCriticalExit(ulCriticalStart);
+        if (bDue == FALSE)
+        {
+            break;
+        }
+
+        /* Gestures captured before the reading reach the level task before its sample is processed,
+         * blocking rather than dropping one keeps the decisions of the replay those of the capture */
+        xEvent.xSeat = (TaskID)xRecord.ucSource;
+        xEvent.eGesture = (Button_GestureType)xRecord.usValue;
+        xEvent.ulTimeStamp = xRecord.ulTimeStamp;
+        xEvent.ulIsrCycles = Latency_Timestamp();
+        xEvent.ucSetLevel = mainLEVEL_FROM_GESTURE;
+        xQueueSend(xButtonQueue, &xEvent, portMAX_DELAY);
+    }
+}
+#endif
+
+static void prvRaiseDiagnostic(uint32 ulTimeStamp, uint8 *pcName, HeatingLevel_t xLevel, uint8 ucSource, FaultCode_t xCode)
+{
+    DiagonsticsType xEntry;
+    uint32 ulCriticalStart;
+
+    xEntry.FailureTimeStamp = ulTimeStamp;
+    xEntry.pcCurrentSeat = pcName;
+    xEntry.xCurrentLevel = xLevel;
+    xEntry.ucSource = ucSource;
+    xEntry.xFaultCode = xCode;
+
+    /* The queue copies the entry, the raising tasks never share a slot and never wait */
+    if (xQueueSend(xDiagonsticsQueue, &xEntry, 0) != pdTRUE)
+    {
+        ulCriticalStart = prvCriticalEnter();
+        ulDiagonsticsLost++;
+        prvCriticalExit(ulCriticalStart);
+    }
+}
+
+void vDiagonsticsTask(void *pvParameters)
+{
+    FaultRecord_t xRecord;
+    DiagonsticsType xEntry;
+    uint16 usIndex;
+
+    /* Report the failures that survived the last reset. A full log takes seconds at 9600 baud,
+     * so every record is a separate UART mutex hold and the other UART users, the run time
+     * task feeding the watchdog among them, get the UART in between. */
+    if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE)
+    {
+        ullResourceLockimeIn[mainDIAGONSTICS_TAG] = GPTM_WTimer0Read();
+        if (WDT_CausedReset() == TRUE)
+        {
+            UART0_SendString("\r\nLast reset caused by the watchdog");
+        }
+        if (FaultLog_IsMounted() == FALSE)
+        {
+            UART0_SendString("\r\nFault log unavailable, the EEPROM failed to start\r\n");
+        }
+        else
+        {
+            UART0_SendString("\r\nStored Failures: ");
+            UART0_SendInteger(FaultLog_GetCount());
+            UART0_SendString("\r\nFailure Time Stamp(ms):\t\tSeat:\t\tHeating Level:\t\tCode:\r\n");
+        }
+        prvUartGive(mainDIAGONSTICS_TAG);
+    }
+    for (usIndex = 0; usIndex < FaultLog_GetCount(); usIndex++)
+    {
+        if ((FaultLog_Read(usIndex, &xRecord) == TRUE) && (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE))
+        {
+            ullResourceLockimeIn[mainDIAGONSTICS_TAG] = GPTM_WTimer0Read();
+            UART0_SendInteger(xRecord.ulTimeStamp);
+            UART0_SendString("\t\t\t\t");
+            UART0_SendInteger(xRecord.ucSeat);
+            UART0_SendString("\t\t");
+            UART0_SendInteger(xRecord.ucLevel);
+            UART0_SendString("\t\t");
+            UART0_SendInteger(xRecord.ucCode);
+            UART0_SendString("\r\n");
+            prvUartGive(mainDIAGONSTICS_TAG);
+        }
+    }
+
+    for (;;)
+    {
+        if (xQueueReceive(xDiagonsticsQueue, &xEntry, portMAX_DELAY) != pdTRUE)
+        {
+            continue;
+        }
+
+        if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE)
+        {
+            ullResourceLockimeIn[mainDIAGONSTICS_TAG] = GPTM_WTimer0Read();
+            UART0_SendString("\r\n");
+            UART0_SendString(pcFaultNames[xEntry.xFaultCode]);
+            UART0_SendString(":\r\n");
+            UART0_SendString("\r\nFailure Time Stamp(ms):\t\tSeat:\t\tHeating Level:\r\n");
+            UART0_SendString("------------------------------------------------------------\r\n");
+            UART0_SendInteger(xEntry.FailureTimeStamp);
+            UART0_SendString("\t\t\t\t");
+            UART0_SendString(xEntry.pcCurrentSeat);
+            UART0_SendString("\t\t");
+            UART0_SendInteger(xEntry.xCurrentLevel);
+            UART0_SendString("\r\n");
+            if (ulDiagonsticsLost != 0)
             {
-                UART0_SendString("\r\nTemprature Sensor Disabled:\r\n");
-                UART0_SendString("\r\nFailure Time Stamp(ms):\t\tSeat:\t\tHeating Level:\r\n");
-                UART0_SendString("------------------------------------------------------------\r\n");
-                UART0_SendInteger(Diagonstics[usCounter].FailureTimeStamp);
-                UART0_SendString("\t\t\t\t");
-                UART0_SendString(Diagonstics[usCounter].pcCurrentSeat);
-                UART0_SendString("\t\t");
-                UART0_SendInteger(Diagonstics[usCounter].xCurrentLevel);
+                UART0_SendString("Diagnostics lost on a full queue: ");
+                UART0_SendInteger(ulDiagonsticsLost);
                 UART0_SendString("\r\n");
-                usCounter++;
             }
-            ullResourceLockimeOut[4] = GPTM_WTimer0Read();
+            prvUartGive(mainDIAGONSTICS_TAG);
+        }
+
+        /* The EEPROM write happens outside the UART mutex, and only on a mounted log */
+        if (FaultLog_IsMounted() == TRUE)
+        {
+            xRecord.ulTimeStamp = xEntry.FailureTimeStamp;
+            xRecord.ucCode = xEntry.xFaultCode;
+            xRecord.ucSeat = xEntry.ucSource;
+            xRecord.ucLevel = xEntry.xCurrentLevel;
+            FaultLog_Append(&xRecord);
+        }
+        usCounter++;
+    }
+}
+
+void vConsoleTask(void *pvParameters)
+{
+    uint8 ucByte;
+
+    for (;;)
+    {
+        /* One notification may stand for several bytes, drain the ring each time */
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (UART0_ReadByte(&ucByte) == TRUE)
+        {
+            if (Console_ProcessByte(ucByte) == FALSE)
+            {
+                continue;
+            }
+            if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE)
+            {
+                ullResourceLockimeIn[mainCONSOLE_TAG] = GPTM_WTimer0Read();
+                Console_Execute();
+                prvUartGive(mainCONSOLE_TAG);
+            }
+        }
+    }
+}
+
+static void prvConsoleReceived(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    if (xConsoleTaskHandle == NULL)
+    {
+        return;
+    }
+    vTaskNotifyGiveFromISR(xConsoleTaskHandle, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+static void prvCommandLevel(uint8 ucArgc, uint8 *apcArgv[])
+{
+    uint32 ulSeat;
+    uint32 ulLevel;
+    ButtonEvent_t xEvent;
+
+    if ((ucArgc != 3) || (Console_ParseNumber(apcArgv[1], &ulSeat) == FALSE) || (ulSeat >= mainNUM_SEATS) ||
+        (Console_ParseNumber(apcArgv[2], &ulLevel) == FALSE) || (ulLevel > HIGH))
+    {
+        UART0_SendString("Usage: level <seat> <0-3>\r\n");
+        return;
+    }
+
+    /* The level setting task stays the only writer of the levels */
+    xEvent.xSeat = (TaskID)ulSeat;
+    xEvent.eGesture = BUTTON_SHORT_PRESS;
+    xEvent.ulTimeStamp = GPTM_WTimer0Read();
+    xEvent.ulIsrCycles = 0;
+    xEvent.ucSetLevel = (uint8)ulLevel;
+    UART0_SendString((xQueueSend(xButtonQueue, &xEvent, 0) == pdTRUE) ? "OK\r\n" : "Busy\r\n");
+}
+
+static void prvCommandGet(uint8 ucArgc, uint8 *apcArgv[])
+{
+    TaskID xSeat;
+
+    for (xSeat = DriverTask; xSeat < mainNUM_SEATS; xSeat++)
+    {
+        UART0_SendInteger(xSeat);
+        UART0_SendString(" ");
+        UART0_SendString(xSeatConfig[xSeat].pcName);
+        UART0_SendString(": temp ");
+        UART0_SendInteger(SeatInfo[xSeat].usCurrentTemp / 10);
+        UART0_SendString(".");
+        UART0_SendInteger(SeatInfo[xSeat].usCurrentTemp % 10);
+        UART0_SendString(", level ");
+        UART0_SendInteger(SeatInfo[xSeat].xCurrentLevel);
+        UART0_SendString(", duty ");
+        UART0_SendInteger(SeatInfo[xSeat].ucHeaterDuty);
+        UART0_SendString("%, sensor ");
+        UART0_SendString(pcSensorStateNames[xSeatSensor[xSeat].eState]);
+        UART0_SendString("\r\n");
+    }
+}
+
+static void prvCommandStats(uint8 ucArgc, uint8 *apcArgv[])
+{
+    uint8 ucCounter;
+
+    for (ucCounter = 0; ucCounter < mainLATENCY_SOURCES; ucCounter++)
+    {
+        prvSendLatency(ucCounter);
+        prvUartHandOver();
+    }
+    for (ucCounter = 1; ucCounter < mainNUM_TAGS; ucCounter++)
+    {
+        if (prvSendDeadlines(ucCounter) == TRUE)
+        {
+            prvUartHandOver();
         }
     }
+    UART0_SendString("Console bytes lost: ");
+    UART0_SendInteger(UART0_GetRxOverruns());
+    UART0_SendString(", ADC reads without a sample: ");
+    UART0_SendInteger(ADC_GetReadErrors());
+    UART0_SendString("\r\n");
+}
+
+#if mainTRACE_ENABLED
+static void prvCommandTrace(uint8 ucArgc, uint8 *apcArgv[])
+{
+    TaskID xSeat;
+#if (ENABLE_TRACE_CAPTURE == TRUE)
+    Trace_Record_t xRecord;
+    uint32 ulFirst = 0;
+    uint16 usIndex;
+#endif
+
+    for (xSeat = DriverTask; xSeat < mainNUM_SEATS; xSeat++)
+    {
+        UART0_SendString("DIGEST,");
+        UART0_SendString(xSeatConfig[xSeat].pcName);
+        UART0_SendString(",");
+        UART0_SendInteger(aulDecisionDigest[xSeat]);
+        UART0_SendString("\r\n");
+    }
+#if (ENABLE_TRACE_REPLAY == TRUE)
+    UART0_SendString("Replayed ");
+    UART0_SendInteger(Trace_GetReplayed());
+    UART0_SendString(" / ");
+    UART0_SendInteger(usTraceReplayCount);
+    UART0_SendString(" records\r\n");
+#else
+    /* A chunk at a time, every line is a record of the replay table */
+    if (ucArgc > 1 && Console_ParseNumber(apcArgv[1], &ulFirst) == FALSE)
+    {
+        UART0_SendString("Bad index\r\n");
+        return;
+    }
+    UART0_SendString("TRACE,");
+    UART0_SendInteger(Trace_GetCount());
+    UART0_SendString(",");
+    UART0_SendInteger(Trace_GetDropped());
+    UART0_SendString("\r\n");
+    for (usIndex = (uint16)ulFirst; usIndex < ulFirst + mainTRACE_DUMP_CHUNK; usIndex++)
+    {
+        if (Trace_Read(usIndex, &xRecord) == FALSE)
+        {
+            break;
+        }
+        UART0_SendString("    {");
+        UART0_SendInteger(xRecord.ulTimeStamp);
+        UART0_SendString((xRecord.ucType == TRACE_EVENT_ADC) ? ", TRACE_EVENT_ADC, " : ", TRACE_EVENT_BUTTON, ");
+        UART0_SendInteger(xRecord.ucSource);
+        UART0_SendString(", ");
+        UART0_SendInteger(xRecord.usValue);
+        UART0_SendString("},\r\n");
+        prvUartHandOver();
+    }
+    if (usIndex < Trace_GetCount())
+    {
+        UART0_SendString("More: trace ");
+        UART0_SendInteger(usIndex);
+        UART0_SendString("\r\n");
+    }
+#endif
+}
+#endif
+
+static void prvCommandMode(uint8 ucArgc, uint8 *apcArgv[])
+{
+    if ((ucArgc == 2) && (Console_Match(apcArgv[1], "lines") == TRUE))
+    {
+        Display_SetMode(DISPLAY_MODE_LINES);
+    }
+    else if ((ucArgc == 2) && (Console_Match(apcArgv[1], "dash") == TRUE))
+    {
+        Display_SetMode(DISPLAY_MODE_DASHBOARD);
+    }
+    else
+    {
+        UART0_SendString("Usage: mode <lines|dash>\r\n");
+    }
 }
 
 void GPIOPortF_Handler(void)
 {
-    BaseType_t pxHigherPriorityTaskWoken = pdFALSE;
-    if(GPIO_PORTF_RIS_REG & (1<<0))           /* PF0 handler code Driver - Seat SW2 */
+    uint32 ulEntry = Latency_Timestamp();
+    uint32 ulCycles;
+    BaseType_t xHigherPriorityTaskWoken;
+
+    if (ulPortFPendCycle != 0)
     {
-        xEventGroupSetBitsFromISR(xButtonEvent, mainDRIVER_INTERRUPT_BIT,&pxHigherPriorityTaskWoken);
-        GPIO_PORTF_ICR_REG   |= (1<<0);       /* Clear Trigger flag for PF0 (Interrupt Flag) */
+        Latency_RecordCycles(mainLATENCY_PORTF_ENTRY, ulEntry - ulPortFPendCycle);
+        ulPortFPendCycle = 0;
     }
-    else if(GPIO_PORTF_RIS_REG & (1<<4))      /* PF0 handler code Passenger - Seat SW1 */
+
+    /* Every pending pin is serviced in this entry, the button callbacks debounce them */
+    xHigherPriorityTaskWoken = (GPIO_PortFDispatch() == TRUE) ? pdTRUE : pdFALSE;
+
+    ulCycles = Latency_Timestamp() - ulEntry;
+    if (ulCycles > ulPortFIsrCyclesMax)
     {
-        xEventGroupSetBitsFromISR(xButtonEvent, mainPASSENGER_INTERRUPT_BIT,&pxHigherPriorityTaskWoken);
-        GPIO_PORTF_ICR_REG   |= (1<<4);       /* Clear Trigger flag for PF4 (Interrupt Flag) */
+        ulPortFIsrCyclesMax = ulCycles;
     }
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
 
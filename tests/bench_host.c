@@ -0,0 +1,205 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: bench_host.c
+ *
+ * Description: host build of the micro-benchmarks of the hardware independent hot paths.
+ *              Prints the BENCH lines of the firmware, in nanoseconds instead of cycles, so
+ *              the same parser collects both per commit.
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "adc.h"
+#include "potentiometer.h"
+#include "bench.h"
+#include "latency.h"
+#include "filter.h"
+#include "pid.h"
+#include "sensor_fault.h"
+#include "app_params.h"
+#include "seat_model.h"
+#include "fault_log.h"
+#include "eeprom_stub.h"
+
+#define BENCH_DEFAULT_RUNS 100000UL
+
+static PID_Controller_t xBenchPID;
+static Filter_t xBenchFilter;
+static SensorFault_t xBenchSensor;
+static uint16 usBenchTemp = 0;
+static volatile uint32 ulBenchResult;
+
+/* A steady input with the spread of the sensor noise */
+uint16 ADC_ReadOversampled(uint8 ucChannel, uint8 ucExtraBits)
+{
+    uint32 ulSum = 0;
+    uint16 usCount;
+
+    for (usCount = 0; usCount < (1U << (2 * ucExtraBits)); usCount++)
+    {
+        ulSum += 2000U + ((usCount * 7U + ucChannel) % 9U);
+    }
+    return (uint16)(ulSum >> ucExtraBits);
+}
+
+static void prvBenchAdc(void)
+{
+    ulBenchResult = ADC_to_Temperature(2);  /* AIN2, the driver seat */
+}
+
+/* The per seat work of the control task: gains, PID update and duty in percent */
+static void prvBenchControl(void)
+{
+    uint16 usDuty;
+
+    usBenchTemp = (usBenchTemp + 7) % TEMP_RANGE_TENTHS;
+    PID_SetGains(&xBenchPID, &axAppGains[2]);
+    usDuty = PID_Update(&xBenchPID, APP_SET_POINT(2), usBenchTemp, PID_DT_ONE);
+    ulBenchResult = (usDuty * 100UL + (PID_Q15_ONE / 2)) / PID_Q15_ONE;
+}
+
+static void prvBenchFilter(void)
+{
+    usBenchTemp = (usBenchTemp + 7) % TEMP_RANGE_TENTHS;
+    ulBenchResult = Filter_Update(&xBenchFilter, usBenchTemp);
+}
+
+static void prvBenchSensorFault(void)
+{
+    usBenchTemp = (usBenchTemp + 7) % TEMP_RANGE_TENTHS;
+    ulBenchResult = SensorFault_Update(&xBenchSensor, usBenchTemp);
+}
+
+/* Fault log work on a full ring of the RAM backed EEPROM: only the CPU side of the driver,
+ * the programming time of the EEPROM of the target comes on top of every written word */
+static void prvBenchFaultAppend(void)
+{
+    FaultRecord_t xRecord;
+
+    xRecord.ulTimeStamp = ulBenchResult++;
+    xRecord.ucCode = FAULT_SENSOR_HIGH;
+    xRecord.ucSeat = 1;
+    xRecord.ucLevel = 2;
+    FaultLog_Append(&xRecord);
+}
+
+static void prvBenchFaultMount(void)
+{
+    FaultLog_Init();
+    ulBenchResult = FaultLog_GetCount();
+}
+
+/* The boot dump: every record from the oldest one */
+static void prvBenchFaultScan(void)
+{
+    FaultRecord_t xRecord;
+    uint16 usIndex;
+
+    for (usIndex = 0; usIndex < FaultLog_GetCount(); usIndex++)
+    {
+        FaultLog_Read(usIndex, &xRecord);
+    }
+    ulBenchResult = xRecord.ulTimeStamp;
+}
+
+static void prvPrint(const Bench_Result_t *pxResult)
+{
+    printf("BENCH,%s,%u,%u,%u,%u\n", (const char *)pxResult->pcName, (unsigned)pxResult->ulRuns,
+           (unsigned)pxResult->ulMin, (unsigned)pxResult->ulAverage, (unsigned)pxResult->ulMax);
+}
+
+/* One job of a sensor task: conversion, fault detection and filter */
+static void prvBenchReading(void)
+{
+    uint16 usTemp = ADC_to_Temperature(2);
+
+    if (SensorFault_Update(&xBenchSensor, usTemp) == SENSOR_OK)
+    {
+        usTemp = Filter_Update(&xBenchFilter, usTemp);
+    }
+    ulBenchResult = usTemp;
+}
+
+/* The per seat work of the heater task: the intensity of the commanded duty */
+static void prvBenchHeater(void)
+{
+    static const char *const apcIntensity[] = { "DISABLED", "LOW", "MEDIUM", "HIGH" };
+    uint8 ucDuty = (uint8)(ulBenchResult % 101);
+
+    ulBenchResult = (uint32)(uintptr_t)apcIntensity[(ucDuty == 0) ? 0 : ((ucDuty <= 33) ? 1 : ((ucDuty <= 66) ? 2 : 3))];
+}
+
+/* Processor load and control latency from 2 to MODEL_MAX_SEATS seats with the average measured
+ * costs. The maxima of a PC are the preemptions by its operating system, the worst cases of the
+ * target come from the RTA of the firmware. */
+static void prvSeatScaling(uint32 ulRuns)
+{
+    Bench_Result_t xReading;
+    Bench_Result_t xControl;
+    Bench_Result_t xHeater;
+    Model_Costs_t xCosts;
+    Model_Result_t xResult;
+    uint64 ullLoad;
+    uint8 ucSeats;
+    uint8 ucSeat;
+
+    Bench_Run(&xReading, (const uint8 *)"SensorReading", prvBenchReading, ulRuns);
+    prvPrint(&xReading);
+    Bench_Run(&xControl, (const uint8 *)"ControlDecision", prvBenchControl, ulRuns);
+    Bench_Run(&xHeater, (const uint8 *)"HeaterCommand", prvBenchHeater, ulRuns);
+    prvPrint(&xHeater);
+    xCosts.ulSensorJob = xReading.ulAverage;
+    xCosts.ulControlSeat = xControl.ulAverage;
+    xCosts.ulHeaterSeat = xHeater.ulAverage;
+
+    printf("SEATS,Seats,LoadPpb,ControlResponseNs,WorstIntervalUs,WorstAgeUs\n");
+    for (ucSeats = 2; ucSeats <= MODEL_MAX_SEATS; ucSeats++)
+    {
+        ullLoad = 0;
+        for (ucSeat = 0; ucSeat < ucSeats; ucSeat++)
+        {
+            ullLoad += ((uint64)xReading.ulAverage * 1000000000ULL) / (((ucSeat % 2) == 0) ? (40 * MODEL_MS) : (60 * MODEL_MS));
+        }
+        ullLoad += ((uint64)ucSeats * (xControl.ulAverage + xHeater.ulAverage) * 1000000000ULL) / MODEL_CONTROL_PERIOD;
+        Model_Run(ucSeats, MODEL_BATCHED, &xCosts, 60, &xResult);
+        printf("SEATS,%u,%lu,%lu,%lu,%lu\n", ucSeats, (unsigned long)ullLoad, (unsigned long)xResult.ulControlResponse,
+               (unsigned long)xResult.ulWorstInterval, (unsigned long)xResult.ulWorstAge);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Bench_Result_t xResult;
+    uint32 ulRuns = (argc > 1) ? (uint32)strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_RUNS;
+
+    Latency_Init();
+    PID_Init(&xBenchPID, &axAppGains[2]);
+    Filter_Init(&xBenchFilter, APP_MEDIAN_LENGTH, FILTER_Q15(APP_FILTER_ALPHA));
+    SensorFault_Init(&xBenchSensor, &xAppSensorFaultConfig);
+
+    printf("BENCH,Name,Runs,MinNs,AvgNs,MaxNs\n");
+    Bench_Run(&xResult, (const uint8 *)"ADC_to_Temperature", prvBenchAdc, ulRuns);
+    prvPrint(&xResult);
+    Bench_Run(&xResult, (const uint8 *)"ControlDecision", prvBenchControl, ulRuns);
+    prvPrint(&xResult);
+    Bench_Run(&xResult, (const uint8 *)"Filter_Update", prvBenchFilter, ulRuns);
+    prvPrint(&xResult);
+    Bench_Run(&xResult, (const uint8 *)"SensorFault_Update", prvBenchSensorFault, ulRuns);
+    prvPrint(&xResult);
+
+    /* The mount and the scan walk the whole ring, so they get a fraction of the runs */
+    EEPROM_StubErase();
+    FaultLog_Init();
+    Bench_Run(&xResult, (const uint8 *)"FaultLog_Append", prvBenchFaultAppend, ulRuns);
+    prvPrint(&xResult);
+    Bench_Run(&xResult, (const uint8 *)"FaultLog_Mount", prvBenchFaultMount, (ulRuns / FAULT_LOG_CAPACITY) + 1);
+    prvPrint(&xResult);
+    Bench_Run(&xResult, (const uint8 *)"FaultLog_Scan", prvBenchFaultScan, (ulRuns / FAULT_LOG_CAPACITY) + 1);
+    prvPrint(&xResult);
+    prvSeatScaling(ulRuns);
+    return 0;
+}
@@ -0,0 +1,208 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: bench_signal.c
+ *
+ * Description: host benchmark of the sensor --> control --> heater signalling on the kernel,
+ *              the semaphore and command queue scheme against the task notifications of
+ *              main.c. Counts the context switches and times the signalling of a control pass.
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "latency.h"
+
+#define BENCH_DEFAULT_SECONDS   600
+#define BENCH_MAX_SEATS         16
+#define BENCH_CONTROL_PERIOD_MS 50
+
+/* Priorities of main.c */
+#define BENCH_TEMP_READING_PRIORITY     2
+#define BENCH_CONTROL_PRIORITY          2
+#define BENCH_HEATING_ELEMENT_PRIORITY  3
+
+#define BENCH_SEAT_NOTIFY_BIT(seat) (1UL << (seat))
+#define BENCH_ALL_NOTIFY_BITS 0xFFFFFFFFUL
+
+typedef enum
+{
+    BENCH_SCHEME_QUEUE,     /* Binary semaphore per sample, one command queue entry per seat */
+    BENCH_SCHEME_NOTIFY     /* Notification bit per sample, one notification per pass */
+} Bench_SchemeType;
+
+typedef struct
+{
+    uint8 ucSeat;
+    uint8 ucDuty;
+    uint16 usTemp;
+} Bench_Command_t;
+
+static Bench_SchemeType eScheme;
+static uint8 ucSeats;
+static TaskHandle_t xControlHandle;
+static TaskHandle_t xHeaterHandle;
+static QueueHandle_t axSampleQueue[BENCH_MAX_SEATS];
+static QueueHandle_t axDisplayQueue[BENCH_MAX_SEATS];
+static QueueHandle_t xCommandQueue;
+static SemaphoreHandle_t xTempToControlSync;
+static Bench_Command_t axCommand[BENCH_MAX_SEATS];
+
+static uint32 ulPasses = 0;
+static uint32 ulDecisions = 0;
+static uint32 ulSamples = 0;
+static uint32 ulPassSwitches = 0;
+static uint64 ullPassNs = 0;
+static uint64 ullSampleNs = 0;
+
+static void vTempReadingTask(void *pvParameters)
+{
+    uint8 ucSeat = (uint8)(uintptr_t)pvParameters;
+    TickType_t xWake = xTaskGetTickCount();
+    uint16 usTemp = 250;
+    uint32 ulStart;
+
+    for (;;)
+    {
+        /* The periods of the seat table, 40 and 60 msec */
+        vTaskDelayUntil(&xWake, pdMS_TO_TICKS(((ucSeat % 2) == 0) ? 40 : 60));
+        usTemp = (uint16)(250 + (usTemp + 7) % 11);
+
+        ulStart = Latency_Timestamp();
+        xQueueOverwrite(axSampleQueue[ucSeat], &usTemp);
+        if (eScheme == BENCH_SCHEME_QUEUE)
+        {
+            xSemaphoreGive(xTempToControlSync);
+        }
+        else
+        {
+            xTaskNotify(xControlHandle, BENCH_SEAT_NOTIFY_BIT(ucSeat), eSetBits);
+        }
+        ullSampleNs += (uint32)(Latency_Timestamp() - ulStart);
+        ulSamples++;
+    }
+}
+
+static void vControlTask(void *pvParameters)
+{
+    TickType_t xWake = xTaskGetTickCount();
+    uint32_t ulFresh = BENCH_ALL_NOTIFY_BITS;
+    uint32 ulSwitches;
+    uint32 ulStart;
+    uint16 usTemp;
+    uint8 ucSeat;
+
+    (void)pvParameters;
+    for (;;)
+    {
+        vTaskDelayUntil(&xWake, pdMS_TO_TICKS(BENCH_CONTROL_PERIOD_MS));
+
+        /* From here to the end of the pass the heater task also runs, it has the higher priority */
+        ulSwitches = ulHostContextSwitches;
+        ulStart = Latency_Timestamp();
+        if (eScheme == BENCH_SCHEME_NOTIFY)
+        {
+            xTaskNotifyWait(0, BENCH_ALL_NOTIFY_BITS, &ulFresh, 0);
+        }
+        for (ucSeat = 0; ucSeat < ucSeats; ucSeat++)
+        {
+            if ((ulFresh & BENCH_SEAT_NOTIFY_BIT(ucSeat)) != 0 && xQueueReceive(axSampleQueue[ucSeat], &usTemp, 0) == pdTRUE)
+            {
+                axCommand[ucSeat].usTemp = usTemp;
+            }
+            axCommand[ucSeat].ucSeat = ucSeat;
+            axCommand[ucSeat].ucDuty = (uint8)(axCommand[ucSeat].usTemp % 101);
+            if (eScheme == BENCH_SCHEME_QUEUE)
+            {
+                xQueueSend(xCommandQueue, &axCommand[ucSeat], 0);
+            }
+            ulDecisions++;
+        }
+        if (eScheme == BENCH_SCHEME_NOTIFY)
+        {
+            xTaskNotify(xHeaterHandle, (1UL << ucSeats) - 1UL, eSetBits);
+        }
+        ullPassNs += (uint32)(Latency_Timestamp() - ulStart);
+        ulPassSwitches += ulHostContextSwitches - ulSwitches;
+        ulPasses++;
+    }
+}
+
+static void vHeatingElementTask(void *pvParameters)
+{
+    Bench_Command_t xCommand;
+    uint32_t ulSeats;
+    uint8 ucSeat;
+
+    (void)pvParameters;
+    for (;;)
+    {
+        if (eScheme == BENCH_SCHEME_QUEUE)
+        {
+            xQueueReceive(xCommandQueue, &xCommand, portMAX_DELAY);
+            xQueueOverwrite(axDisplayQueue[xCommand.ucSeat], &xCommand);
+        }
+        else
+        {
+            xTaskNotifyWait(0, BENCH_ALL_NOTIFY_BITS, &ulSeats, portMAX_DELAY);
+            for (ucSeat = 0; ucSeat < ucSeats; ucSeat++)
+            {
+                if ((ulSeats & BENCH_SEAT_NOTIFY_BIT(ucSeat)) != 0)
+                {
+                    xQueueOverwrite(axDisplayQueue[ucSeat], &axCommand[ucSeat]);
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    uint32 ulSeconds = BENCH_DEFAULT_SECONDS;
+    uint8 ucSeat;
+
+    if (argc < 3 || (strcmp(argv[1], "queue") != 0 && strcmp(argv[1], "notify") != 0))
+    {
+        printf("usage: %s queue|notify <seats> [seconds]\n", argv[0]);
+        return 1;
+    }
+    eScheme = (strcmp(argv[1], "queue") == 0) ? BENCH_SCHEME_QUEUE : BENCH_SCHEME_NOTIFY;
+    ucSeats = (uint8)atoi(argv[2]);
+    if (ucSeats == 0 || ucSeats > BENCH_MAX_SEATS)
+    {
+        ucSeats = 2;
+    }
+    if (argc > 3)
+    {
+        ulSeconds = (uint32)strtoul(argv[3], NULL, 10);
+    }
+
+    xTempToControlSync = xSemaphoreCreateBinary();
+    xCommandQueue = xQueueCreate(ucSeats, sizeof(Bench_Command_t));
+    for (ucSeat = 0; ucSeat < ucSeats; ucSeat++)
+    {
+        axSampleQueue[ucSeat] = xQueueCreate(1, sizeof(uint16));
+        axDisplayQueue[ucSeat] = xQueueCreate(1, sizeof(Bench_Command_t));
+        xTaskCreate(vTempReadingTask, "Temp", configMINIMAL_STACK_SIZE, (void *)(uintptr_t)ucSeat,
+                    BENCH_TEMP_READING_PRIORITY, NULL);
+    }
+    xTaskCreate(vControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, BENCH_CONTROL_PRIORITY, &xControlHandle);
+    xTaskCreate(vHeatingElementTask, "Heater", configMINIMAL_STACK_SIZE, NULL, BENCH_HEATING_ELEMENT_PRIORITY, &xHeaterHandle);
+
+    vPortHostRun(pdMS_TO_TICKS(ulSeconds * 1000UL));
+
+    /* Switches x100 per pass and per decision, host nanoseconds of the signalling */
+    printf("SIGNAL,Scheme,Seats,Passes,SwitchesPerPassX100,SwitchesPerDecisionX100,PassNs,DecisionNs,SampleNs\n");
+    printf("SIGNAL,%s,%u,%lu,%lu,%lu,%lu,%lu,%lu\n", argv[1], ucSeats, (unsigned long)ulPasses,
+           (unsigned long)((ulPassSwitches * 100ULL) / ulPasses), (unsigned long)((ulPassSwitches * 100ULL) / ulDecisions),
+           (unsigned long)(ullPassNs / ulPasses), (unsigned long)(ullPassNs / ulDecisions),
+           (unsigned long)(ullSampleNs / ulSamples));
+    return 0;
+}
@@ -0,0 +1,20 @@
+/**********************************************************************************************
+ *
+ * Module: ADC
+ *
+ * File Name: adc.h
+ *
+ * Description: host stand-in for the ADC driver, the test supplies the conversions
+ *
+ * Author: Youssef khaled
+ *
+ ***********************************************************************************************/
+#ifndef ADC_H_
+#define ADC_H_
+
+#include "std_types.h"
+
+// Oversample and decimate: 4^ucExtraBits conversions summed, result has 12 + ucExtraBits bits
+uint16 ADC_ReadOversampled(uint8 ucChannel, uint8 ucExtraBits);
+
+#endif /* ADC_H_ */
@@ -0,0 +1,43 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: app_params.h
+ *
+ * Description: copies of the main.c and APP/seat_config.h parameters that the host tests
+ *              and the host simulator run the APP modules with
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef APP_PARAMS_H_
+#define APP_PARAMS_H_
+
+#include "pid.h"
+#include "plant.h"
+#include "sensor_fault.h"
+
+/* Tenths of a degree */
+#define APP_SET_POINT(level)        (200 + ((level) * 50))
+
+#define APP_CONTROL_PERIOD_MS       50
+
+/* Driver seat entry of the seat table */
+#define APP_SENSOR_PERIOD_MS        40
+#define APP_MEDIAN_LENGTH           5
+#define APP_FILTER_ALPHA            0.25
+
+static const PID_Gains_t axAppGains[] =
+{
+    { PID_Q15(0.0),   PID_KI(0.0),      PID_Q15(0.0)   },   /* OFF    */
+    { PID_Q15(0.008), PID_KI(0.0004),   PID_Q15(0.005) },   /* LOW    */
+    { PID_Q15(0.010), PID_KI(0.0005),   PID_Q15(0.005) },   /* MEDIUM */
+    { PID_Q15(0.012), PID_KI(0.0006),   PID_Q15(0.005) }    /* HIGH   */
+};
+
+/* Occupied seat in a 15 degree cabin */
+static const Plant_Config_t xAppPlantConfig = { 120000, 3000, 5000, 3000, 15000, 34000, 4 };
+
+static const SensorFault_Config_t xAppSensorFaultConfig = { 50, 400, 60, 390, 3, 10 };
+
+#endif /* APP_PARAMS_H_ */
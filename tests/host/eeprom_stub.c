@@ -0,0 +1,64 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: eeprom_stub.c
+ *
+ * Description: RAM backed EEPROM driver with write failure injection for the host unit tests
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "eeprom_stub.h"
+
+uint32 aulEepromStubWords[EEPROM_TOTAL_WORDS];
+
+static uint32 ulWritesLeft = EEPROM_STUB_NO_FAILURE;
+
+void EEPROM_StubErase(void)
+{
+    uint16 usWord;
+
+    for (usWord = 0; usWord < EEPROM_TOTAL_WORDS; usWord++)
+    {
+        aulEepromStubWords[usWord] = EEPROM_ERASED_WORD;
+    }
+    ulWritesLeft = EEPROM_STUB_NO_FAILURE;
+}
+
+void EEPROM_StubFailAfter(uint32 ulWrites)
+{
+    ulWritesLeft = ulWrites;
+}
+
+boolean EEPROM_Init(void)
+{
+    return TRUE;
+}
+
+uint32 EEPROM_ReadWord(uint16 usWordAddress)
+{
+    return aulEepromStubWords[usWordAddress % EEPROM_TOTAL_WORDS];
+}
+
+void EEPROM_ReadWords(uint16 usWordAddress, uint32 *pulData, uint16 usCount)
+{
+    while (usCount-- > 0)
+    {
+        *pulData++ = EEPROM_ReadWord(usWordAddress++);
+    }
+}
+
+boolean EEPROM_WriteWord(uint16 usWordAddress, uint32 ulData)
+{
+    if (ulWritesLeft == 0)
+    {
+        return FALSE;
+    }
+    if (ulWritesLeft != EEPROM_STUB_NO_FAILURE)
+    {
+        ulWritesLeft--;
+    }
+    aulEepromStubWords[usWordAddress % EEPROM_TOTAL_WORDS] = ulData;
+    return TRUE;
+}
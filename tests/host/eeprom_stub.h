@@ -0,0 +1,28 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: eeprom_stub.h
+ *
+ * Description: controls of the RAM backed EEPROM driver used by the host unit tests
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef EEPROM_STUB_H_
+#define EEPROM_STUB_H_
+
+#include "eeprom.h"
+
+/* Contents of the simulated EEPROM, word addressed */
+extern uint32 aulEepromStubWords[EEPROM_TOTAL_WORDS];
+
+/* Erase every word, as shipped from the factory */
+void EEPROM_StubErase(void);
+
+/* Let usWrites more writes succeed, then fail every write without programming it.
+ * EEPROM_STUB_NO_FAILURE lets all of them succeed. */
+#define EEPROM_STUB_NO_FAILURE 0xFFFFFFFFUL
+void EEPROM_StubFailAfter(uint32 ulWrites);
+
+#endif /* EEPROM_STUB_H_ */
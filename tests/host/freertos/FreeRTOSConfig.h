@@ -0,0 +1,53 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: FreeRTOSConfig.h
+ *
+ * Description: kernel configuration of the host builds of the tests, the priorities and tick
+ *              of the firmware on the single threaded host port of port.c
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <assert.h>
+#include <stdint.h>
+
+#define configCPU_CLOCK_HZ                      ((unsigned long)16000000)
+#define configTICK_RATE_HZ                      ((TickType_t)1000)
+#define configMINIMAL_STACK_SIZE                (64)        /* Only holds the port context pointer */
+#define configMAX_PRIORITIES                    (5)
+#define configUSE_PREEMPTION                    1
+#define configUSE_TIME_SLICING                  1
+#define configUSE_16_BIT_TICKS                  0
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#define configTOTAL_HEAP_SIZE                   ((size_t)(256 * 1024))
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#define configSUPPORT_STATIC_ALLOCATION         0
+#define configUSE_MUTEXES                       1
+#define configUSE_COUNTING_SEMAPHORES           1
+#define configUSE_TASK_NOTIFICATIONS            1
+#define configUSE_TIMERS                        0
+#define configUSE_IDLE_HOOK                     1           /* Advances the tick, see port.c */
+#define configUSE_TICK_HOOK                     0
+#define configUSE_MALLOC_FAILED_HOOK            0
+#define configUSE_TICKLESS_IDLE                 0
+#define configMAX_TASK_NAME_LEN                 16
+#define configQUEUE_REGISTRY_SIZE               0
+
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_vTaskDelayUntil                 1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_xTaskGetSchedulerState          1
+
+#define configASSERT(x) assert(x)
+
+/* Same hook as the firmware: count the context switches */
+extern uint32_t ulHostContextSwitches;
+#define traceTASK_SWITCHED_IN() ulHostContextSwitches++
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,143 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: port.c
+ *
+ * Description: single threaded host port of the kernel for the tests. Every task runs on its
+ *              own ucontext stack and the scheduler switches between them on the thread of
+ *              main. The idle hook advances the tick, so task code takes no simulated time and
+ *              the schedule is deterministic.
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#define _XOPEN_SOURCE 700
+#include <stdlib.h>
+#include <ucontext.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define portHOST_STACK_SIZE (64 * 1024)
+
+typedef struct
+{
+    ucontext_t xContext;
+    TaskFunction_t pxCode;
+    void *pvParameters;
+} HostTask_t;
+
+/* The first member of the TCB points to the stack word that holds the HostTask_t */
+extern void * volatile pxCurrentTCB;
+
+uint32_t ulHostContextSwitches = 0;
+
+static ucontext_t xMainContext;
+static UBaseType_t uxCriticalNesting = 0;
+static BaseType_t xYieldDeferred = pdFALSE;
+static TickType_t xEndTick = 0;
+
+static HostTask_t *prvCurrentTask(void)
+{
+    return (HostTask_t *)**(StackType_t **)pxCurrentTCB;
+}
+
+static void prvTaskEntry(void)
+{
+    HostTask_t *pxTask = prvCurrentTask();
+
+    pxTask->pxCode(pxTask->pvParameters);
+    for (;;)
+    {
+        /* A task function must not return */
+        abort();
+    }
+}
+
+StackType_t *pxPortInitialiseStack(StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters)
+{
+    HostTask_t *pxTask = malloc(sizeof(HostTask_t));
+
+    configASSERT(pxTask != NULL);
+    getcontext(&pxTask->xContext);
+    pxTask->xContext.uc_stack.ss_sp = malloc(portHOST_STACK_SIZE);
+    pxTask->xContext.uc_stack.ss_size = portHOST_STACK_SIZE;
+    pxTask->xContext.uc_link = NULL;
+    configASSERT(pxTask->xContext.uc_stack.ss_sp != NULL);
+    pxTask->pxCode = pxCode;
+    pxTask->pvParameters = pvParameters;
+    makecontext(&pxTask->xContext, prvTaskEntry, 0);
+
+    *pxTopOfStack = (StackType_t)pxTask;
+    return pxTopOfStack;
+}
+
+static void prvSwitch(void)
+{
+    HostTask_t *pxFrom = prvCurrentTask();
+    HostTask_t *pxTo;
+
+    vTaskSwitchContext();
+    pxTo = prvCurrentTask();
+    if (pxTo != pxFrom)
+    {
+        swapcontext(&pxFrom->xContext, &pxTo->xContext);
+    }
+}
+
+void vPortYield(void)
+{
+    if (uxCriticalNesting != 0)
+    {
+        xYieldDeferred = pdTRUE;
+        return;
+    }
+    prvSwitch();
+}
+
+void vPortEnterCritical(void)
+{
+    uxCriticalNesting++;
+}
+
+void vPortExitCritical(void)
+{
+    configASSERT(uxCriticalNesting != 0);
+    uxCriticalNesting--;
+    if (uxCriticalNesting == 0 && xYieldDeferred == pdTRUE)
+    {
+        xYieldDeferred = pdFALSE;
+        prvSwitch();
+    }
+}
+
+BaseType_t xPortStartScheduler(void)
+{
+    swapcontext(&xMainContext, &prvCurrentTask()->xContext);
+    return pdFALSE;
+}
+
+void vPortEndScheduler(void)
+{
+    swapcontext(&prvCurrentTask()->xContext, &xMainContext);
+}
+
+/* Run the scheduler until the tick count reaches xTicks */
+void vPortHostRun(TickType_t xTicks)
+{
+    xEndTick = xTicks;
+    vTaskStartScheduler();
+}
+
+/* Every task is blocked: the next tick is due */
+void vApplicationIdleHook(void)
+{
+    if (xTaskGetTickCount() >= xEndTick)
+    {
+        vTaskEndScheduler();
+    }
+    if (xTaskIncrementTick() != pdFALSE)
+    {
+        vPortYield();
+    }
+}
@@ -0,0 +1,62 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: portmacro.h
+ *
+ * Description: single threaded host port of the kernel for the tests. Tasks are ucontext
+ *              coroutines, a yield inside a critical section is held until it ends like the
+ *              PendSV of the target, and simulated time only passes while the idle task runs.
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+#define portCHAR          char
+#define portFLOAT         float
+#define portDOUBLE        double
+#define portLONG          long
+#define portSHORT         short
+#define portSTACK_TYPE    uintptr_t
+#define portBASE_TYPE     long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define portMAX_DELAY               ((TickType_t)0xffffffffUL)
+#define portTICK_TYPE_IS_ATOMIC     1
+#define portSTACK_GROWTH            (-1)
+#define portTICK_PERIOD_MS          ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portBYTE_ALIGNMENT          8
+#define portPOINTER_SIZE_TYPE       uintptr_t
+#define portNOP()
+
+void vPortYield(void);
+void vPortEnterCritical(void);
+void vPortExitCritical(void);
+
+/* Start the scheduler and return to the caller once the tick count reaches xTicks */
+void vPortHostRun(TickType_t xTicks);
+
+#define portYIELD()                         vPortYield()
+#define portEND_SWITCHING_ISR(xSwitchRequired) do { if ((xSwitchRequired) != pdFALSE) { vPortYield(); } } while (0)
+#define portYIELD_FROM_ISR(x)               portEND_SWITCHING_ISR(x)
+
+/* No interrupts on the host, the critical sections only defer the yields */
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL()                vPortEnterCritical()
+#define portEXIT_CRITICAL()                 vPortExitCritical()
+#define portSET_INTERRUPT_MASK_FROM_ISR()   0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x) (void)(x)
+
+#define portTASK_FUNCTION_PROTO(vFunction, pvParameters) void vFunction(void *pvParameters)
+#define portTASK_FUNCTION(vFunction, pvParameters) void vFunction(void *pvParameters)
+
+#endif /* PORTMACRO_H */
@@ -0,0 +1,27 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: latency_stub.c
+ *
+ * Description: host time stamps for the APP modules that time themselves: nanoseconds of the
+ *              monotonic clock instead of DWT cycles, wrapping the same way at 32 bits
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#include "latency.h"
+
+void Latency_Init(void)
+{
+}
+
+uint32 Latency_Timestamp(void)
+{
+    struct timespec xNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    return (uint32)((uint64)xNow.tv_sec * 1000000000ULL + (uint64)xNow.tv_nsec);
+}
@@ -0,0 +1,46 @@
+ /******************************************************************************
+ *
+ * Module: Common - Platform Types Abstraction
+ *
+ * File Name: std_types.h
+ *
+ * Description: types for the host unit tests, same widths as on the TM4C123
+ *              (long is 64 bits on most hosts, so the 32-bit types use int)
+ *
+ * Author: Youssef Khaled
+ *
+ *******************************************************************************/
+
+#ifndef STD_TYPES_H_
+#define STD_TYPES_H_
+
+#include <stdint.h>
+
+/* Boolean Values */
+#ifndef FALSE
+#define FALSE       (0u)
+#endif
+#ifndef TRUE
+#define TRUE        (1u)
+#endif
+
+#define LOGIC_HIGH        (1u)
+#define LOGIC_LOW         (0u)
+
+#define NULL_PTR    ((void*)0)
+
+typedef uint8_t               uint8;
+typedef int8_t                sint8;
+typedef uint16_t              uint16;
+typedef int16_t               sint16;
+typedef uint32_t              uint32;
+typedef int32_t               sint32;
+typedef uint64_t              uint64;
+typedef int64_t               sint64;
+typedef float                 float32;
+typedef double                float64;
+
+/* Boolean Data Type */
+typedef uint8 boolean;
+
+#endif /* STD_TYPE_H_ */
@@ -0,0 +1,67 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: uart0_stub.c
+ *
+ * Description: UART0 driver of the host unit tests, the transmitted bytes go to RAM. The
+ *              string and integer formatting is the one of MCAL/UART/uart0.c.
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "uart0_stub.h"
+
+uint8 aucUart0StubOutput[UART0_STUB_CAPACITY + 1];
+uint32 ulUart0StubSent = 0;
+
+void UART0_StubClear(void)
+{
+    ulUart0StubSent = 0;
+    aucUart0StubOutput[0] = '\0';
+}
+
+void UART0_Init(void)
+{
+    UART0_StubClear();
+}
+
+void UART0_SendByte(uint8 data)
+{
+    if (ulUart0StubSent < UART0_STUB_CAPACITY)
+    {
+        aucUart0StubOutput[ulUart0StubSent] = data;
+        aucUart0StubOutput[ulUart0StubSent + 1] = '\0';
+    }
+    ulUart0StubSent++;
+}
+
+void UART0_SendString(const uint8 *pData)
+{
+    while (*pData != '\0')
+    {
+        UART0_SendByte(*pData++);
+    }
+}
+
+void UART0_SendInteger(sint64 sNumber)
+{
+    uint8 uDigits[20];
+    sint8 uCounter = 0;
+
+    if (sNumber < 0)
+    {
+        UART0_SendByte('-');
+        sNumber *= -1;
+    }
+    do
+    {
+        uDigits[uCounter++] = sNumber % 10 + '0';
+        sNumber /= 10;
+    }
+    while (sNumber != 0);
+    for (uCounter--; uCounter >= 0; uCounter--)
+    {
+        UART0_SendByte(uDigits[uCounter]);
+    }
+}
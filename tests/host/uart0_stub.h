@@ -0,0 +1,28 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: uart0_stub.h
+ *
+ * Description: controls of the UART0 driver used by the host unit tests, which keeps the
+ *              transmitted bytes in RAM
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef UART0_STUB_H_
+#define UART0_STUB_H_
+
+#include "uart0.h"
+
+#define UART0_STUB_CAPACITY 4096
+
+/* Bytes sent since the last UART0_StubClear, NUL terminated, the excess is not kept */
+extern uint8 aucUart0StubOutput[UART0_STUB_CAPACITY + 1];
+
+/* Bytes sent since the last UART0_StubClear, including those beyond the capacity */
+extern uint32 ulUart0StubSent;
+
+void UART0_StubClear(void);
+
+#endif /* UART0_STUB_H_ */
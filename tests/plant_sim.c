@@ -0,0 +1,190 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: plant_sim.c
+ *
+ * Description: host simulator of one heated seat over hours of driving, faster than real
+ *              time: the sensor conversion, fault detection, filter and PID of the firmware
+ *              close the loop on the thermal model at the firmware's own periods
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "adc.h"
+#include "potentiometer.h"
+#include "filter.h"
+#include "pid.h"
+#include "plant.h"
+#include "sensor_fault.h"
+#include "app_params.h"
+
+#define SIM_MS_PER_MINUTE   60000UL
+#define SIM_DEFAULT_HOURS   3
+
+/* One stretch of the drive with constant conditions */
+typedef struct
+{
+    uint16 usMinutes;
+    uint8 ucLevel;
+    sint32 lCabinMilli;
+    boolean bOccupied;
+    boolean bSensorOpen;        /* Sensor wire disconnected, every conversion reads 0 */
+    const char *pcName;
+} Sim_Segment_t;
+
+/* Repeated until the requested driving time is covered */
+static const Sim_Segment_t axDrive[] =
+{
+    {  20, 2,  5000, TRUE,  FALSE, "cold start" },
+    {  40, 2, 12000, TRUE,  FALSE, "cabin warming" },
+    {  55, 3, 20000, TRUE,  FALSE, "warm cabin" },
+    {   5, 3, 20000, TRUE,  TRUE,  "sensor open" },
+    {  20, 3, 20000, TRUE,  FALSE, "sensor back" },
+    {  15, 0, 20000, TRUE,  FALSE, "heater off" },
+    {  25, 1, 18000, FALSE, FALSE, "empty seat" },
+};
+#define SIM_SEGMENTS (sizeof(axDrive) / sizeof(axDrive[0]))
+
+static Plant_Config_t xConfig;
+static Plant_t xPlant;
+static boolean bSensorOpen = FALSE;
+
+uint16 ADC_ReadOversampled(uint8 ucChannel, uint8 ucExtraBits)
+{
+    uint32 ulSum = 0;
+    uint16 usCount;
+
+    (void)ucChannel;
+    if (bSensorOpen == TRUE)
+    {
+        return 0;
+    }
+    for (usCount = 0; usCount < (1U << (2 * ucExtraBits)); usCount++)
+    {
+        ulSum += Plant_ReadSensor(&xPlant);
+    }
+    return (uint16)(ulSum >> ucExtraBits);
+}
+
+int main(int argc, char *argv[])
+{
+    Filter_t xFilter;
+    PID_Controller_t xPid;
+    SensorFault_t xSensor;
+    SensorFault_StateType eState = SENSOR_OK;
+    uint32 ulHours = (argc > 1) ? (uint32)strtoul(argv[1], NULL, 10) : SIM_DEFAULT_HOURS;
+    uint64 ullEndMs = (uint64)ulHours * 60 * SIM_MS_PER_MINUTE;
+    uint64 ullMs = 0;
+    uint64 ullTotalEnergyUj = 0;
+    uint32 ulSegment = 0;
+    uint16 usMeasured = 0;
+    boolean bValid = FALSE;
+    uint8 ucDuty = 0;
+
+    xConfig = xAppPlantConfig;
+    Plant_Init(&xPlant, &xConfig, 1);
+    Filter_Init(&xFilter, APP_MEDIAN_LENGTH, FILTER_Q15(APP_FILTER_ALPHA));
+    PID_Init(&xPid, &axAppGains[0]);
+    SensorFault_Init(&xSensor, &xAppSensorFaultConfig);
+
+    /* Settling and overshoot follow the last set point change, which may be in an earlier segment.
+     * The worst deviation is taken only while the temperature settled in the band. */
+    printf("SIM,Minute,Segment,Level,SetPoint,CabinC,Occupied,SettlingSec,OvershootC,WorstC,EnergyWh,DutyChanges,Faults\n");
+    while (ullMs < ullEndMs)
+    {
+        const Sim_Segment_t *pxSegment = &axDrive[ulSegment % SIM_SEGMENTS];
+        uint64 ullSegmentEnd = ullMs + (uint64)pxSegment->usMinutes * SIM_MS_PER_MINUTE;
+        uint64 ullStartEnergy = xPlant.ullEnergyUj;
+        uint64 ullStartMs = ullMs;
+        uint16 usSetPoint = (pxSegment->ucLevel == 0) ? 0 : APP_SET_POINT(pxSegment->ucLevel);
+        uint32 ulFaults = xSensor.ulFaults;
+        uint32 ulDutyChanges = 0;
+        uint16 usWorst = 0;
+        uint32 ulSettling;
+
+        xConfig.lAmbientMilli = pxSegment->lCabinMilli;
+        xConfig.ulOccupantConductance = (pxSegment->bOccupied == TRUE) ? xAppPlantConfig.ulOccupantConductance : 0;
+        bSensorOpen = pxSegment->bSensorOpen;
+        Plant_SetTarget(&xPlant, usSetPoint);
+        PID_SetGains(&xPid, &axAppGains[pxSegment->ucLevel]);
+
+        for (; ullMs < ullSegmentEnd && ullMs < ullEndMs; ullMs++)
+        {
+            Plant_Advance(&xPlant, 1);
+
+            if (ullMs % APP_SENSOR_PERIOD_MS == 0)
+            {
+                uint16 usRaw = ADC_to_Temperature(0);
+                SensorFault_StateType ePrevious = eState;
+
+                eState = SensorFault_Update(&xSensor, usRaw);
+                if (eState == SENSOR_OK && ePrevious >= SENSOR_FAULTED)
+                {
+                    Filter_Init(&xFilter, APP_MEDIAN_LENGTH, FILTER_Q15(APP_FILTER_ALPHA));
+                }
+                if (eState == SENSOR_OK)
+                {
+                    usMeasured = Filter_Update(&xFilter, usRaw);
+                    bValid = TRUE;
+                }
+                else if (eState >= SENSOR_FAULTED)
+                {
+                    bValid = FALSE;
+                }
+            }
+
+            if (ullMs % APP_CONTROL_PERIOD_MS == 0)
+            {
+                uint16 usDuty = 0;
+                uint8 ucNewDuty;
+
+                if (pxSegment->ucLevel == 0 || bValid == FALSE)
+                {
+                    PID_Reset(&xPid);
+                }
+                else
+                {
+                    usDuty = PID_Update(&xPid, usSetPoint, usMeasured, PID_DT_ONE);
+                }
+                ucNewDuty = (uint8)((usDuty * 100UL + (PID_Q15_ONE / 2)) / PID_Q15_ONE);
+                ulDutyChanges += (ucNewDuty != ucDuty) ? 1 : 0;
+                ucDuty = ucNewDuty;
+                Plant_SetDuty(&xPlant, ucDuty);
+            }
+
+            /* Worst deviation once the temperature settled in the band */
+            if (usSetPoint != 0 && Plant_GetSettlingMs(&xPlant) != PLANT_NOT_SETTLED)
+            {
+                sint32 lError = (sint32)Plant_GetTemperature(&xPlant) - usSetPoint;
+                uint16 usError = (uint16)((lError < 0) ? -lError : lError);
+
+                usWorst = (usError > usWorst) ? usError : usWorst;
+            }
+        }
+
+        ulSettling = Plant_GetSettlingMs(&xPlant);
+        printf("SIM,%u,%s,%u,%u.%u,%d,%u,", (unsigned)(ullStartMs / SIM_MS_PER_MINUTE), pxSegment->pcName,
+               pxSegment->ucLevel, usSetPoint / 10, usSetPoint % 10, (int)(pxSegment->lCabinMilli / 1000),
+               pxSegment->bOccupied);
+        if (usSetPoint == 0 || ulSettling == PLANT_NOT_SETTLED)
+        {
+            printf("-,");
+        }
+        else
+        {
+            printf("%u,", (unsigned)(ulSettling / 1000));
+        }
+        printf("%d.%d,%u.%u,%.2f,%u,%u\n", xPlant.sOvershoot / 10, xPlant.sOvershoot % 10, usWorst / 10, usWorst % 10,
+               (double)(xPlant.ullEnergyUj - ullStartEnergy) / 3.6e9, (unsigned)ulDutyChanges,
+               (unsigned)(xSensor.ulFaults - ulFaults));
+        ullTotalEnergyUj += xPlant.ullEnergyUj - ullStartEnergy;
+        ulSegment++;
+    }
+
+    printf("TOTAL,%u h,%.1f Wh,%.1f W average\n", (unsigned)ulHours, (double)ullTotalEnergyUj / 3.6e9,
+           (ullEndMs == 0) ? 0.0 : (double)ullTotalEnergyUj / 1000.0 / (double)ullEndMs);
+    return 0;
+}
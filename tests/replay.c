@@ -0,0 +1,195 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: replay.c
+ *
+ * Description: host replay of a captured trace through the sensor and control pipeline of
+ *              the firmware, with the trace cursors of APP/trace.c
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include <string.h>
+#include "replay.h"
+#include "adc.h"
+#include "button.h"
+#include "potentiometer.h"
+#include "filter.h"
+#include "pid.h"
+#include "sensor_fault.h"
+#include "app_params.h"
+
+#define REPLAY_LEVEL_OFF    0
+#define REPLAY_LEVEL_HIGH   3
+
+typedef struct
+{
+    Filter_t xFilter;
+    PID_Controller_t xPid;
+    SensorFault_t xSensor;
+    SensorFault_StateType ePreviousState;
+    uint8 ucLevel;
+    uint16 usTemp;
+    boolean bValid;
+    uint16 usPeriods;   /* Sensor jobs since the previous decision, the PID time step */
+    boolean bDecided;
+} Replay_Seat_t;
+
+static uint16 usReplayCode = 0;     /* Captured code of the reading in progress */
+
+/* The captured reading, the same value ADC_ReadOversampled returned in the capture run */
+uint16 ADC_ReadOversampled(uint8 ucChannel, uint8 ucExtraBits)
+{
+    (void)ucChannel;
+    (void)ucExtraBits;
+    return usReplayCode;
+}
+
+uint16 Replay_Load(FILE *pxFile, Trace_Record_t *pxRecords, uint16 usCapacity)
+{
+    char acLine[128];
+    char acType[16];
+    unsigned long ulTimeStamp;
+    unsigned int uiSource;
+    unsigned int uiValue;
+    uint16 usCount = 0;
+
+    while (usCount < usCapacity && fgets(acLine, sizeof(acLine), pxFile) != NULL)
+    {
+        if (sscanf(acLine, " {%lu, TRACE_EVENT_%15[A-Z], %u, %u}", &ulTimeStamp, acType, &uiSource, &uiValue) != 4)
+        {
+            continue;
+        }
+        pxRecords[usCount].ulTimeStamp = (uint32)ulTimeStamp;
+        pxRecords[usCount].ucType = (strcmp(acType, "BUTTON") == 0) ? TRACE_EVENT_BUTTON : TRACE_EVENT_ADC;
+        pxRecords[usCount].ucSource = (uint8)uiSource;
+        pxRecords[usCount].usValue = (uint16)uiValue;
+        usCount++;
+    }
+    return usCount;
+}
+
+/* The level rule of vLevelSettingTempTask */
+static void prvReplayGesture(Replay_Seat_t *pxSeat, Button_GestureType eGesture)
+{
+    switch (eGesture)
+    {
+    case BUTTON_LONG_PRESS:
+        pxSeat->ucLevel = REPLAY_LEVEL_OFF;
+        break;
+    case BUTTON_DOUBLE_PRESS:
+        pxSeat->ucLevel = REPLAY_LEVEL_HIGH;
+        break;
+    default:
+        pxSeat->ucLevel = (pxSeat->ucLevel == REPLAY_LEVEL_HIGH) ? REPLAY_LEVEL_OFF : (uint8)(pxSeat->ucLevel + 1);
+        break;
+    }
+}
+
+/* One reading of vTempReadingTask, FALSE when the sensor task drops it */
+static boolean prvReplayReading(Replay_Seat_t *pxSeat)
+{
+    uint16 usRaw = ADC_to_Temperature(0);
+    SensorFault_StateType eState = SensorFault_Update(&pxSeat->xSensor, usRaw);
+
+    if (eState == SENSOR_OK && pxSeat->ePreviousState >= SENSOR_FAULTED)
+    {
+        Filter_Init(&pxSeat->xFilter, APP_MEDIAN_LENGTH, FILTER_Q15(APP_FILTER_ALPHA));
+    }
+    pxSeat->ePreviousState = eState;
+    if (eState == SENSOR_SUSPECT)
+    {
+        return FALSE;
+    }
+    if (eState == SENSOR_OK)
+    {
+        pxSeat->usTemp = Filter_Update(&pxSeat->xFilter, usRaw);
+        pxSeat->bValid = TRUE;
+    }
+    else
+    {
+        pxSeat->bValid = FALSE;
+    }
+    return TRUE;
+}
+
+/* One seat of a vControlTask pass, returns the duty in percent */
+static uint8 prvReplayDecision(Replay_Seat_t *pxSeat)
+{
+    uint16 usDuty = 0;
+    uint16 usDt = (pxSeat->bDecided == FALSE) ? PID_DT_ONE :
+                  PID_DT(pxSeat->usPeriods * APP_SENSOR_PERIOD_MS, APP_CONTROL_PERIOD_MS);
+
+    pxSeat->usPeriods = 0;
+    pxSeat->bDecided = TRUE;
+    if (pxSeat->ucLevel == REPLAY_LEVEL_OFF || pxSeat->bValid == FALSE)
+    {
+        PID_Reset(&pxSeat->xPid);
+    }
+    else
+    {
+        PID_SetGains(&pxSeat->xPid, &axAppGains[pxSeat->ucLevel]);
+        usDuty = PID_Update(&pxSeat->xPid, APP_SET_POINT(pxSeat->ucLevel), pxSeat->usTemp, usDt);
+    }
+    return (uint8)((usDuty * 100UL + (PID_Q15_ONE / 2)) / PID_Q15_ONE);
+}
+
+void Replay_Run(const Trace_Record_t *pxTrace, uint16 usCount, Replay_Result_t *pxResult)
+{
+    static Replay_Seat_t axSeat[TRACE_MAX_SOURCES];
+    Trace_Record_t xRecord;
+    Replay_Seat_t *pxSeat;
+    uint16 usIndex;
+    uint8 ucSource;
+    uint8 ucDuty;
+
+    memset(pxResult, 0, sizeof(*pxResult));
+    for (ucSource = 0; ucSource < TRACE_MAX_SOURCES; ucSource++)
+    {
+        pxSeat = &axSeat[ucSource];
+        Filter_Init(&pxSeat->xFilter, APP_MEDIAN_LENGTH, FILTER_Q15(APP_FILTER_ALPHA));
+        PID_Init(&pxSeat->xPid, &axAppGains[REPLAY_LEVEL_OFF]);
+        SensorFault_Init(&pxSeat->xSensor, &xAppSensorFaultConfig);
+        pxSeat->ePreviousState = SENSOR_OK;
+        pxSeat->ucLevel = REPLAY_LEVEL_OFF;
+        pxSeat->usTemp = 0;
+        pxSeat->bValid = FALSE;
+        pxSeat->usPeriods = 0;
+        pxSeat->bDecided = FALSE;
+    }
+
+    /* The sensor tasks take their readings in the captured order */
+    Trace_StartReplay(pxTrace, usCount);
+    for (usIndex = 0; usIndex < usCount; usIndex++)
+    {
+        ucSource = pxTrace[usIndex].ucSource;
+        if (pxTrace[usIndex].ucType != TRACE_EVENT_ADC || ucSource >= TRACE_MAX_SOURCES ||
+            Trace_NextAdc(ucSource, &xRecord) == FALSE)
+        {
+            continue;
+        }
+        usReplayCode = xRecord.usValue;
+
+        /* The gestures posted by prvTraceReplayGestures before the sample is processed */
+        while (Trace_NextButton(&xRecord) == TRUE)
+        {
+            if (xRecord.ucSource < TRACE_MAX_SOURCES)
+            {
+                prvReplayGesture(&axSeat[xRecord.ucSource], (Button_GestureType)xRecord.usValue);
+                pxResult->aulGestures[xRecord.ucSource]++;
+            }
+        }
+
+        pxSeat = &axSeat[ucSource];
+        pxSeat->usPeriods++;
+        if (prvReplayReading(pxSeat) == FALSE)
+        {
+            continue;
+        }
+        ucDuty = prvReplayDecision(pxSeat);
+        pxResult->aulDigest[ucSource] = (pxResult->aulDigest[ucSource] * 31) + ((uint32)pxSeat->ucLevel << 8) + ucDuty;
+        pxResult->aulDecisions[ucSource]++;
+    }
+    pxResult->usReplayed = Trace_GetReplayed();
+}
@@ -0,0 +1,41 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: replay.h
+ *
+ * Description: host replay of a captured trace through the sensor and control pipeline of
+ *              the firmware, with the trace cursors of APP/trace.c
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef REPLAY_H_
+#define REPLAY_H_
+
+#include <stdio.h>
+#include "trace.h"
+
+typedef struct
+{
+    uint32 aulDigest[TRACE_MAX_SOURCES];    /* Same fingerprint as the DIGEST lines of the firmware */
+    uint32 aulDecisions[TRACE_MAX_SOURCES];
+    uint32 aulGestures[TRACE_MAX_SOURCES];
+    uint16 usReplayed;                      /* Records handed out by the trace cursors */
+} Replay_Result_t;
+
+/*
+ * Parse the output of the "trace" console command, the "{time, type, seat, value}," lines.
+ * Any other line is skipped, so the chunks of a long capture can be pasted one after another.
+ * Returns the number of records read, at most usCapacity.
+ */
+uint16 Replay_Load(FILE *pxFile, Trace_Record_t *pxRecords, uint16 usCapacity);
+
+/*
+ * Replay the trace. Every ADC record is one reading of its seat, the gestures captured before
+ * it are applied first, then the sample goes through fault detection, filter and PID. Every
+ * seat runs with the driver seat parameters of app_params.h.
+ */
+void Replay_Run(const Trace_Record_t *pxTrace, uint16 usCount, Replay_Result_t *pxResult);
+
+#endif /* REPLAY_H_ */
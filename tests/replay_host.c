@@ -0,0 +1,56 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: replay_host.c
+ *
+ * Description: host replay of a trace captured on the board. Reads the output of the "trace"
+ *              console command from a file, or replays the table of APP/trace_replay.c
+ *              without one, and prints the DIGEST lines of the firmware per seat.
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include <stdio.h>
+#include "replay.h"
+
+/* The chunks of several captures pasted in one file */
+#define REPLAY_MAX_RECORDS 4096
+
+static Trace_Record_t axRecords[REPLAY_MAX_RECORDS];
+
+int main(int argc, char *argv[])
+{
+    Replay_Result_t xResult;
+    const Trace_Record_t *pxTrace = xTraceReplay;
+    uint16 usCount = usTraceReplayCount;
+    FILE *pxFile;
+    uint8 ucSource;
+
+    if (argc > 1)
+    {
+        pxFile = fopen(argv[1], "r");
+        if (pxFile == NULL)
+        {
+            perror(argv[1]);
+            return 1;
+        }
+        usCount = Replay_Load(pxFile, axRecords, REPLAY_MAX_RECORDS);
+        fclose(pxFile);
+        pxTrace = axRecords;
+    }
+
+    Replay_Run(pxTrace, usCount, &xResult);
+    printf("REPLAY,Seat,Digest,Decisions,Gestures\n");
+    for (ucSource = 0; ucSource < TRACE_MAX_SOURCES; ucSource++)
+    {
+        if (xResult.aulDecisions[ucSource] == 0 && xResult.aulGestures[ucSource] == 0)
+        {
+            continue;
+        }
+        printf("DIGEST,%u,%lu,%lu,%lu\n", ucSource, (unsigned long)xResult.aulDigest[ucSource],
+               (unsigned long)xResult.aulDecisions[ucSource], (unsigned long)xResult.aulGestures[ucSource]);
+    }
+    printf("Replayed %u / %u records\n", xResult.usReplayed, usCount);
+    return 0;
+}
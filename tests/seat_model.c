@@ -0,0 +1,143 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: seat_model.c
+ *
+ * Description: model of the sensor, control and heater tasks of N seats: worst-case response
+ *              times from APP/rta.c and the control decisions they lead to over a run
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "seat_model.h"
+#include "rta.h"
+
+/* Priorities of main.c */
+#define MODEL_SENSOR_PRIORITY   2
+#define MODEL_CONTROL_PRIORITY  2
+#define MODEL_HEATER_PRIORITY   3
+
+#define MODEL_NO_SAMPLE 0xFFFFFFFFFFFFFFFFULL
+
+static uint32 prvSensorPeriod(uint8 ucSeat)
+{
+    return ((ucSeat % 2) == 0) ? (40 * MODEL_MS) : (60 * MODEL_MS);
+}
+
+/* Release time of the newest reading of a seat delivered by ullTime */
+static uint64 prvNewestReading(uint8 ucSeat, uint32 ulSensorResponse, uint64 ullTime)
+{
+    uint64 ullPhase = (uint64)ucSeat * MODEL_MS;
+    uint32 ulPeriod = prvSensorPeriod(ucSeat);
+
+    if (ullTime < ullPhase + ulSensorResponse)
+    {
+        return MODEL_NO_SAMPLE;
+    }
+    return ullPhase + ((ullTime - ullPhase - ulSensorResponse) / ulPeriod) * ulPeriod;
+}
+
+void Model_Run(uint8 ucSeats, Model_PolicyType ePolicy, const Model_Costs_t *pxCosts, uint32 ulSeconds,
+               Model_Result_t *pxResult)
+{
+    RTA_Task_t axTasks[MODEL_MAX_SEATS + 2];
+    uint64 aullUsed[MODEL_MAX_SEATS];           /* Reading of the last decision */
+    uint64 aullDecided[MODEL_MAX_SEATS];        /* Time of the last decision */
+    uint64 ullEnd = (uint64)ulSeconds * 1000 * MODEL_MS;
+    uint64 ullPass;
+    uint64 ullDecision;
+    uint64 ullReading;
+    uint64 ullNewest;
+    uint64 ullLoad = 0;
+    uint8 ucSeat;
+    uint8 ucLast;
+
+    if (ucSeats > MODEL_MAX_SEATS)
+    {
+        ucSeats = MODEL_MAX_SEATS;
+    }
+
+    /* The task set of main.c for ucSeats seats, without the lower priority reporting tasks */
+    for (ucSeat = 0; ucSeat < ucSeats + 2; ucSeat++)
+    {
+        axTasks[ucSeat] = (RTA_Task_t){ (const uint8 *)"Temp", 0, MODEL_SENSOR_PRIORITY, 0, pxCosts->ulSensorJob, 0, 0, 0, 0, 0 };
+        if (ucSeat < ucSeats)
+        {
+            axTasks[ucSeat].ulPeriod = prvSensorPeriod(ucSeat);
+        }
+    }
+    axTasks[ucSeats] = (RTA_Task_t){ (const uint8 *)"Control", MODEL_CONTROL_PERIOD, MODEL_CONTROL_PRIORITY, 0,
+                                     ucSeats * pxCosts->ulControlSeat, 0, 0, 0, 0, 0 };
+    axTasks[ucSeats + 1] = (RTA_Task_t){ (const uint8 *)"HeatingElement", MODEL_CONTROL_PERIOD, MODEL_HEATER_PRIORITY, 0,
+                                         ucSeats * pxCosts->ulHeaterSeat, 0, 0, 0, 0, 0 };
+    RTA_Analyse(axTasks, ucSeats + 2);
+    for (ucSeat = 0; ucSeat < ucSeats + 2; ucSeat++)
+    {
+        ullLoad += ((uint64)axTasks[ucSeat].ulWcet * 1000000ULL) / axTasks[ucSeat].ulPeriod;
+    }
+    pxResult->ulLoadPpm = (uint32)ullLoad;
+    pxResult->ulControlResponse = axTasks[ucSeats].ulResponse;
+    pxResult->ulWorstInterval = 0;
+    pxResult->ulWorstAge = 0;
+    if (pxResult->ulControlResponse == RTA_UNSCHEDULABLE)
+    {
+        return;
+    }
+    for (ucSeat = 0; ucSeat < ucSeats; ucSeat++)
+    {
+        if (axTasks[ucSeat].ulResponse == RTA_UNSCHEDULABLE)
+        {
+            pxResult->ulControlResponse = RTA_UNSCHEDULABLE;
+            return;
+        }
+        aullUsed[ucSeat] = MODEL_NO_SAMPLE;
+        aullDecided[ucSeat] = 0;
+    }
+
+    for (ullPass = MODEL_CONTROL_PERIOD; ullPass < ullEnd; ullPass += MODEL_CONTROL_PERIOD)
+    {
+        /* The seat whose reading arrived last, the one the old loop followed */
+        ucLast = 0;
+        ullNewest = 0;
+        for (ucSeat = 0; ucSeat < ucSeats; ucSeat++)
+        {
+            ullReading = prvNewestReading(ucSeat, axTasks[ucSeat].ulResponse, ullPass);
+            if (ullReading != MODEL_NO_SAMPLE && ullReading + axTasks[ucSeat].ulResponse >= ullNewest)
+            {
+                ullNewest = ullReading + axTasks[ucSeat].ulResponse;
+                ucLast = ucSeat;
+            }
+        }
+
+        ullDecision = ullPass + pxResult->ulControlResponse;
+        for (ucSeat = 0; ucSeat < ucSeats; ucSeat++)
+        {
+            ullReading = prvNewestReading(ucSeat, axTasks[ucSeat].ulResponse, ullPass);
+            if (ullReading == MODEL_NO_SAMPLE || ullReading == aullUsed[ucSeat] ||
+                (ePolicy == MODEL_LAST_SAMPLED && ucSeat != ucLast))
+            {
+                continue;
+            }
+            if ((ullDecision - ullReading) / 1000 > pxResult->ulWorstAge)
+            {
+                pxResult->ulWorstAge = (uint32)((ullDecision - ullReading) / 1000);
+            }
+            if (aullDecided[ucSeat] != 0 && (ullDecision - aullDecided[ucSeat]) / 1000 > pxResult->ulWorstInterval)
+            {
+                pxResult->ulWorstInterval = (uint32)((ullDecision - aullDecided[ucSeat]) / 1000);
+            }
+            aullUsed[ucSeat] = ullReading;
+            aullDecided[ucSeat] = ullDecision;
+        }
+    }
+
+    /* A seat left without a decision until the end */
+    for (ucSeat = 0; ucSeat < ucSeats; ucSeat++)
+    {
+        if ((ullEnd - aullDecided[ucSeat]) / 1000 > pxResult->ulWorstInterval)
+        {
+            pxResult->ulWorstInterval = (uint32)((ullEnd - aullDecided[ucSeat]) / 1000);
+        }
+    }
+}
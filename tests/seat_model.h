@@ -0,0 +1,52 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: seat_model.h
+ *
+ * Description: model of the sensor, control and heater tasks of N seats: worst-case response
+ *              times from APP/rta.c and the control decisions they lead to over a run
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef SEAT_MODEL_H_
+#define SEAT_MODEL_H_
+
+#include "std_types.h"
+
+#define MODEL_MAX_SEATS 16
+
+/* Times are in nanoseconds unless noted */
+#define MODEL_MS 1000000UL
+#define MODEL_CONTROL_PERIOD (50 * MODEL_MS)
+
+typedef enum
+{
+    MODEL_BATCHED,          /* vControlTask: one pass decides every seat with a fresh sample */
+    MODEL_LAST_SAMPLED      /* Before the batched pass: only the seat sampled last is decided */
+} Model_PolicyType;
+
+typedef struct
+{
+    uint32 ulSensorJob;     /* One reading: conversion, fault detection and filter */
+    uint32 ulControlSeat;   /* Control work per seat and pass */
+    uint32 ulHeaterSeat;    /* Heater work per commanded seat */
+} Model_Costs_t;
+
+typedef struct
+{
+    uint32 ulControlResponse;   /* Worst-case response of the control pass, RTA_UNSCHEDULABLE if none */
+    uint32 ulWorstInterval;     /* Worst time between two decisions of the same seat, usec */
+    uint32 ulWorstAge;          /* Worst age of the reading a decision is based on, usec */
+    uint32 ulLoadPpm;           /* Processor load of the modelled tasks, parts per million */
+} Model_Result_t;
+
+/*
+ * Seat n samples every 40 msec (even n) or 60 msec (odd n) like the seat table, phased n msec
+ * apart. Every job takes its worst-case response time, so the figures are upper bounds.
+ */
+void Model_Run(uint8 ucSeats, Model_PolicyType ePolicy, const Model_Costs_t *pxCosts, uint32 ulSeconds,
+               Model_Result_t *pxResult);
+
+#endif /* SEAT_MODEL_H_ */
@@ -0,0 +1,53 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: test.h
+ *
+ * Description: minimal assertion helpers for the host unit tests
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <stdio.h>
+
+static int iTestFailures = 0;
+
+/* Record a failure with its location and keep running the remaining checks */
+#define TEST_CHECK(cond)                                                            \
+    do                                                                              \
+    {                                                                               \
+        if (!(cond))                                                                \
+        {                                                                           \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);         \
+            iTestFailures++;                                                        \
+        }                                                                           \
+    } while (0)
+
+#define TEST_CHECK_EQ(actual, expected)                                             \
+    do                                                                              \
+    {                                                                               \
+        long long llActual = (long long)(actual);                                   \
+        long long llExpected = (long long)(expected);                               \
+        if (llActual != llExpected)                                                 \
+        {                                                                           \
+            printf("%s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__,        \
+                   #actual, llActual, llExpected);                                  \
+            iTestFailures++;                                                        \
+        }                                                                           \
+    } while (0)
+
+#define TEST_RUN(test)                                                              \
+    do                                                                              \
+    {                                                                               \
+        int iBefore = iTestFailures;                                                \
+        test();                                                                     \
+        printf("%s %s\n", (iTestFailures == iBefore) ? "PASS" : "FAIL", #test);     \
+    } while (0)
+
+#define TEST_RESULT() ((iTestFailures == 0) ? 0 : 1)
+
+#endif /* TEST_H_ */
@@ -0,0 +1,120 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: test_closed_loop.c
+ *
+ * Description: host test of the PID gains of main.c against the seat thermal model, through
+ *              the sensor conversion and filter, for the +/-3 degree requirement
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "test.h"
+#include "adc.h"
+#include "potentiometer.h"
+#include "filter.h"
+#include "pid.h"
+#include "plant.h"
+#include "app_params.h"
+
+/* Accepted deviation once settled, tenths of a degree */
+#define REQUIRED_BAND           30
+
+static Plant_t xPlant;
+
+uint16 ADC_ReadOversampled(uint8 ucChannel, uint8 ucExtraBits)
+{
+    uint32 ulSum = 0;
+    uint16 usCount;
+
+    (void)ucChannel;
+    for (usCount = 0; usCount < (1U << (2 * ucExtraBits)); usCount++)
+    {
+        ulSum += Plant_ReadSensor(&xPlant);
+    }
+    return (uint16)(ulSum >> ucExtraBits);
+}
+
+/* Run the loop for ulRealMs with the model ulTimeScale times faster, returns the worst
+ * deviation from the set point over the last ulCheckMs of simulated time */
+static uint16 prvRun(uint8 ucLevel, uint32 ulTimeScale, uint32 ulRealMs, uint32 ulCheckMs)
+{
+    Filter_t xFilter;
+    PID_Controller_t xPid;
+    uint16 usSetPoint = APP_SET_POINT(ucLevel);
+    uint16 usMeasured = 0;
+    uint16 usWorst = 0;
+    uint32 ulMs;
+
+    Plant_Init(&xPlant, &xAppPlantConfig, 1);
+    Plant_SetTarget(&xPlant, usSetPoint);
+    Filter_Init(&xFilter, APP_MEDIAN_LENGTH, FILTER_Q15(APP_FILTER_ALPHA));
+    PID_Init(&xPid, &axAppGains[ucLevel]);
+
+    for (ulMs = 0; ulMs < ulRealMs; ulMs++)
+    {
+        Plant_Advance(&xPlant, ulTimeScale);
+        if (ulMs % APP_SENSOR_PERIOD_MS == 0)
+        {
+            usMeasured = Filter_Update(&xFilter, ADC_to_Temperature(0));
+        }
+        if (ulMs % APP_CONTROL_PERIOD_MS == 0)
+        {
+            uint16 usDuty = PID_Update(&xPid, usSetPoint, usMeasured, PID_DT_ONE);
+            Plant_SetDuty(&xPlant, (uint8)((usDuty * 100UL + (PID_Q15_ONE / 2)) / PID_Q15_ONE));
+        }
+        if ((ulRealMs - ulMs) * ulTimeScale <= ulCheckMs)
+        {
+            sint32 lError = (sint32)Plant_GetTemperature(&xPlant) - usSetPoint;
+            uint16 usError = (uint16)((lError < 0) ? -lError : lError);
+
+            if (usError > usWorst)
+            {
+                usWorst = usError;
+            }
+        }
+    }
+    return usWorst;
+}
+
+static void test_every_level_holds_three_degrees(void)
+{
+    uint8 ucLevel;
+
+    /* As on the target with the simulation: an hour of model time, the last 10 minutes checked */
+    for (ucLevel = 1; ucLevel <= 3; ucLevel++)
+    {
+        uint16 usWorst = prvRun(ucLevel, 60, 60UL * 60 * 1000 / 60, 10UL * 60 * 1000);
+
+        printf("  level %u: worst deviation %u.%u, overshoot %d.%d degrees\n", ucLevel,
+               usWorst / 10, usWorst % 10, xPlant.sOvershoot / 10, xPlant.sOvershoot % 10);
+        TEST_CHECK(usWorst <= REQUIRED_BAND);
+        TEST_CHECK(xPlant.sOvershoot <= REQUIRED_BAND);
+        TEST_CHECK(Plant_GetSettlingMs(&xPlant) != PLANT_NOT_SETTLED);
+    }
+}
+
+static void test_real_time_plant_holds_three_degrees(void)
+{
+    uint8 ucLevel;
+
+    /* Unscaled: the controller samples the model 60 times more often */
+    for (ucLevel = 1; ucLevel <= 3; ucLevel++)
+    {
+        uint16 usWorst = prvRun(ucLevel, 1, 60UL * 60 * 1000, 10UL * 60 * 1000);
+
+        printf("  level %u: worst deviation %u.%u, overshoot %d.%d degrees\n", ucLevel,
+               usWorst / 10, usWorst % 10, xPlant.sOvershoot / 10, xPlant.sOvershoot % 10);
+        TEST_CHECK(usWorst <= REQUIRED_BAND);
+        TEST_CHECK(xPlant.sOvershoot <= REQUIRED_BAND);
+        TEST_CHECK(Plant_GetSettlingMs(&xPlant) != PLANT_NOT_SETTLED);
+    }
+}
+
+int main(void)
+{
+    TEST_RUN(test_every_level_holds_three_degrees);
+    TEST_RUN(test_real_time_plant_holds_three_degrees);
+    return TEST_RESULT();
+}
@@ -0,0 +1,166 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: test_console.c
+ *
+ * Description: host unit tests of the console line editor and command dispatch
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include <string.h>
+#include "test.h"
+#include "console.h"
+#include "uart0_stub.h"
+
+static uint8 ucCalls;
+static uint8 ucLastArgc;
+static char acLastArgs[CONSOLE_MAX_ARGS][CONSOLE_LINE_LENGTH + 1];
+
+static void prvHandler(uint8 ucArgc, uint8 *apcArgv[])
+{
+    uint8 ucIndex;
+
+    ucCalls++;
+    ucLastArgc = ucArgc;
+    for (ucIndex = 0; ucIndex < ucArgc; ucIndex++)
+    {
+        strcpy(acLastArgs[ucIndex], (const char *)apcArgv[ucIndex]);
+    }
+}
+
+static const Console_CommandType axCommands[] =
+{
+    { (const uint8 *)"stats", (const uint8 *)"stats", prvHandler },
+    { (const uint8 *)"level", (const uint8 *)"level <seat> <level>", prvHandler }
+};
+
+static void prvReset(void)
+{
+    Console_Init(axCommands, sizeof(axCommands) / sizeof(axCommands[0]));
+    UART0_StubClear();
+    ucCalls = 0;
+    ucLastArgc = 0;
+}
+
+/* Feed the bytes like the console task, running every line that completes */
+static uint8 prvType(const char *pcText)
+{
+    uint8 ucLines = 0;
+
+    for (; *pcText != '\0'; pcText++)
+    {
+        if (Console_ProcessByte((uint8)*pcText) == TRUE)
+        {
+            Console_Execute();
+            ucLines++;
+        }
+    }
+    return ucLines;
+}
+
+static void test_command_with_arguments(void)
+{
+    prvReset();
+    TEST_CHECK_EQ(prvType("level  1 3\r"), 1);
+    TEST_CHECK_EQ(ucCalls, 1);
+    TEST_CHECK_EQ(ucLastArgc, 3);
+    TEST_CHECK(strcmp(acLastArgs[0], "level") == 0);
+    TEST_CHECK(strcmp(acLastArgs[1], "1") == 0);
+    TEST_CHECK(strcmp(acLastArgs[2], "3") == 0);
+    TEST_CHECK_EQ(ulUart0StubSent, 0);
+
+    /* Words beyond CONSOLE_MAX_ARGS are ignored */
+    prvType("level a b c d e\r");
+    TEST_CHECK_EQ(ucLastArgc, CONSOLE_MAX_ARGS);
+    TEST_CHECK(strcmp(acLastArgs[CONSOLE_MAX_ARGS - 1], "c") == 0);
+}
+
+static void test_cr_lf_runs_once(void)
+{
+    prvReset();
+    TEST_CHECK_EQ(prvType("stats\r\n"), 1);
+    TEST_CHECK_EQ(prvType("stats\n"), 1);
+    TEST_CHECK_EQ(prvType("\r\n\r\n"), 0);
+    TEST_CHECK_EQ(ucCalls, 2);
+    TEST_CHECK_EQ(ulUart0StubSent, 0);
+}
+
+static void test_backspace_edits_the_line(void)
+{
+    prvReset();
+    TEST_CHECK_EQ(prvType("stx\bats\r"), 1);
+    TEST_CHECK_EQ(ucCalls, 1);
+
+    /* DEL works too, and erasing past the start of the line leaves it empty */
+    TEST_CHECK_EQ(prvType("ab\x7F\x7F\b\bstats\r"), 1);
+    TEST_CHECK_EQ(ucCalls, 2);
+    TEST_CHECK_EQ(prvType("x\b\r"), 0);
+    TEST_CHECK_EQ(ulUart0StubSent, 0);
+}
+
+static void test_overflow_rejects_the_line(void)
+{
+    char acLine[CONSOLE_LINE_LENGTH + 8];
+
+    prvReset();
+    memset(acLine, 'a', sizeof(acLine) - 2);
+    memcpy(acLine, "stats ", 6);
+    acLine[sizeof(acLine) - 2] = '\r';
+    acLine[sizeof(acLine) - 1] = '\0';
+    TEST_CHECK_EQ(prvType(acLine), 1);
+    TEST_CHECK_EQ(ucCalls, 0);
+    TEST_CHECK(strcmp((const char *)aucUart0StubOutput, "Line too long\r\n") == 0);
+
+    /* The next line starts clean */
+    UART0_StubClear();
+    TEST_CHECK_EQ(prvType("stats\r"), 1);
+    TEST_CHECK_EQ(ucCalls, 1);
+    TEST_CHECK_EQ(ulUart0StubSent, 0);
+
+    /* A line of exactly the capacity still runs */
+    memset(acLine, ' ', CONSOLE_LINE_LENGTH);
+    memcpy(acLine, "stats", 5);
+    acLine[CONSOLE_LINE_LENGTH] = '\r';
+    acLine[CONSOLE_LINE_LENGTH + 1] = '\0';
+    TEST_CHECK_EQ(prvType(acLine), 1);
+    TEST_CHECK_EQ(ucCalls, 2);
+}
+
+static void test_unknown_command_prints_usage(void)
+{
+    prvReset();
+    TEST_CHECK_EQ(prvType("bogus 1\r"), 1);
+    TEST_CHECK_EQ(ucCalls, 0);
+    TEST_CHECK(strcmp((const char *)aucUart0StubOutput, "Commands:\r\n  stats\r\n  level <seat> <level>\r\n") == 0);
+
+    /* A prefix of a command is not the command */
+    UART0_StubClear();
+    prvType("stat\r");
+    TEST_CHECK_EQ(ucCalls, 0);
+    TEST_CHECK(strncmp((const char *)aucUart0StubOutput, "Commands:", 9) == 0);
+}
+
+static void test_parse_number(void)
+{
+    uint32 ulValue = 7;
+
+    TEST_CHECK(Console_ParseNumber((const uint8 *)"4096", &ulValue) == TRUE);
+    TEST_CHECK_EQ(ulValue, 4096);
+    TEST_CHECK(Console_ParseNumber((const uint8 *)"", &ulValue) == FALSE);
+    TEST_CHECK(Console_ParseNumber((const uint8 *)"12a", &ulValue) == FALSE);
+    TEST_CHECK(Console_ParseNumber((const uint8 *)"-1", &ulValue) == FALSE);
+    TEST_CHECK_EQ(ulValue, 4096);
+}
+
+int main(void)
+{
+    TEST_RUN(test_command_with_arguments);
+    TEST_RUN(test_cr_lf_runs_once);
+    TEST_RUN(test_backspace_edits_the_line);
+    TEST_RUN(test_overflow_rejects_the_line);
+    TEST_RUN(test_unknown_command_prints_usage);
+    TEST_RUN(test_parse_number);
+    return TEST_RESULT();
+}
@@ -0,0 +1,87 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: test_control_latency.c
+ *
+ * Description: host test of the per-seat control latency of the batched control pass as the
+ *              seat count grows, against the loop that followed the last sampled seat
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "test.h"
+#include "seat_model.h"
+#include "rta.h"
+
+#define RUN_SECONDS 60
+
+/* Pessimistic costs at 16 MHz: a 16 conversion reading with fault detection and filter,
+ * the PID and bookkeeping of one seat, the duty and display update of one seat */
+static const Model_Costs_t xTargetCosts = { 200000, 100000, 50000 };
+
+static void test_batched_latency_is_bounded_per_seat(void)
+{
+    Model_Result_t xResult;
+    uint32 ulPrevious = 0;
+    uint8 ucSeats;
+
+    printf("  Seats  ControlResponse  WorstInterval  WorstAge (usec)\n");
+    for (ucSeats = 2; ucSeats <= MODEL_MAX_SEATS; ucSeats++)
+    {
+        Model_Run(ucSeats, MODEL_BATCHED, &xTargetCosts, RUN_SECONDS, &xResult);
+        printf("  %5u  %15lu  %13lu  %8lu\n", ucSeats, (unsigned long)(xResult.ulControlResponse / 1000),
+               (unsigned long)xResult.ulWorstInterval, (unsigned long)xResult.ulWorstAge);
+        TEST_CHECK(xResult.ulControlResponse != RTA_UNSCHEDULABLE);
+        if (xResult.ulControlResponse == RTA_UNSCHEDULABLE)
+        {
+            continue;
+        }
+
+        /* The pass grows with the seats, its response time never shrinks */
+        TEST_CHECK(xResult.ulControlResponse >= ulPrevious);
+        ulPrevious = xResult.ulControlResponse;
+
+        /* A fresh reading waits at most for the next pass, every seat is decided within two
+         * control periods (the 60 msec seats) plus the pass */
+        TEST_CHECK(xResult.ulWorstAge <= (60 * MODEL_MS + MODEL_CONTROL_PERIOD + xResult.ulControlResponse) / 1000);
+        TEST_CHECK(xResult.ulWorstInterval <= 2 * MODEL_CONTROL_PERIOD / 1000);
+    }
+}
+
+static void test_last_sampled_seat_starves_the_others(void)
+{
+    Model_Result_t xBatched;
+    Model_Result_t xLastSampled;
+    uint8 ucSeats;
+
+    for (ucSeats = 2; ucSeats <= MODEL_MAX_SEATS; ucSeats *= 2)
+    {
+        Model_Run(ucSeats, MODEL_BATCHED, &xTargetCosts, RUN_SECONDS, &xBatched);
+        Model_Run(ucSeats, MODEL_LAST_SAMPLED, &xTargetCosts, RUN_SECONDS, &xLastSampled);
+        printf("  %2u seats: worst interval %lu msec batched, %lu msec last sampled\n", ucSeats,
+               (unsigned long)(xBatched.ulWorstInterval / 1000), (unsigned long)(xLastSampled.ulWorstInterval / 1000));
+        TEST_CHECK(xLastSampled.ulWorstInterval > xBatched.ulWorstInterval);
+    }
+
+    /* With many seats some of them never get a decision at all */
+    TEST_CHECK_EQ(xLastSampled.ulWorstInterval, RUN_SECONDS * 1000000UL);
+}
+
+static void test_overloaded_pass_is_reported(void)
+{
+    Model_Costs_t xCosts = { 200000, 4000000, 50000 };
+    Model_Result_t xResult;
+
+    /* 4 msec per seat: 16 seats no longer fit in a control period */
+    Model_Run(MODEL_MAX_SEATS, MODEL_BATCHED, &xCosts, RUN_SECONDS, &xResult);
+    TEST_CHECK_EQ(xResult.ulControlResponse, RTA_UNSCHEDULABLE);
+}
+
+int main(void)
+{
+    TEST_RUN(test_batched_latency_is_bounded_per_seat);
+    TEST_RUN(test_last_sampled_seat_starves_the_others);
+    TEST_RUN(test_overloaded_pass_is_reported);
+    return TEST_RESULT();
+}
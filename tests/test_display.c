@@ -0,0 +1,168 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: test_display.c
+ *
+ * Description: host unit tests of the display engine: changed fields only, byte accounting
+ *              against the full table and the keyframe cadence. The engine keeps its state,
+ *              the tests run in order on the same display.
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include <string.h>
+#include "test.h"
+#include "display.h"
+#include "uart0_stub.h"
+
+static const uint8 acDriver[] = "Driver";
+static const uint8 acPassenger[] = "Passenger";
+static const uint8 acLow[] = "LOW";
+static const uint8 acHigh[] = "HIGH";
+
+static uint32 ulSentBefore;
+
+/* One refresh like vDisplaytask, TRUE if it transmitted */
+static boolean prvRefresh(void)
+{
+    if (Display_BeginRefresh() == FALSE)
+    {
+        return FALSE;
+    }
+    Display_Flush();
+    return TRUE;
+}
+
+/* Every byte the engine counts reached the UART */
+static void prvCheckAccounting(void)
+{
+    Display_Stats_t xStats;
+
+    Display_GetStats(&xStats);
+    TEST_CHECK_EQ(xStats.ulBytesSent - ulSentBefore, ulUart0StubSent);
+    ulSentBefore = xStats.ulBytesSent;
+    UART0_StubClear();
+}
+
+static void test_new_seats_get_full_rows(void)
+{
+    UART0_StubClear();
+    Display_SetSeat(0, acDriver, 215, 2, acLow);
+    Display_SetSeat(1, acPassenger, 198, 1, acLow);
+    TEST_CHECK(prvRefresh() == TRUE);
+    TEST_CHECK(strcmp((const char *)aucUart0StubOutput,
+                      "Driver\t\t21.5\t\t2\t\tLOW\r\nPassenger\t\t19.8\t\t1\t\tLOW\r\n") == 0);
+    prvCheckAccounting();
+}
+
+static void test_only_changes_are_sent(void)
+{
+    /* The same state again sends nothing */
+    Display_SetSeat(0, acDriver, 215, 2, acLow);
+    TEST_CHECK(prvRefresh() == FALSE);
+    TEST_CHECK_EQ(ulUart0StubSent, 0);
+
+    Display_SetSeat(0, acDriver, 226, 2, acHigh);
+    TEST_CHECK(prvRefresh() == TRUE);
+    TEST_CHECK(strcmp((const char *)aucUart0StubOutput, "Driver: Temp 22.6 Intensity HIGH\r\n") == 0);
+    prvCheckAccounting();
+}
+
+static void test_bytes_saved_against_full_table(void)
+{
+    Display_Stats_t xBefore;
+    Display_Stats_t xAfter;
+    uint32 ulSent;
+    uint32 ulFullTable;
+    uint16 usUpdate;
+
+    /* Both seats report every refresh, the temperature moves on one report in ten */
+    Display_GetStats(&xBefore);
+    for (usUpdate = 0; usUpdate < 10 * DISPLAY_KEYFRAME_REFRESHES; usUpdate++)
+    {
+        Display_SetSeat(0, acDriver, (uint16)(226 + (usUpdate / 10) % 3), 2, acHigh);
+        Display_SetSeat(1, acPassenger, 198, 1, acLow);
+        prvRefresh();
+    }
+    Display_GetStats(&xAfter);
+    ulSent = xAfter.ulBytesSent - xBefore.ulBytesSent;
+    ulFullTable = xAfter.ulBytesFullTable - xBefore.ulBytesFullTable;
+    printf("  %lu bytes sent, %lu for the full table per update\n", (unsigned long)ulSent, (unsigned long)ulFullTable);
+
+    /* Every update of a heating seat reprinted header, separator and its row */
+    TEST_CHECK_EQ(ulFullTable, 10 * DISPLAY_KEYFRAME_REFRESHES *
+                  (2 * (sizeof("\r\nSeat:\tCurrent Temp:\tHeating level:\tHeating Intensity:\r\n") - 1) +
+                   2 * (sizeof("--------------------------------------------------\r\n") - 1) + 2 * 8 +
+                   (sizeof("Driver") - 1) + 4 + 1 + (sizeof("HIGH") - 1) +
+                   (sizeof("Passenger") - 1) + 4 + 1 + (sizeof("LOW") - 1)));
+    TEST_CHECK(ulSent * 10 < ulFullTable);
+    prvCheckAccounting();
+}
+
+static void test_keyframe_cadence(void)
+{
+    Display_Stats_t xBefore;
+    Display_Stats_t xAfter;
+    uint16 usRefresh;
+    uint16 usLastKeyframe = 0;
+    uint8 ucKeyframes = 0;
+
+    /* Nothing changes, only the keyframes transmit, once every DISPLAY_KEYFRAME_REFRESHES */
+    Display_GetStats(&xBefore);
+    for (usRefresh = 1; usRefresh <= 3 * DISPLAY_KEYFRAME_REFRESHES; usRefresh++)
+    {
+        UART0_StubClear();
+        if (prvRefresh() == TRUE)
+        {
+            if (ucKeyframes > 0)
+            {
+                TEST_CHECK_EQ(usRefresh - usLastKeyframe, DISPLAY_KEYFRAME_REFRESHES);
+            }
+            usLastKeyframe = usRefresh;
+            ucKeyframes++;
+            TEST_CHECK(strncmp((const char *)aucUart0StubOutput, "\r\nSeat:\t", 8) == 0);
+            TEST_CHECK(strstr((const char *)aucUart0StubOutput, "Passenger\t\t19.8\t\t1\t\tLOW\r\n") != NULL);
+        }
+    }
+    Display_GetStats(&xAfter);
+    TEST_CHECK_EQ(ucKeyframes, 3);
+    TEST_CHECK_EQ(xAfter.ulKeyframes - xBefore.ulKeyframes, 3);
+    UART0_StubClear();
+    ulSentBefore = xAfter.ulBytesSent;
+}
+
+static void test_dashboard_rewrites_changed_cells(void)
+{
+    Display_SetMode(DISPLAY_MODE_DASHBOARD);
+    TEST_CHECK(prvRefresh() == TRUE);
+    TEST_CHECK(strncmp((const char *)aucUart0StubOutput, "\x1b[r\x1b[2J", 7) == 0);
+    prvCheckAccounting();
+
+    /* One temperature cell, padded over the old value, the cursor saved around it */
+    Display_SetSeat(1, acPassenger, 99, 1, acLow);
+    TEST_CHECK(prvRefresh() == TRUE);
+    TEST_CHECK(strcmp((const char *)aucUart0StubOutput, "\x1b" "7\x1b[4;13H9.9   \x1b" "8") == 0);
+    prvCheckAccounting();
+
+    Display_SetSystem(37, 0, 0);
+    TEST_CHECK(prvRefresh() == TRUE);
+    TEST_CHECK(strcmp((const char *)aucUart0StubOutput, "\x1b" "7\x1b[11;12H37    \x1b" "8") == 0);
+    prvCheckAccounting();
+    TEST_CHECK(prvRefresh() == FALSE);
+
+    Display_SetMode(DISPLAY_MODE_LINES);
+    TEST_CHECK(prvRefresh() == TRUE);
+    TEST_CHECK(strncmp((const char *)aucUart0StubOutput, "\x1b[r\x1b[2J\x1b[H\r\nSeat:", 16) == 0);
+    prvCheckAccounting();
+}
+
+int main(void)
+{
+    TEST_RUN(test_new_seats_get_full_rows);
+    TEST_RUN(test_only_changes_are_sent);
+    TEST_RUN(test_bytes_saved_against_full_table);
+    TEST_RUN(test_keyframe_cadence);
+    TEST_RUN(test_dashboard_rewrites_changed_cells);
+    return TEST_RESULT();
+}
@@ -0,0 +1,293 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: test_fault_log.c
+ *
+ * Description: host unit tests of the EEPROM fault log: CRC, wraparound and torn records
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "test.h"
+#include "fault_log.h"
+#include "eeprom_stub.h"
+
+/* Deadline miss records carry no heating level */
+static uint8 prvLevel(uint32 ulTimeStamp)
+{
+    return ((ulTimeStamp % 4) == FAULT_DEADLINE_MISS) ? 0 : (uint8)(ulTimeStamp % 4);
+}
+
+static boolean prvAppend(uint32 ulTimeStamp)
+{
+    FaultRecord_t xRecord;
+
+    xRecord.ulTimeStamp = ulTimeStamp;
+    xRecord.ucCode = (uint8)(ulTimeStamp % 4);
+    xRecord.ucSeat = (uint8)(ulTimeStamp % 3);
+    xRecord.ucLevel = prvLevel(ulTimeStamp);
+    return FaultLog_Append(&xRecord);
+}
+
+/* Check that the log reads back exactly the time stamps [ulFirst, ulLast] minus ulSkip */
+static void prvCheckContents(uint32 ulFirst, uint32 ulLast, uint32 ulSkip)
+{
+    FaultRecord_t xRecord;
+    uint16 usIndex = 0;
+    uint32 ulTimeStamp;
+
+    for (ulTimeStamp = ulFirst; ulTimeStamp <= ulLast; ulTimeStamp++)
+    {
+        if (ulTimeStamp == ulSkip)
+        {
+            continue;
+        }
+        TEST_CHECK(FaultLog_Read(usIndex, &xRecord) == TRUE);
+        TEST_CHECK_EQ(xRecord.ulTimeStamp, ulTimeStamp);
+        TEST_CHECK_EQ(xRecord.ucCode, ulTimeStamp % 4);
+        TEST_CHECK_EQ(xRecord.ucSeat, ulTimeStamp % 3);
+        TEST_CHECK_EQ(xRecord.ucLevel, prvLevel(ulTimeStamp));
+        usIndex++;
+    }
+    TEST_CHECK_EQ(FaultLog_GetCount(), usIndex);
+    TEST_CHECK(FaultLog_Read(usIndex, &xRecord) == FALSE);
+}
+
+/* Must run first, the log keeps its mount state for the rest of the program */
+static void test_append_fails_before_mount(void)
+{
+    EEPROM_StubErase();
+    TEST_CHECK(FaultLog_IsMounted() == FALSE);
+    TEST_CHECK(prvAppend(1) == FALSE);
+    TEST_CHECK_EQ(aulEepromStubWords[0], EEPROM_ERASED_WORD);
+}
+
+static void test_erased_eeprom_mounts_empty(void)
+{
+    FaultRecord_t xRecord;
+
+    EEPROM_StubErase();
+    FaultLog_Init();
+    TEST_CHECK(FaultLog_IsMounted() == TRUE);
+    TEST_CHECK_EQ(FaultLog_GetCount(), 0);
+    TEST_CHECK(FaultLog_Read(0, &xRecord) == FALSE);
+}
+
+static void test_records_survive_a_remount(void)
+{
+    uint32 ulTimeStamp;
+
+    EEPROM_StubErase();
+    FaultLog_Init();
+    for (ulTimeStamp = 0; ulTimeStamp < 5; ulTimeStamp++)
+    {
+        TEST_CHECK(prvAppend(ulTimeStamp) == TRUE);
+    }
+    prvCheckContents(0, 4, 0xFFFFFFFFUL);
+
+    FaultLog_Init();
+    prvCheckContents(0, 4, 0xFFFFFFFFUL);
+    TEST_CHECK(prvAppend(5) == TRUE);
+    prvCheckContents(0, 5, 0xFFFFFFFFUL);
+}
+
+static void test_wraparound_keeps_the_newest_records(void)
+{
+    uint32 ulTimeStamp;
+
+    EEPROM_StubErase();
+    FaultLog_Init();
+    for (ulTimeStamp = 0; ulTimeStamp < FAULT_LOG_CAPACITY + 10; ulTimeStamp++)
+    {
+        TEST_CHECK(prvAppend(ulTimeStamp) == TRUE);
+    }
+    TEST_CHECK_EQ(FaultLog_GetCount(), FAULT_LOG_CAPACITY);
+    prvCheckContents(10, FAULT_LOG_CAPACITY + 9, 0xFFFFFFFFUL);
+
+    /* The newest record is found in the middle of the ring after a reset */
+    FaultLog_Init();
+    prvCheckContents(10, FAULT_LOG_CAPACITY + 9, 0xFFFFFFFFUL);
+    TEST_CHECK(prvAppend(FAULT_LOG_CAPACITY + 10) == TRUE);
+    prvCheckContents(11, FAULT_LOG_CAPACITY + 10, 0xFFFFFFFFUL);
+}
+
+static void test_sequence_number_wraparound(void)
+{
+    uint32 ulTimeStamp;
+    uint32 ulLast = 3 * (FAULT_LOG_SEQUENCE_MASK + 1) + 17;
+
+    EEPROM_StubErase();
+    FaultLog_Init();
+    for (ulTimeStamp = 0; ulTimeStamp <= ulLast; ulTimeStamp++)
+    {
+        prvAppend(ulTimeStamp);
+    }
+    FaultLog_Init();
+    prvCheckContents(ulLast - FAULT_LOG_CAPACITY + 1, ulLast, 0xFFFFFFFFUL);
+}
+
+static void test_crc_detects_every_single_bit_flip(void)
+{
+    uint8 ucBit;
+    uint8 ucWord;
+
+    for (ucWord = 0; ucWord < FAULT_LOG_WORDS_PER_RECORD; ucWord++)
+    {
+        for (ucBit = 0; ucBit < 32; ucBit++)
+        {
+            EEPROM_StubErase();
+            FaultLog_Init();
+            prvAppend(0x12345678UL);
+            aulEepromStubWords[ucWord] ^= (1UL << ucBit);
+
+            FaultLog_Init();
+            TEST_CHECK_EQ(FaultLog_GetCount(), 0);
+        }
+    }
+}
+
+static void test_corrupted_record_is_skipped(void)
+{
+    uint32 ulTimeStamp;
+
+    EEPROM_StubErase();
+    FaultLog_Init();
+    for (ulTimeStamp = 0; ulTimeStamp < 8; ulTimeStamp++)
+    {
+        prvAppend(ulTimeStamp);
+    }
+    /* Flip a time stamp bit of the record in slot 3 */
+    aulEepromStubWords[3 * FAULT_LOG_WORDS_PER_RECORD] ^= 0x100;
+
+    FaultLog_Init();
+    prvCheckContents(0, 7, 3);
+    TEST_CHECK(prvAppend(8) == TRUE);
+    prvCheckContents(0, 8, 3);
+}
+
+static void test_corrupted_newest_record_after_wraparound(void)
+{
+    uint32 ulTimeStamp;
+    uint16 usNewestSlot = (FAULT_LOG_CAPACITY + 20 - 1) % FAULT_LOG_CAPACITY;
+
+    EEPROM_StubErase();
+    FaultLog_Init();
+    for (ulTimeStamp = 0; ulTimeStamp < FAULT_LOG_CAPACITY + 20; ulTimeStamp++)
+    {
+        prvAppend(ulTimeStamp);
+    }
+    aulEepromStubWords[usNewestSlot * FAULT_LOG_WORDS_PER_RECORD + 1] ^= 0x1000;
+
+    /* The previous record becomes the newest one, its slot is reused next */
+    FaultLog_Init();
+    prvCheckContents(20, FAULT_LOG_CAPACITY + 18, 0xFFFFFFFFUL);
+    TEST_CHECK(prvAppend(1000) == TRUE);
+    TEST_CHECK_EQ(aulEepromStubWords[usNewestSlot * FAULT_LOG_WORDS_PER_RECORD], 1000);
+}
+
+static void test_torn_write_is_ignored(void)
+{
+    uint32 ulTimeStamp;
+
+    EEPROM_StubErase();
+    FaultLog_Init();
+    for (ulTimeStamp = 0; ulTimeStamp < 3; ulTimeStamp++)
+    {
+        prvAppend(ulTimeStamp);
+    }
+    /* The time stamp is programmed, the word with the CRC is not */
+    EEPROM_StubFailAfter(1);
+    TEST_CHECK(prvAppend(3) == FALSE);
+    TEST_CHECK_EQ(FaultLog_GetCount(), 3);
+
+    EEPROM_StubFailAfter(EEPROM_STUB_NO_FAILURE);
+    FaultLog_Init();
+    prvCheckContents(0, 2, 0xFFFFFFFFUL);
+    TEST_CHECK(prvAppend(4) == TRUE);
+    prvCheckContents(0, 4, 3);
+}
+
+static void test_torn_write_over_the_oldest_record(void)
+{
+    uint32 ulTimeStamp;
+
+    EEPROM_StubErase();
+    FaultLog_Init();
+    for (ulTimeStamp = 0; ulTimeStamp < FAULT_LOG_CAPACITY; ulTimeStamp++)
+    {
+        prvAppend(ulTimeStamp);
+    }
+    EEPROM_StubFailAfter(1);
+    TEST_CHECK(prvAppend(FAULT_LOG_CAPACITY) == FALSE);
+
+    /* The oldest record lost its time stamp, the count follows with or without a reset */
+    prvCheckContents(1, FAULT_LOG_CAPACITY - 1, 0xFFFFFFFFUL);
+    EEPROM_StubFailAfter(EEPROM_STUB_NO_FAILURE);
+    FaultLog_Init();
+    prvCheckContents(1, FAULT_LOG_CAPACITY - 1, 0xFFFFFFFFUL);
+
+    TEST_CHECK(prvAppend(FAULT_LOG_CAPACITY) == TRUE);
+    prvCheckContents(1, FAULT_LOG_CAPACITY, 0xFFFFFFFFUL);
+}
+
+static void test_deadline_miss_keeps_every_task_tag(void)
+{
+    FaultRecord_t xRecord;
+    uint16 usTag;
+
+    EEPROM_StubErase();
+    FaultLog_Init();
+    xRecord.ucCode = FAULT_DEADLINE_MISS;
+    xRecord.ucLevel = 0;
+    for (usTag = 0; usTag < 256; usTag++)
+    {
+        xRecord.ulTimeStamp = usTag;
+        xRecord.ucSeat = (uint8)usTag;
+        TEST_CHECK(FaultLog_Append(&xRecord) == TRUE);
+    }
+
+    FaultLog_Init();
+    for (usTag = 0; usTag < 256; usTag++)
+    {
+        TEST_CHECK(FaultLog_Read(usTag, &xRecord) == TRUE);
+        TEST_CHECK_EQ(xRecord.ucCode, FAULT_DEADLINE_MISS);
+        TEST_CHECK_EQ(xRecord.ucSeat, usTag);
+        TEST_CHECK_EQ(xRecord.ucLevel, 0);
+    }
+}
+
+static void test_fields_that_dont_fit_are_rejected(void)
+{
+    FaultRecord_t xRecord;
+
+    EEPROM_StubErase();
+    FaultLog_Init();
+    xRecord.ulTimeStamp = 1;
+    xRecord.ucCode = FAULT_SENSOR_LOW;
+    xRecord.ucSeat = 16;
+    xRecord.ucLevel = 0;
+    TEST_CHECK(FaultLog_Append(&xRecord) == FALSE);
+    xRecord.ucSeat = 0;
+    xRecord.ucLevel = 16;
+    TEST_CHECK(FaultLog_Append(&xRecord) == FALSE);
+    TEST_CHECK_EQ(FaultLog_GetCount(), 0);
+    TEST_CHECK_EQ(aulEepromStubWords[0], EEPROM_ERASED_WORD);
+}
+
+int main(void)
+{
+    TEST_RUN(test_append_fails_before_mount);
+    TEST_RUN(test_erased_eeprom_mounts_empty);
+    TEST_RUN(test_records_survive_a_remount);
+    TEST_RUN(test_wraparound_keeps_the_newest_records);
+    TEST_RUN(test_sequence_number_wraparound);
+    TEST_RUN(test_crc_detects_every_single_bit_flip);
+    TEST_RUN(test_corrupted_record_is_skipped);
+    TEST_RUN(test_corrupted_newest_record_after_wraparound);
+    TEST_RUN(test_torn_write_is_ignored);
+    TEST_RUN(test_torn_write_over_the_oldest_record);
+    TEST_RUN(test_deadline_miss_keeps_every_task_tag);
+    TEST_RUN(test_fields_that_dont_fit_are_rejected);
+    return TEST_RESULT();
+}
@@ -0,0 +1,179 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: test_filter.c
+ *
+ * Description: host unit tests of the median and Q15 IIR sensor filter
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include <math.h>
+#include "test.h"
+#include "filter.h"
+#include "pid.h"
+#include "app_params.h"
+
+/* Samples of the recorded sequence, 40 msec apart: 2 minutes of a seat holding LOW */
+#define NOISY_SAMPLES 3000
+
+/* A seat settled on the LOW set point of 25.0 degrees: sensor noise of +/-0.6 degrees and a
+ * contact spike of 6 degrees every 3 seconds */
+static uint16 prvNoisySample(uint16 usIndex, uint32 *pulSeed)
+{
+    sint32 lNoise;
+
+    *pulSeed = (*pulSeed * 1103515245UL) + 12345UL;
+    lNoise = (sint32)((*pulSeed >> 16) % 13) - 6;
+    if (usIndex % 75 == 74)
+    {
+        lNoise += ((*pulSeed >> 8) % 2 == 0) ? 60 : -60;
+    }
+    return (uint16)(APP_SET_POINT(1) + lNoise);
+}
+
+/* The intensity rule of vHeatingElementTask: DISABLED, LOW, MEDIUM, HIGH */
+static uint8 prvIntensity(uint16 usDuty)
+{
+    uint8 ucPercent = (uint8)((usDuty * 100UL + (PID_Q15_ONE / 2)) / PID_Q15_ONE);
+
+    if (ucPercent == 0)
+    {
+        return 0;
+    }
+    return (ucPercent <= 33) ? 1 : ((ucPercent <= 66) ? 2 : 3);
+}
+
+/* Heater intensity changes over the recorded sequence with the given filter in front of the PID */
+static uint32 prvIntensityChanges(uint8 ucMedianLength, sint16 sAlpha)
+{
+    Filter_t xFilter;
+    PID_Controller_t xPid;
+    uint32 ulSeed = 2024;
+    uint32 ulChanges = 0;
+    uint8 ucIntensity = 0;
+    uint8 ucNew;
+    uint16 usIndex;
+
+    Filter_Init(&xFilter, ucMedianLength, sAlpha);
+    PID_Init(&xPid, &axAppGains[1]);
+
+    /* Holding the temperature takes about a third of full power, on the LOW / MEDIUM boundary */
+    xPid.lIntegral = PID_INTEGRAL_MAX / 3;
+    for (usIndex = 0; usIndex < NOISY_SAMPLES; usIndex++)
+    {
+        ucNew = prvIntensity(PID_Update(&xPid, APP_SET_POINT(1), Filter_Update(&xFilter, prvNoisySample(usIndex, &ulSeed)), PID_DT_ONE));
+        ulChanges += (ucNew != ucIntensity) ? 1 : 0;
+        ucIntensity = ucNew;
+    }
+    return ulChanges;
+}
+
+static void test_step_response_follows_first_order_lag(void)
+{
+    Filter_t xFilter;
+    uint16 usOut, usPrev = 1000;
+    int n;
+
+    Filter_Init(&xFilter, 1, FILTER_Q15(0.25));
+    TEST_CHECK_EQ(Filter_Update(&xFilter, 1000), 1000);
+
+    /* y[n] = 2000 - 1000 * 0.75^n, within one code of the rounding */
+    for (n = 1; n <= 20; n++)
+    {
+        double dExpected = 2000.0 - 1000.0 * pow(0.75, n);
+
+        usOut = Filter_Update(&xFilter, 2000);
+        TEST_CHECK(fabs(usOut - dExpected) <= 1.0);
+        TEST_CHECK(usOut >= usPrev);
+        TEST_CHECK(usOut <= 2000);
+        usPrev = usOut;
+    }
+    for (n = 0; n < 50; n++)
+    {
+        usOut = Filter_Update(&xFilter, 2000);
+    }
+    TEST_CHECK_EQ(usOut, 2000);
+}
+
+static void test_falling_step_settles_exactly(void)
+{
+    Filter_t xFilter;
+    uint16 usOut = 0;
+    int n;
+
+    Filter_Init(&xFilter, 1, FILTER_Q15(0.125));
+    Filter_Update(&xFilter, 3000);
+    for (n = 0; n < 200; n++)
+    {
+        usOut = Filter_Update(&xFilter, 100);
+        TEST_CHECK(usOut >= 100);
+    }
+    TEST_CHECK_EQ(usOut, 100);
+}
+
+static void test_unity_weight_passes_the_median(void)
+{
+    Filter_t xFilter;
+
+    Filter_Init(&xFilter, 1, FILTER_Q15(1.0));
+    Filter_Update(&xFilter, 500);
+    TEST_CHECK_EQ(Filter_Update(&xFilter, 4095), 4095);
+    TEST_CHECK_EQ(Filter_Update(&xFilter, 0), 0);
+    TEST_CHECK_EQ(Filter_Update(&xFilter, 1234), 1234);
+}
+
+static void test_median_rejects_a_spike(void)
+{
+    Filter_t xFilter;
+    int n;
+
+    Filter_Init(&xFilter, 3, FILTER_Q15(1.0));
+    for (n = 0; n < 3; n++)
+    {
+        Filter_Update(&xFilter, 1000);
+    }
+    TEST_CHECK_EQ(Filter_Update(&xFilter, 4095), 1000);
+    TEST_CHECK_EQ(Filter_Update(&xFilter, 1001), 1001);
+    TEST_CHECK_EQ(Filter_Update(&xFilter, 1002), 1002);
+
+    /* A real step passes once it holds the majority of the window */
+    TEST_CHECK_EQ(Filter_Update(&xFilter, 2000), 1002);
+    TEST_CHECK_EQ(Filter_Update(&xFilter, 2000), 2000);
+}
+
+static void test_median_length_is_forced_odd(void)
+{
+    Filter_t xFilter;
+
+    Filter_Init(&xFilter, 0, FILTER_Q15(1.0));
+    TEST_CHECK_EQ(xFilter.ucMedianLength, 1);
+    Filter_Init(&xFilter, 4, FILTER_Q15(1.0));
+    TEST_CHECK_EQ(xFilter.ucMedianLength, 5);
+    Filter_Init(&xFilter, 20, FILTER_Q15(1.0));
+    TEST_CHECK_EQ(xFilter.ucMedianLength, FILTER_MEDIAN_MAX);
+}
+
+static void test_filter_cuts_heater_intensity_changes(void)
+{
+    uint32 ulRaw = prvIntensityChanges(1, FILTER_Q15(1.0));
+    uint32 ulMedian = prvIntensityChanges(APP_MEDIAN_LENGTH, FILTER_Q15(1.0));
+    uint32 ulFiltered = prvIntensityChanges(APP_MEDIAN_LENGTH, FILTER_Q15(APP_FILTER_ALPHA));
+
+    printf("  intensity changes: %lu raw, %lu median only, %lu median and IIR\n",
+           (unsigned long)ulRaw, (unsigned long)ulMedian, (unsigned long)ulFiltered);
+    TEST_CHECK(ulMedian < ulRaw);
+    TEST_CHECK(ulFiltered * 4 <= ulRaw);
+}
+
+int main(void)
+{
+    TEST_RUN(test_step_response_follows_first_order_lag);
+    TEST_RUN(test_falling_step_settles_exactly);
+    TEST_RUN(test_unity_weight_passes_the_median);
+    TEST_RUN(test_median_rejects_a_spike);
+    TEST_RUN(test_median_length_is_forced_odd);
+    TEST_RUN(test_filter_cuts_heater_intensity_changes);
+    return TEST_RESULT();
+}
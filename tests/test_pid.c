@@ -0,0 +1,162 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: test_pid.c
+ *
+ * Description: host unit tests of the fixed-point PID controller
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "test.h"
+#include "pid.h"
+
+/* The MEDIUM gains of main.c, temperatures in tenths of a degree */
+static const PID_Gains_t xGains = { PID_Q15(0.010), PID_KI(0.0005), PID_Q15(0.005) };
+
+static void test_saturates_to_full_power(void)
+{
+    PID_Controller_t xPid;
+
+    PID_Init(&xPid, &xGains);
+    /* 15 degrees below the set point asks for ~150 % */
+    TEST_CHECK_EQ(PID_Update(&xPid, 300, 150, PID_DT_ONE), PID_Q15_ONE);
+}
+
+static void test_saturates_to_off(void)
+{
+    PID_Controller_t xPid;
+
+    PID_Init(&xPid, &xGains);
+    TEST_CHECK_EQ(PID_Update(&xPid, 250, 400, PID_DT_ONE), 0);
+    TEST_CHECK_EQ(xPid.lIntegral, 0);
+}
+
+static void test_no_windup_while_saturated_high(void)
+{
+    PID_Controller_t xPid;
+    int i;
+
+    PID_Init(&xPid, &xGains);
+    for (i = 0; i < 1000; i++)
+    {
+        TEST_CHECK_EQ(PID_Update(&xPid, 300, 150, PID_DT_ONE), PID_Q15_ONE);
+    }
+    /* Pinned at full power from the first step, so nothing was integrated */
+    TEST_CHECK_EQ(xPid.lIntegral, 0);
+
+    /* Reaching the set point drops the output at once instead of unwinding for minutes */
+    TEST_CHECK_EQ(PID_Update(&xPid, 300, 300, PID_DT_ONE), 0);
+}
+
+static void test_no_windup_while_saturated_low(void)
+{
+    PID_Controller_t xPid;
+    int i;
+
+    PID_Init(&xPid, &xGains);
+    for (i = 0; i < 1000; i++)
+    {
+        PID_Update(&xPid, 250, 300, PID_DT_ONE);
+    }
+    TEST_CHECK_EQ(xPid.lIntegral, 0);
+
+    /* One degree low heats right away */
+    TEST_CHECK(PID_Update(&xPid, 250, 240, PID_DT_ONE) > 0);
+}
+
+static void test_integral_removes_the_offset(void)
+{
+    PID_Controller_t xPid;
+    uint16 usFirst, usLast = 0;
+    int i;
+
+    PID_Init(&xPid, &xGains);
+    usFirst = PID_Update(&xPid, 250, 245, PID_DT_ONE);
+    for (i = 0; i < 100; i++)
+    {
+        usLast = PID_Update(&xPid, 250, 245, PID_DT_ONE);
+    }
+    /* Kp * 5 then 0.0005 * 5 more per step, in the Ki resolution of PID_KI_EXTRA_BITS */
+    TEST_CHECK_EQ(usFirst, 5 * PID_Q15(0.010) + ((5 * PID_KI(0.0005)) >> PID_KI_EXTRA_BITS));
+    TEST_CHECK_EQ(usLast, 5 * PID_Q15(0.010) + ((101 * 5 * PID_KI(0.0005)) >> PID_KI_EXTRA_BITS));
+}
+
+static void test_integral_is_clamped(void)
+{
+    static const PID_Gains_t xIntegralOnly = { 0, PID_KI(0.01), 0 };
+    PID_Controller_t xPid;
+    int i;
+
+    PID_Init(&xPid, &xIntegralOnly);
+    for (i = 0; i < 10000; i++)
+    {
+        PID_Update(&xPid, 300, 299, PID_DT_ONE);
+    }
+    /* Integration stops one step short of the limit, where the next one would saturate */
+    TEST_CHECK(xPid.lIntegral <= PID_INTEGRAL_MAX);
+    TEST_CHECK(xPid.lIntegral > PID_INTEGRAL_MAX - PID_KI(0.01));
+    TEST_CHECK(PID_Update(&xPid, 300, 299, PID_DT_ONE) > PID_Q15_ONE - (PID_KI(0.01) >> PID_KI_EXTRA_BITS));
+}
+
+static void test_set_point_change_does_not_kick(void)
+{
+    PID_Controller_t xPid;
+    uint16 usBefore, usAfter;
+
+    PID_Init(&xPid, &xGains);
+    PID_Update(&xPid, 250, 245, PID_DT_ONE);
+    usBefore = PID_Update(&xPid, 250, 245, PID_DT_ONE);
+    usAfter = PID_Update(&xPid, 260, 245, PID_DT_ONE);
+    /* Only the proportional and integral terms see the new error, the derivative does not */
+    TEST_CHECK_EQ(usAfter - usBefore, 10 * PID_Q15(0.010) +
+                  (((3 * 5 + 10) * PID_KI(0.0005)) >> PID_KI_EXTRA_BITS) -
+                  (((2 * 5) * PID_KI(0.0005)) >> PID_KI_EXTRA_BITS));
+}
+
+static void test_integral_follows_the_elapsed_time(void)
+{
+    static const PID_Gains_t xIntegralOnly = { 0, PID_KI(0.0005), 0 };
+    PID_Controller_t xTwoSteps, xOneLongStep, xStalled;
+
+    PID_Init(&xTwoSteps, &xIntegralOnly);
+    PID_Update(&xTwoSteps, 250, 240, PID_DT_ONE);
+    PID_Update(&xTwoSteps, 250, 240, PID_DT_ONE);
+    PID_Init(&xOneLongStep, &xIntegralOnly);
+    PID_Update(&xOneLongStep, 250, 240, 2 * PID_DT_ONE);
+    TEST_CHECK_EQ(xOneLongStep.lIntegral, xTwoSteps.lIntegral);
+
+    /* A sensor that stalled for a minute counts for PID_DT_MAX only */
+    PID_Init(&xStalled, &xIntegralOnly);
+    PID_Update(&xStalled, 250, 240, PID_DT(60000, 50));
+    TEST_CHECK_EQ(xStalled.lIntegral, (10 * PID_KI(0.0005) * PID_DT_MAX) / PID_DT_ONE);
+}
+
+static void test_derivative_follows_the_elapsed_time(void)
+{
+    static const PID_Gains_t xDerivativeOnly = { 0, 0, PID_Q15(0.05) };
+    PID_Controller_t xPid;
+
+    /* The same fall over two periods is half the rate, so half the extra power */
+    PID_Init(&xPid, &xDerivativeOnly);
+    PID_Update(&xPid, 250, 250, PID_DT_ONE);
+    TEST_CHECK_EQ(PID_Update(&xPid, 250, 240, PID_DT_ONE), 10 * PID_Q15(0.05));
+    PID_Init(&xPid, &xDerivativeOnly);
+    PID_Update(&xPid, 250, 250, PID_DT_ONE);
+    TEST_CHECK_EQ(PID_Update(&xPid, 250, 240, 2 * PID_DT_ONE), 5 * PID_Q15(0.05));
+}
+
+int main(void)
+{
+    TEST_RUN(test_saturates_to_full_power);
+    TEST_RUN(test_saturates_to_off);
+    TEST_RUN(test_no_windup_while_saturated_high);
+    TEST_RUN(test_no_windup_while_saturated_low);
+    TEST_RUN(test_integral_removes_the_offset);
+    TEST_RUN(test_integral_is_clamped);
+    TEST_RUN(test_set_point_change_does_not_kick);
+    TEST_RUN(test_integral_follows_the_elapsed_time);
+    TEST_RUN(test_derivative_follows_the_elapsed_time);
+    return TEST_RESULT();
+}
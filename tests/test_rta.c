@@ -0,0 +1,134 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: test_rta.c
+ *
+ * Description: host unit tests of the response time analysis
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "test.h"
+#include "rta.h"
+
+/* Task fields: name, period, priority, resources, WCET, critical section, non-preemptive */
+#define TASK(name, period, priority, resources, wcet, critical, nonpreemptive) \
+    { (const uint8 *)(name), (period), (priority), (resources), (wcet), (critical), (nonpreemptive), 0, 0, 0 }
+
+static void test_fixed_point_of_the_textbook_set(void)
+{
+    /* R3 iterates 5, 11, 14, 17, 20, 20 */
+    RTA_Task_t axTasks[] =
+    {
+        TASK("T1", 7, 3, 0, 3, 0, 0),
+        TASK("T2", 12, 2, 0, 3, 0, 0),
+        TASK("T3", 20, 1, 0, 5, 0, 0),
+    };
+
+    RTA_Analyse(axTasks, 3);
+    TEST_CHECK_EQ(axTasks[0].ulResponse, 3);
+    TEST_CHECK_EQ(axTasks[1].ulResponse, 6);
+    TEST_CHECK_EQ(axTasks[2].ulResponse, 20);
+    TEST_CHECK_EQ(axTasks[0].ulSlack, 4);
+    TEST_CHECK_EQ(axTasks[1].ulSlack, 6);
+    TEST_CHECK_EQ(axTasks[2].ulSlack, 0);
+}
+
+static void test_unschedulable_task(void)
+{
+    RTA_Task_t axTasks[] =
+    {
+        TASK("T1", 7, 3, 0, 3, 0, 0),
+        TASK("T2", 12, 2, 0, 3, 0, 0),
+        TASK("T3", 20, 1, 0, 6, 0, 0),
+    };
+
+    RTA_Analyse(axTasks, 3);
+    TEST_CHECK_EQ(axTasks[1].ulResponse, 6);
+    TEST_CHECK_EQ(axTasks[2].ulResponse, RTA_UNSCHEDULABLE);
+    TEST_CHECK_EQ(axTasks[2].ulSlack, 0);
+}
+
+static void test_blocking_by_shared_resource(void)
+{
+    RTA_Task_t axTasks[] =
+    {
+        TASK("High", 100, 3, RTA_RESOURCE_UART_MUTEX, 10, 2, 0),
+        TASK("Other", 100, 2, 0, 10, 0, 0),
+        TASK("Low", 200, 1, RTA_RESOURCE_UART_MUTEX, 10, 30, 0),
+    };
+
+    RTA_Analyse(axTasks, 3);
+    /* Only the task sharing the mutex waits for the lower priority holder */
+    TEST_CHECK_EQ(axTasks[0].ulBlocking, 30);
+    TEST_CHECK_EQ(axTasks[0].ulResponse, 40);
+    TEST_CHECK_EQ(axTasks[1].ulBlocking, 0);
+    TEST_CHECK_EQ(axTasks[1].ulResponse, 20);
+    /* Nothing has a lower priority than the lowest task */
+    TEST_CHECK_EQ(axTasks[2].ulBlocking, 0);
+    TEST_CHECK_EQ(axTasks[2].ulResponse, 30);
+}
+
+static void test_non_preemptive_section_blocks_everyone(void)
+{
+    RTA_Task_t axTasks[] =
+    {
+        TASK("High", 100, 3, 0, 10, 0, 0),
+        TASK("Low", 200, 1, 0, 10, 0, 4),
+    };
+
+    RTA_Analyse(axTasks, 2);
+    TEST_CHECK_EQ(axTasks[0].ulBlocking, 4);
+    TEST_CHECK_EQ(axTasks[0].ulResponse, 14);
+    TEST_CHECK_EQ(axTasks[1].ulBlocking, 0);
+}
+
+static void test_equal_priority_counts_as_interference(void)
+{
+    RTA_Task_t axTasks[] =
+    {
+        TASK("A", 50, 2, 0, 10, 0, 0),
+        TASK("B", 50, 2, 0, 15, 0, 0),
+    };
+
+    RTA_Analyse(axTasks, 2);
+    TEST_CHECK_EQ(axTasks[0].ulResponse, 25);
+    TEST_CHECK_EQ(axTasks[1].ulResponse, 25);
+}
+
+static void test_aperiodic_task_adds_no_interference(void)
+{
+    RTA_Task_t axTasks[] =
+    {
+        TASK("Event", 0, 3, 0, 5, 0, 0),
+        TASK("Periodic", 100, 1, 0, 10, 0, 0),
+    };
+
+    RTA_Analyse(axTasks, 2);
+    TEST_CHECK_EQ(axTasks[1].ulResponse, 10);
+}
+
+static void test_measurements_keep_the_worst(void)
+{
+    RTA_Task_t xTask = TASK("T", 100, 1, 0, 0, 0, 0);
+
+    RTA_UpdateMeasurement(&xTask, 7, 3, 1);
+    RTA_UpdateMeasurement(&xTask, 5, 4, 0);
+    RTA_UpdateMeasurement(&xTask, 9, 2, 2);
+    TEST_CHECK_EQ(xTask.ulWcet, 9);
+    TEST_CHECK_EQ(xTask.ulCriticalSection, 4);
+    TEST_CHECK_EQ(xTask.ulNonPreemptive, 2);
+}
+
+int main(void)
+{
+    TEST_RUN(test_fixed_point_of_the_textbook_set);
+    TEST_RUN(test_unschedulable_task);
+    TEST_RUN(test_blocking_by_shared_resource);
+    TEST_RUN(test_non_preemptive_section_blocks_everyone);
+    TEST_RUN(test_equal_priority_counts_as_interference);
+    TEST_RUN(test_aperiodic_task_adds_no_interference);
+    TEST_RUN(test_measurements_keep_the_worst);
+    return TEST_RESULT();
+}
@@ -0,0 +1,127 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: test_sensor_fault.c
+ *
+ * Description: host unit tests of the debounced sensor fault state machine
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "test.h"
+#include "sensor_fault.h"
+
+/* The configuration of main.c, tenths of a degree */
+static const SensorFault_Config_t xConfig = { 50, 400, 60, 390, 3, 10 };
+
+static void test_single_bad_sample_is_only_suspect(void)
+{
+    SensorFault_t xSensor;
+
+    SensorFault_Init(&xSensor, &xConfig);
+    TEST_CHECK_EQ(SensorFault_Update(&xSensor, 250), SENSOR_OK);
+    TEST_CHECK_EQ(SensorFault_Update(&xSensor, 10), SENSOR_SUSPECT);
+    TEST_CHECK_EQ(SensorFault_Update(&xSensor, 250), SENSOR_OK);
+    TEST_CHECK_EQ(xSensor.ulFaults, 0);
+}
+
+static void test_fault_confirmed_after_consecutive_bad_samples(void)
+{
+    SensorFault_t xSensor;
+
+    SensorFault_Init(&xSensor, &xConfig);
+    TEST_CHECK_EQ(SensorFault_Update(&xSensor, 49), SENSOR_SUSPECT);
+    TEST_CHECK_EQ(SensorFault_Update(&xSensor, 400), SENSOR_SUSPECT);
+    TEST_CHECK_EQ(SensorFault_Update(&xSensor, 0), SENSOR_FAULTED);
+    TEST_CHECK_EQ(xSensor.ulFaults, 1);
+}
+
+static void test_interrupted_run_restarts_the_count(void)
+{
+    SensorFault_t xSensor;
+
+    SensorFault_Init(&xSensor, &xConfig);
+    SensorFault_Update(&xSensor, 10);
+    SensorFault_Update(&xSensor, 10);
+    SensorFault_Update(&xSensor, 50);
+    TEST_CHECK_EQ(SensorFault_Update(&xSensor, 10), SENSOR_SUSPECT);
+    TEST_CHECK_EQ(SensorFault_Update(&xSensor, 10), SENSOR_SUSPECT);
+    TEST_CHECK_EQ(SensorFault_Update(&xSensor, 10), SENSOR_FAULTED);
+}
+
+static void test_recovery_needs_the_narrower_band(void)
+{
+    SensorFault_t xSensor;
+    int i;
+
+    SensorFault_Init(&xSensor, &xConfig);
+    for (i = 0; i < 3; i++)
+    {
+        SensorFault_Update(&xSensor, 450);
+    }
+    /* Good again but outside the recovery band: still faulted */
+    TEST_CHECK_EQ(SensorFault_Update(&xSensor, 395), SENSOR_FAULTED);
+    TEST_CHECK_EQ(SensorFault_Update(&xSensor, 55), SENSOR_FAULTED);
+
+    for (i = 0; i < 9; i++)
+    {
+        TEST_CHECK_EQ(SensorFault_Update(&xSensor, 300), SENSOR_RECOVERING);
+    }
+    TEST_CHECK_EQ(SensorFault_Update(&xSensor, 300), SENSOR_OK);
+    TEST_CHECK_EQ(xSensor.ulFaults, 1);
+}
+
+static void test_leaving_the_band_restarts_recovery(void)
+{
+    SensorFault_t xSensor;
+    int i;
+
+    SensorFault_Init(&xSensor, &xConfig);
+    for (i = 0; i < 3; i++)
+    {
+        SensorFault_Update(&xSensor, 0);
+    }
+    for (i = 0; i < 9; i++)
+    {
+        SensorFault_Update(&xSensor, 200);
+    }
+    TEST_CHECK_EQ(SensorFault_Update(&xSensor, 390), SENSOR_FAULTED);
+    for (i = 0; i < 9; i++)
+    {
+        TEST_CHECK_EQ(SensorFault_Update(&xSensor, 60), SENSOR_RECOVERING);
+    }
+    TEST_CHECK_EQ(SensorFault_Update(&xSensor, 389), SENSOR_OK);
+}
+
+static void test_every_confirmed_fault_is_counted(void)
+{
+    SensorFault_t xSensor;
+    int iFault, i;
+
+    SensorFault_Init(&xSensor, &xConfig);
+    for (iFault = 0; iFault < 4; iFault++)
+    {
+        for (i = 0; i < 3; i++)
+        {
+            SensorFault_Update(&xSensor, 1000);
+        }
+        for (i = 0; i < 10; i++)
+        {
+            SensorFault_Update(&xSensor, 250);
+        }
+    }
+    TEST_CHECK_EQ(xSensor.eState, SENSOR_OK);
+    TEST_CHECK_EQ(xSensor.ulFaults, 4);
+}
+
+int main(void)
+{
+    TEST_RUN(test_single_bad_sample_is_only_suspect);
+    TEST_RUN(test_fault_confirmed_after_consecutive_bad_samples);
+    TEST_RUN(test_interrupted_run_restarts_the_count);
+    TEST_RUN(test_recovery_needs_the_narrower_band);
+    TEST_RUN(test_leaving_the_band_restarts_recovery);
+    TEST_RUN(test_every_confirmed_fault_is_counted);
+    return TEST_RESULT();
+}
@@ -0,0 +1,133 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: test_supervisor.c
+ *
+ * Description: host unit tests of the task supervisor that gates the watchdog feed
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include "test.h"
+#include "supervisor.h"
+
+/* Stop monitoring every client between the tests */
+static void prvReset(void)
+{
+    uint8 ucId;
+
+    for (ucId = 0; ucId < SUPERVISOR_MAX_CLIENTS; ucId++)
+    {
+        Supervisor_Monitor(ucId, 0, 0);
+    }
+}
+
+static void test_clients_beating_in_time(void)
+{
+    uint32 ulNow;
+
+    prvReset();
+    Supervisor_Monitor(0, 100, 1000);
+    Supervisor_Monitor(3, 50, 1000);
+    for (ulNow = 1000; ulNow <= 2000; ulNow += 10)
+    {
+        Supervisor_Heartbeat(0, ulNow);
+        if (ulNow % 50 == 0)
+        {
+            Supervisor_Heartbeat(3, ulNow);
+        }
+        TEST_CHECK(Supervisor_Check(ulNow) == TRUE);
+    }
+    TEST_CHECK_EQ(Supervisor_GetLate(), SUPERVISOR_NONE);
+}
+
+static void test_missed_heartbeat(void)
+{
+    prvReset();
+    Supervisor_Monitor(2, 100, 1000);
+    Supervisor_Monitor(5, 100, 1000);
+    Supervisor_Heartbeat(5, 1060);
+
+    /* Exactly the interval is still in time */
+    TEST_CHECK(Supervisor_Check(1100) == TRUE);
+    TEST_CHECK(Supervisor_Check(1101) == FALSE);
+    TEST_CHECK_EQ(Supervisor_GetLate(), 2);
+
+    /* A late beat makes the client alive again */
+    Supervisor_Heartbeat(2, 1150);
+    TEST_CHECK(Supervisor_Check(1161) == FALSE);
+    TEST_CHECK_EQ(Supervisor_GetLate(), 5);
+    Supervisor_Heartbeat(5, 1161);
+    TEST_CHECK(Supervisor_Check(1161) == TRUE);
+    TEST_CHECK_EQ(Supervisor_GetLate(), SUPERVISOR_NONE);
+}
+
+static void test_new_client_starts_alive(void)
+{
+    prvReset();
+    Supervisor_Monitor(1, 100, 0);
+    Supervisor_Heartbeat(1, 50);
+
+    /* Monitoring starts from the time of Supervisor_Monitor, not from the stale beat */
+    Supervisor_Monitor(7, 100, 5000);
+    Supervisor_Heartbeat(1, 5000);
+    TEST_CHECK(Supervisor_Check(5050) == TRUE);
+}
+
+static void test_tick_wraparound(void)
+{
+    uint32 ulNow = 0xFFFFFFC0UL;
+    uint16 usStep;
+
+    prvReset();
+    Supervisor_Monitor(4, 100, ulNow);
+    for (usStep = 0; usStep < 20; usStep++)
+    {
+        ulNow += 10;
+        Supervisor_Heartbeat(4, ulNow);
+        TEST_CHECK(Supervisor_Check(ulNow) == TRUE);
+    }
+
+    /* Beat just before the wrap, checked just after it */
+    Supervisor_Heartbeat(4, 0xFFFFFFF0UL);
+    TEST_CHECK(Supervisor_Check(0x00000050UL) == TRUE);
+    TEST_CHECK(Supervisor_Check(0x00000061UL) == FALSE);
+    TEST_CHECK_EQ(Supervisor_GetLate(), 4);
+
+    /* A beat stored after the caller read the time counts as alive */
+    Supervisor_Heartbeat(4, 0x00000005UL);
+    TEST_CHECK(Supervisor_Check(0xFFFFFFFEUL) == TRUE);
+}
+
+static void test_unmonitored_slot(void)
+{
+    prvReset();
+    Supervisor_Monitor(0, 100, 0);
+    Supervisor_Monitor(9, 100, 0);
+
+    /* Slot 6 never beats and isn't monitored */
+    Supervisor_Heartbeat(0, 1000);
+    Supervisor_Heartbeat(9, 1000);
+    TEST_CHECK(Supervisor_Check(1000) == TRUE);
+
+    /* A client taken off the list no longer holds back the feed */
+    TEST_CHECK(Supervisor_Check(2000) == FALSE);
+    TEST_CHECK_EQ(Supervisor_GetLate(), 0);
+    Supervisor_Monitor(0, 0, 2000);
+    TEST_CHECK(Supervisor_Check(2000) == FALSE);
+    TEST_CHECK_EQ(Supervisor_GetLate(), 9);
+    Supervisor_Monitor(9, 0, 2000);
+    TEST_CHECK(Supervisor_Check(2000) == TRUE);
+    TEST_CHECK_EQ(Supervisor_GetLate(), SUPERVISOR_NONE);
+}
+
+int main(void)
+{
+    TEST_RUN(test_clients_beating_in_time);
+    TEST_RUN(test_missed_heartbeat);
+    TEST_RUN(test_new_client_starts_alive);
+    TEST_RUN(test_tick_wraparound);
+    TEST_RUN(test_unmonitored_slot);
+    return TEST_RESULT();
+}
@@ -0,0 +1,144 @@
+/**********************************************************************************************
+ *
+ * Module: Tests
+ *
+ * File Name: test_trace.c
+ *
+ * Description: host tests of the trace capture and replay cursors, and of the determinism of
+ *              a replay through the sensor and control pipeline
+ *
+ * Author: Youssef Khaled
+ *
+ ***********************************************************************************************/
+#include <string.h>
+#include "test.h"
+#include "replay.h"
+
+static Trace_Record_t axLoaded[TRACE_CAPACITY];
+
+static void test_capture_counts_dropped_records(void)
+{
+    Trace_Record_t xRecord;
+    uint16 usIndex;
+
+    for (usIndex = 0; usIndex < TRACE_CAPACITY + 3; usIndex++)
+    {
+        Trace_Capture(TRACE_EVENT_ADC, (uint8)(usIndex % 2), usIndex, usIndex * 10UL);
+    }
+    TEST_CHECK_EQ(Trace_GetCount(), TRACE_CAPACITY);
+    TEST_CHECK_EQ(Trace_GetDropped(), 3);
+    TEST_CHECK(Trace_Read(TRACE_CAPACITY - 1, &xRecord) == TRUE);
+    TEST_CHECK_EQ(xRecord.usValue, TRACE_CAPACITY - 1);
+    TEST_CHECK_EQ(xRecord.ucSource, 1);
+    TEST_CHECK(Trace_Read(TRACE_CAPACITY, &xRecord) == FALSE);
+}
+
+static void test_gesture_due_after_newer_reading(void)
+{
+    static const Trace_Record_t axTrace[] =
+    {
+        {0, TRACE_EVENT_ADC, 0, 100},
+        {10, TRACE_EVENT_BUTTON, 1, 2},
+        {20, TRACE_EVENT_ADC, 0, 101},
+        {30, TRACE_EVENT_ADC, 1, 200}
+    };
+    Trace_Record_t xRecord;
+
+    Trace_StartReplay(axTrace, 4);
+    TEST_CHECK(Trace_NextAdc(0, &xRecord) == TRUE);
+    TEST_CHECK(Trace_NextButton(&xRecord) == FALSE);
+
+    /* Reading 20 of seat 0 passes the gesture of seat 1, it is due whichever seat reads */
+    TEST_CHECK(Trace_NextAdc(0, &xRecord) == TRUE);
+    TEST_CHECK_EQ(xRecord.ulTimeStamp, 20);
+    TEST_CHECK(Trace_NextButton(&xRecord) == TRUE);
+    TEST_CHECK_EQ(xRecord.ucSource, 1);
+    TEST_CHECK(Trace_NextButton(&xRecord) == FALSE);
+
+    TEST_CHECK(Trace_NextAdc(0, &xRecord) == FALSE);
+    TEST_CHECK(Trace_NextAdc(1, &xRecord) == TRUE);
+    TEST_CHECK_EQ(xRecord.usValue, 200);
+    TEST_CHECK_EQ(Trace_GetReplayed(), 4);
+}
+
+static void test_replay_is_deterministic(void)
+{
+    Replay_Result_t xFirst;
+    Replay_Result_t xSecond;
+
+    Replay_Run(xTraceReplay, usTraceReplayCount, &xFirst);
+    Replay_Run(xTraceReplay, usTraceReplayCount, &xSecond);
+    TEST_CHECK_EQ(xFirst.usReplayed, usTraceReplayCount);
+    TEST_CHECK(memcmp(&xFirst, &xSecond, sizeof(xFirst)) == 0);
+
+    /* One gesture per seat in the table, a decision per reading once the sensor is trusted */
+    TEST_CHECK_EQ(xFirst.aulGestures[0], 1);
+    TEST_CHECK_EQ(xFirst.aulGestures[1], 1);
+    TEST_CHECK(xFirst.aulDecisions[0] > 0);
+    TEST_CHECK(xFirst.aulDecisions[1] > 0);
+}
+
+static void test_console_dump_replays_the_same(void)
+{
+    Replay_Result_t xTable;
+    Replay_Result_t xFile;
+    FILE *pxFile = tmpfile();
+    uint16 usIndex;
+    uint16 usCount;
+
+    TEST_CHECK(pxFile != NULL);
+    if (pxFile == NULL)
+    {
+        return;
+    }
+    /* The output of the "trace" command, with its header and chunk lines */
+    fprintf(pxFile, "DIGEST,Driver,0\r\nTRACE,%u,0\r\n", usTraceReplayCount);
+    for (usIndex = 0; usIndex < usTraceReplayCount; usIndex++)
+    {
+        fprintf(pxFile, "    {%lu, %s, %u, %u},\r\n", (unsigned long)xTraceReplay[usIndex].ulTimeStamp,
+                (xTraceReplay[usIndex].ucType == TRACE_EVENT_ADC) ? "TRACE_EVENT_ADC" : "TRACE_EVENT_BUTTON",
+                xTraceReplay[usIndex].ucSource, xTraceReplay[usIndex].usValue);
+    }
+    fprintf(pxFile, "More: trace %u\r\n", usTraceReplayCount);
+    rewind(pxFile);
+    usCount = Replay_Load(pxFile, axLoaded, TRACE_CAPACITY);
+    fclose(pxFile);
+
+    TEST_CHECK_EQ(usCount, usTraceReplayCount);
+    TEST_CHECK(memcmp(axLoaded, xTraceReplay, usCount * sizeof(Trace_Record_t)) == 0);
+    Replay_Run(xTraceReplay, usTraceReplayCount, &xTable);
+    Replay_Run(axLoaded, usCount, &xFile);
+    TEST_CHECK(memcmp(&xTable, &xFile, sizeof(xTable)) == 0);
+}
+
+static void test_digest_follows_the_gestures(void)
+{
+    Replay_Result_t xCaptured;
+    Replay_Result_t xEdited;
+    uint16 usCount = 0;
+    uint16 usIndex;
+
+    /* The same readings without the gesture of seat 1 */
+    for (usIndex = 0; usIndex < usTraceReplayCount; usIndex++)
+    {
+        if (xTraceReplay[usIndex].ucType == TRACE_EVENT_BUTTON && xTraceReplay[usIndex].ucSource == 1)
+        {
+            continue;
+        }
+        axLoaded[usCount++] = xTraceReplay[usIndex];
+    }
+    Replay_Run(xTraceReplay, usTraceReplayCount, &xCaptured);
+    Replay_Run(axLoaded, usCount, &xEdited);
+    TEST_CHECK_EQ(xEdited.aulDigest[0], xCaptured.aulDigest[0]);
+    TEST_CHECK(xEdited.aulDigest[1] != xCaptured.aulDigest[1]);
+}
+
+int main(void)
+{
+    TEST_RUN(test_capture_counts_dropped_records);
+    TEST_RUN(test_gesture_due_after_newer_reading);
+    TEST_RUN(test_replay_is_deterministic);
+    TEST_RUN(test_console_dump_replays_the_same);
+    TEST_RUN(test_digest_follows_the_gestures);
+    return TEST_RESULT();
+}